@@ -0,0 +1,129 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "ProgramGenerator.hpp"
+
+#include <algorithm>
+
+using namespace lace;
+
+/// The operators that generated expressions are built out of. Division is left
+/// out so that generated programs can never divide by zero.
+static constexpr const char* Operators[] = { " + ", " - ", " * " };
+
+std::string ProgramGenerator::file_name(uint32_t k) {
+    return "unit_" + std::to_string(k) + ".lace";
+}
+
+void ProgramGenerator::gen_expr(std::string& out, uint32_t depth,
+                                uint32_t seed) const {
+    // Leaves cycle through the arguments, the fields of the local structure
+    // and literals, so that every kind of reference is exercised.
+    auto leaf = [&](uint32_t n) {
+        switch (n % 4) {
+            case 0:
+                out += 'a';
+                break;
+            case 1:
+                out += 'b';
+                break;
+            case 2:
+                if (m_shape.fields != 0) {
+                    out += "r.f" + std::to_string(n / 4 % m_shape.fields);
+                    break;
+                }
+
+                [[fallthrough]];
+            default:
+                out += std::to_string(n % 97 + 1);
+                break;
+        }
+    };
+
+    // Nest on the right only, so that the size of an expression grows with
+    // its depth rather than exponentially.
+    for (uint32_t d = 0; d < depth; ++d) {
+        out += '(';
+        leaf(seed + d);
+        out += Operators[(seed + d) % std::size(Operators)];
+    }
+
+    leaf(seed + depth);
+    out.append(depth, ')');
+}
+
+void ProgramGenerator::gen_function(std::string& out, uint32_t k,
+                                    uint32_t i) const {
+    const std::string suffix = std::to_string(k) + "_" + std::to_string(i);
+
+    out += "$[public]\n";
+    out += "fn_" + suffix + " :: (a: s64, b: s64) -> s64 {\n";
+
+    if (m_shape.fields != 0) {
+        out += "    let r: Rec_" + std::to_string(k) + ";\n";
+        for (uint32_t f = 0; f < m_shape.fields; ++f)
+            out += "    r.f" + std::to_string(f) + " = a + " +
+                std::to_string(f) + ";\n";
+    }
+
+    out += "    let i: mut s64 = 0;\n";
+    out += "    let acc: mut s64 = ";
+    gen_expr(out, m_shape.expr_depth, i);
+    out += ";\n";
+
+    out += "    until i == " + std::to_string(100 + i) + " {\n";
+    for (uint32_t s = 0; s < m_shape.loop_stmts; ++s) {
+        out += "        acc = acc + ";
+        gen_expr(out, 2, i + s);
+        out += ";\n";
+    }
+
+    out += "        i = i + 1;\n";
+    out += "    }\n";
+
+    // Chain each function to the one before it, and the first function of a
+    // file to the first function of the last file it loads.
+    if (i != 0) {
+        out += "    ret acc + fn_" + std::to_string(k) + "_" +
+            std::to_string(i - 1) + "(a, b);\n";
+    } else if (k != 0 && m_shape.loads != 0) {
+        out += "    ret acc + fn_" + std::to_string(k - 1) + "_0(a, b);\n";
+    } else {
+        out += "    ret acc;\n";
+    }
+
+    out += "}\n\n";
+}
+
+std::vector<GeneratedFile> ProgramGenerator::generate() const {
+    std::vector<GeneratedFile> files = {};
+    files.reserve(m_shape.files);
+
+    for (uint32_t k = 0; k < m_shape.files; ++k) {
+        std::string out = {};
+
+        const uint32_t first = k - std::min(k, m_shape.loads);
+        for (uint32_t j = first; j < k; ++j)
+            out += "load \"" + file_name(j) + "\";\n";
+
+        if (first != k)
+            out += '\n';
+
+        if (m_shape.fields != 0) {
+            out += "Rec_" + std::to_string(k) + " :: struct {\n";
+            for (uint32_t f = 0; f < m_shape.fields; ++f)
+                out += "    f" + std::to_string(f) + ": mut s64,\n";
+
+            out += "}\n\n";
+        }
+
+        for (uint32_t i = 0; i < m_shape.functions; ++i)
+            gen_function(out, k, i);
+
+        files.push_back({ file_name(k), std::move(out) });
+    }
+
+    return files;
+}
@@ -0,0 +1,72 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_PROGRAM_GENERATOR_H_
+#define LOVELACE_PROGRAM_GENERATOR_H_
+
+//
+//  This header file declares the ProgramGenerator class, which writes large,
+//  valid lovelace programs of a chosen shape for the compiler to be measured
+//  against.
+//
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lace {
+
+/// The shape of a generated program.
+struct ProgramShape final {
+    uint32_t files = 1;         //< The number of files in the program.
+    uint32_t functions = 16;    //< The number of functions in each file.
+    uint32_t expr_depth = 8;    //< The nesting depth of generated expressions.
+    uint32_t fields = 8;        //< The number of fields of each structure.
+    uint32_t loop_stmts = 4;    //< The statements in the body of each loop.
+    uint32_t loads = 1;         //< The number of earlier files each file loads.
+};
+
+/// A single generated source file.
+struct GeneratedFile final {
+    std::string name;
+    std::string source;
+};
+
+/// Generates programs of a given shape.
+///
+/// Every file defines a structure and a run of public functions. Each function
+/// fills in a local of that structure, folds its fields and arguments together
+/// with deeply nested expressions, runs a loop, and then calls the function
+/// before it, or a function of a loaded file for the first in the file. The
+/// output only depends on the shape, so runs are comparable with each other.
+class ProgramGenerator final {
+    const ProgramShape m_shape;
+
+    /// Write an expression of |depth| nested binary operations to |out|.
+    void gen_expr(std::string& out, uint32_t depth, uint32_t seed) const;
+
+    /// Write the |i|-th function of the |k|-th file to |out|.
+    void gen_function(std::string& out, uint32_t k, uint32_t i) const;
+
+    /// Returns the name of the |k|-th file.
+    static std::string file_name(uint32_t k);
+
+public:
+    ProgramGenerator(const ProgramShape& shape) : m_shape(shape) {}
+
+    ProgramGenerator(const ProgramGenerator&) = delete;
+    void operator=(const ProgramGenerator&) = delete;
+
+    ProgramGenerator(ProgramGenerator&&) noexcept = delete;
+    void operator=(ProgramGenerator&&) noexcept = delete;
+
+    /// Generate the files of the program. Files only load files before them,
+    /// so they are already in an order that they can be analyzed in.
+    std::vector<GeneratedFile> generate() const;
+};
+
+} // namespace lace
+
+#endif // LOVELACE_PROGRAM_GENERATOR_H_
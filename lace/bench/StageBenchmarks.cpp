@@ -0,0 +1,514 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+//
+//  Benchmarks for each stage of the compiler, run over generated programs.
+//
+//  Every benchmark builds a fresh program up to the stage it measures with the
+//  timer paused, so only the stage itself is timed. Throughput is reported as
+//  bytes of source per second, and as nodes per second, where nodes are tokens
+//  for the lexer, syntax tree nodes for the frontend, and instructions for the
+//  backend.
+//
+
+#include "ProgramGenerator.hpp"
+
+#include "lace/codegen/LIRCodegen.hpp"
+#include "lace/core/Options.hpp"
+#include "lace/lexer/Lexer.hpp"
+#include "lace/parser/Parser.hpp"
+#include "lace/tree/AST.hpp"
+#include "lace/tree/NameAnalysis.hpp"
+#include "lace/tree/Scope.hpp"
+#include "lace/tree/SemanticAnalysis.hpp"
+#include "lace/tree/StaticVisitor.hpp"
+#include "lace/tree/SymbolAnalysis.hpp"
+
+#include "lir/analysis/LoweringPass.hpp"
+#include "lir/machine/AsmWriter.hpp"
+#include "lir/machine/Machine.hpp"
+#include "lir/machine/RegisterAnalysis.hpp"
+#include "lir/machine/Segment.hpp"
+
+#include "benchmark/benchmark.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace lace;
+
+namespace {
+
+/// Counts every node of a syntax tree.
+class NodeCounter final : public StaticVisitor<NodeCounter> {
+public:
+    uint64_t count = 0;
+
+    using StaticVisitor::visit;
+
+    void visit(AST& ast) {
+        for (Defn* defn : ast.get_defns())
+            dispatch(*defn);
+    }
+
+    void visit(AliasDefn&) { ++count; }
+    void visit(FieldDefn&) { ++count; }
+    void visit(LoadDefn&) { ++count; }
+    void visit(ParameterDefn&) { ++count; }
+    void visit(VariantDefn&) { ++count; }
+
+    void visit(EnumDefn& node) {
+        ++count;
+        for (VariantDefn* variant : node.get_variants())
+            visit(*variant);
+    }
+
+    void visit(FunctionDefn& node) {
+        ++count;
+        for (ParameterDefn* param : node.get_params())
+            visit(*param);
+
+        if (node.has_body())
+            visit(*node.get_body());
+    }
+
+    void visit(StructDefn& node) {
+        ++count;
+        for (FieldDefn* field : node.get_fields())
+            visit(*field);
+    }
+
+    void visit(VariableDefn& node) {
+        ++count;
+        if (node.has_init())
+            dispatch(*node.get_init());
+    }
+
+    void visit(AdapterStmt& node) {
+        ++count;
+        if (node.get_flavor() == AdapterStmt::Definitive) {
+            dispatch(*node.get_defn());
+        } else {
+            dispatch(*node.get_expr());
+        }
+    }
+
+    void visit(BlockStmt& node) {
+        ++count;
+        for (Stmt* stmt : node.get_stmts())
+            dispatch(*stmt);
+    }
+
+    void visit(IfStmt& node) {
+        ++count;
+        dispatch(*node.get_cond());
+        dispatch(*node.get_then());
+        if (node.has_else())
+            dispatch(*node.get_else());
+    }
+
+    void visit(RestartStmt&) { ++count; }
+    void visit(StopStmt&) { ++count; }
+
+    void visit(RetStmt& node) {
+        ++count;
+        if (node.has_expr())
+            dispatch(*node.get_expr());
+    }
+
+    void visit(UntilStmt& node) {
+        ++count;
+        dispatch(*node.get_cond());
+        if (node.has_body())
+            dispatch(*node.get_body());
+    }
+
+    void visit(BoolLiteral&) { ++count; }
+    void visit(CharLiteral&) { ++count; }
+    void visit(IntegerLiteral&) { ++count; }
+    void visit(FloatLiteral&) { ++count; }
+    void visit(NullLiteral&) { ++count; }
+    void visit(StringLiteral&) { ++count; }
+    void visit(RefExpr&) { ++count; }
+    void visit(SizeofExpr&) { ++count; }
+
+    void visit(BinaryOp& node) {
+        ++count;
+        dispatch(*node.get_lhs());
+        dispatch(*node.get_rhs());
+    }
+
+    void visit(UnaryOp& node) {
+        ++count;
+        dispatch(*node.get_expr());
+    }
+
+    void visit(AccessExpr& node) {
+        ++count;
+        dispatch(*node.get_base());
+    }
+
+    void visit(CallExpr& node) {
+        ++count;
+        dispatch(*node.get_callee());
+        for (Expr* arg : node.get_args())
+            dispatch(*arg);
+    }
+
+    void visit(CastExpr& node) {
+        ++count;
+        dispatch(*node.get_expr());
+    }
+
+    void visit(ParenExpr& node) {
+        ++count;
+        dispatch(*node.get_expr());
+    }
+
+    void visit(SubscriptExpr& node) {
+        ++count;
+        dispatch(*node.get_base());
+        dispatch(*node.get_index());
+    }
+};
+
+/// The stages of the compiler, in the order they run.
+enum class Stage : uint32_t {
+    Parse,
+    NameAnalysis,
+    SymbolAnalysis,
+    SemanticAnalysis,
+    Codegen,
+    InstSelector,
+    RegisterAnalysis,
+};
+
+/// A program being compiled, file by file, one stage at a time.
+class Pipeline final {
+    const Options& m_options;
+    const lir::Machine& m_mach;
+    const std::vector<GeneratedFile>& m_files;
+
+    std::vector<AST*> m_asts = {};
+    std::vector<std::unique_ptr<lir::CFG>> m_cfgs = {};
+    std::vector<std::unique_ptr<lir::Segment>> m_segs = {};
+
+    /// Bind the public definitions of the files that each tree loads into it,
+    /// as the driver does before name analysis.
+    void bind_loads() {
+        std::unordered_map<std::string, AST*> files = {};
+        for (AST* ast : m_asts)
+            files.emplace(ast->get_file(), ast);
+
+        for (AST* ast : m_asts) {
+            for (Defn* defn : ast->get_defns()) {
+                auto* load = dynamic_cast<LoadDefn*>(defn);
+                if (!load)
+                    continue;
+
+                const AST::Exports& exports =
+                    files.at(load->get_path())->get_exports();
+
+                ast->get_scope()->add(exports);
+                ast->get_loaded().insert(
+                    ast->get_loaded().end(), exports.begin(), exports.end());
+            }
+        }
+    }
+
+public:
+    Pipeline(const Options& options, const lir::Machine& mach,
+             const std::vector<GeneratedFile>& files)
+      : m_options(options), m_mach(mach), m_files(files) {}
+
+    ~Pipeline() {
+        // Segments refer to their graph, which in turn refers to its tree.
+        m_segs.clear();
+        m_cfgs.clear();
+
+        for (AST* ast : m_asts)
+            delete ast;
+    }
+
+    Pipeline(const Pipeline&) = delete;
+    void operator=(const Pipeline&) = delete;
+
+    Pipeline(Pipeline&&) noexcept = delete;
+    void operator=(Pipeline&&) noexcept = delete;
+
+    /// Run the stage |stage| over every file.
+    void run(Stage stage) {
+        switch (stage) {
+            case Stage::Parse:
+                for (const GeneratedFile& file : m_files) {
+                    Parser parser(file.source, file.name);
+                    m_asts.push_back(parser.parse());
+                }
+                break;
+
+            case Stage::NameAnalysis:
+                bind_loads();
+                for (AST* ast : m_asts) {
+                    NameAnalysis pass(m_options);
+                    ast->accept(pass);
+                }
+                break;
+
+            case Stage::SymbolAnalysis:
+                for (AST* ast : m_asts) {
+                    SymbolAnalysis pass(m_options);
+                    ast->accept(pass);
+                }
+                break;
+
+            case Stage::SemanticAnalysis:
+                for (AST* ast : m_asts) {
+                    SemanticAnalysis pass(m_options);
+                    ast->accept(pass);
+                }
+                break;
+
+            case Stage::Codegen:
+                for (AST* ast : m_asts) {
+                    m_cfgs.push_back(
+                        std::make_unique<lir::CFG>(m_mach, ast->get_file()));
+
+                    LIRCodegen codegen(m_options, ast, *m_cfgs.back());
+                    codegen.run();
+                }
+                break;
+
+            // Instruction selection is run by the lowering pass, function by
+            // function, and there is nothing else to lowering.
+            case Stage::InstSelector:
+                for (auto& cfg : m_cfgs) {
+                    m_segs.push_back(std::make_unique<lir::Segment>(*cfg));
+                    lir::LoweringPass lowering(*cfg, *m_segs.back());
+                    lowering.run();
+                }
+                break;
+
+            case Stage::RegisterAnalysis:
+                for (auto& seg : m_segs) {
+                    lir::RegisterAnalysis rega(*seg);
+                    rega.run();
+                }
+                break;
+        }
+    }
+
+    /// Run every stage before and including |stage| over every file.
+    void run_through(Stage stage) {
+        for (uint32_t s = 0; s <= static_cast<uint32_t>(stage); ++s)
+            run(static_cast<Stage>(s));
+    }
+
+    const std::vector<AST*>& get_asts() const { return m_asts; }
+
+    /// Returns the number of nodes in every tree.
+    uint64_t count_tree_nodes() const {
+        NodeCounter counter;
+        for (AST* ast : m_asts)
+            ast->accept(counter);
+
+        return counter.count;
+    }
+
+    /// Returns the number of instructions in every graph.
+    uint64_t count_instructions() const {
+        uint64_t count = 0;
+        for (auto& cfg : m_cfgs)
+            for (const lir::Function* function : cfg->get_functions())
+                for (const lir::BasicBlock* block = function->get_head();
+                        block; block = block->get_next())
+                    count += block->size();
+
+        return count;
+    }
+
+    /// Returns the number of machine instructions in every segment.
+    uint64_t count_mach_instructions() const {
+        uint64_t count = 0;
+        for (auto& seg : m_segs)
+            for (const auto& [name, function] : seg->get_functions())
+                for (const lir::MachLabel* label = function->get_head();
+                        label; label = label->get_next())
+                    count += label->size();
+
+        return count;
+    }
+
+    const std::vector<std::unique_ptr<lir::Segment>>& get_segments() const {
+        return m_segs;
+    }
+};
+
+/// Returns the program generated for the shape in the arguments of |state|,
+/// which are the number of files and the number of functions in each.
+std::vector<GeneratedFile> generate(const benchmark::State& state) {
+    ProgramShape shape;
+    shape.files = state.range(0);
+    shape.functions = state.range(1);
+
+    ProgramGenerator generator(shape);
+    return generator.generate();
+}
+
+/// Returns the total size of the sources of |files|.
+uint64_t total_bytes(const std::vector<GeneratedFile>& files) {
+    uint64_t bytes = 0;
+    for (const GeneratedFile& file : files)
+        bytes += file.source.size();
+
+    return bytes;
+}
+
+/// Record the throughput of |iterations| runs over |bytes| of source and
+/// |nodes| nodes in |state|.
+void report(benchmark::State& state, uint64_t bytes, uint64_t nodes) {
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["nodes"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * nodes),
+        benchmark::Counter::kIsRate);
+}
+
+/// Time the stage |stage| on its own, with the stages before it run untimed.
+/// The nodes of each run are counted by |count| once the stage has finished.
+template<typename Count>
+void bench_stage(benchmark::State& state, Stage stage, Count count) {
+    const std::vector<GeneratedFile> files = generate(state);
+    const lir::Machine mach(lir::Machine::Linux);
+    const Options options = {};
+    uint64_t nodes = 0;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto pipeline = std::make_unique<Pipeline>(options, mach, files);
+        if (stage != Stage::Parse)
+            pipeline->run_through(static_cast<Stage>(
+                static_cast<uint32_t>(stage) - 1));
+
+        state.ResumeTiming();
+        pipeline->run(stage);
+        state.PauseTiming();
+
+        nodes = count(*pipeline);
+        pipeline.reset();
+        state.ResumeTiming();
+    }
+
+    report(state, total_bytes(files), nodes);
+}
+
+} // namespace
+
+static void BM_Lexer(benchmark::State& state) {
+    const std::vector<GeneratedFile> files = generate(state);
+    uint64_t tokens = 0;
+
+    for (auto _ : state) {
+        tokens = 0;
+        for (const GeneratedFile& file : files) {
+            Lexer lexer(file.source, file.name);
+            Token token;
+            do {
+                lexer.lex(token);
+                ++tokens;
+            } while (!token.is_eof());
+        }
+
+        benchmark::DoNotOptimize(tokens);
+    }
+
+    report(state, total_bytes(files), tokens);
+}
+
+static void BM_Parser(benchmark::State& state) {
+    bench_stage(state, Stage::Parse, [](const Pipeline& pipeline) {
+        return pipeline.count_tree_nodes();
+    });
+}
+
+static void BM_NameAnalysis(benchmark::State& state) {
+    bench_stage(state, Stage::NameAnalysis, [](const Pipeline& pipeline) {
+        return pipeline.count_tree_nodes();
+    });
+}
+
+static void BM_SymbolAnalysis(benchmark::State& state) {
+    bench_stage(state, Stage::SymbolAnalysis, [](const Pipeline& pipeline) {
+        return pipeline.count_tree_nodes();
+    });
+}
+
+static void BM_SemanticAnalysis(benchmark::State& state) {
+    bench_stage(state, Stage::SemanticAnalysis, [](const Pipeline& pipeline) {
+        return pipeline.count_tree_nodes();
+    });
+}
+
+static void BM_LIRCodegen(benchmark::State& state) {
+    bench_stage(state, Stage::Codegen, [](const Pipeline& pipeline) {
+        return pipeline.count_instructions();
+    });
+}
+
+static void BM_InstSelector(benchmark::State& state) {
+    bench_stage(state, Stage::InstSelector, [](const Pipeline& pipeline) {
+        return pipeline.count_mach_instructions();
+    });
+}
+
+static void BM_RegisterAnalysis(benchmark::State& state) {
+    bench_stage(state, Stage::RegisterAnalysis, [](const Pipeline& pipeline) {
+        return pipeline.count_mach_instructions();
+    });
+}
+
+static void BM_AsmWriter(benchmark::State& state) {
+    const std::vector<GeneratedFile> files = generate(state);
+    const lir::Machine mach(lir::Machine::Linux);
+    const Options options = {};
+
+    // The writer does not change the segments, so they are only built once.
+    Pipeline pipeline(options, mach, files);
+    pipeline.run_through(Stage::RegisterAnalysis);
+    const uint64_t nodes = pipeline.count_mach_instructions();
+
+    for (auto _ : state) {
+        for (const auto& seg : pipeline.get_segments()) {
+            std::ostringstream out;
+            lir::AsmWriter writer(*seg);
+            writer.run(out);
+            benchmark::DoNotOptimize(out);
+        }
+    }
+
+    report(state, total_bytes(files), nodes);
+}
+
+/// The shapes that every stage is run over: one large file, and a program of
+/// many files that load one another.
+#define LACE_BENCH(name)                                                       \
+    BENCHMARK(name)                                                            \
+        ->ArgNames({ "files", "functions" })                                   \
+        ->Args({ 1, 512 })                                                     \
+        ->Args({ 32, 32 })                                                     \
+        ->Unit(benchmark::kMillisecond)
+
+LACE_BENCH(BM_Lexer);
+LACE_BENCH(BM_Parser);
+LACE_BENCH(BM_NameAnalysis);
+LACE_BENCH(BM_SymbolAnalysis);
+LACE_BENCH(BM_SemanticAnalysis);
+LACE_BENCH(BM_LIRCodegen);
+LACE_BENCH(BM_InstSelector);
+LACE_BENCH(BM_RegisterAnalysis);
+LACE_BENCH(BM_AsmWriter);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,118 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_ARENA_H_
+#define LOVELACE_ARENA_H_
+
+//
+//  This header file declares the Arena class, a bump-pointer allocator for
+//  objects which all live and die together, like the nodes of a syntax tree,
+//  and the ArenaAllocated mixin for classes whose objects are made in one.
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lace {
+
+/// A bump-pointer allocator which releases everything it allocated at once.
+///
+/// Memory is carved out of large slabs in allocation order, so objects made
+/// one after another end up next to each other. Objects are never freed on
+/// their own, but destructors registered with an allocation are run, in the
+/// reverse order of allocation, when the arena is destroyed.
+class Arena final {
+public:
+    /// The size of the slabs that allocations are carved out of. Allocations
+    /// bigger than this get a slab of their own.
+    static constexpr size_t SlabSize = 64 * 1024;
+
+    /// A function that destroys the object at its argument.
+    using Destructor = void (*)(void*);
+
+private:
+    /// An object to destroy along with the arena.
+    struct Cleanup final {
+        void* ptr;
+        Destructor dtor;
+    };
+
+    std::vector<char*> m_slabs = {};
+    std::vector<Cleanup> m_cleanups = {};
+    char* m_ptr = nullptr;
+    char* m_end = nullptr;
+    size_t m_bytes = 0;
+
+    /// Start a new slab with room for at least |size| bytes at |align|.
+    void grow(size_t size, size_t align);
+
+public:
+    Arena() = default;
+
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    void operator=(const Arena&) = delete;
+
+    Arena(Arena&&) noexcept = delete;
+    void operator=(Arena&&) noexcept = delete;
+
+    /// Allocate |size| bytes aligned to |align|, which must be a power of two.
+    void* allocate(size_t size, size_t align) {
+        const uintptr_t addr = reinterpret_cast<uintptr_t>(m_ptr);
+        const uintptr_t aligned = (addr + align - 1) & ~(align - 1);
+
+        if (!m_ptr || aligned + size > reinterpret_cast<uintptr_t>(m_end)) {
+            grow(size, align);
+            return allocate(size, align);
+        }
+
+        m_ptr = reinterpret_cast<char*>(aligned + size);
+        m_bytes += size;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    /// Allocate |size| bytes aligned to |align| for an object which should be
+    /// destroyed by |dtor| along with the arena.
+    void* allocate(size_t size, size_t align, Destructor dtor) {
+        void* ptr = allocate(size, align);
+        m_cleanups.push_back({ ptr, dtor });
+        return ptr;
+    }
+
+    /// Returns a destructor for objects of type |T|. If |T| has a virtual
+    /// destructor, then this destroys objects of any type derived from it.
+    template<typename T>
+    static Destructor destructor() {
+        return [](void* ptr) { static_cast<T*>(ptr)->~T(); };
+    }
+
+    /// Returns the number of bytes allocated out of this arena.
+    size_t bytes_allocated() const { return m_bytes; }
+
+    /// Returns the number of slabs this arena has reserved.
+    uint32_t num_slabs() const { return m_slabs.size(); }
+};
+
+/// A mixin for polymorphic hierarchies rooted at |Base| whose objects are only
+/// ever made in an arena, as with `new (arena) T(...)`.
+///
+/// Such objects are owned by the arena rather than by whoever made them: they
+/// are never deleted on their own, and are destroyed through the destructor of
+/// |Base| when the arena is. |Base| should have a virtual destructor if it has
+/// derived classes.
+template<typename Base>
+class ArenaAllocated {
+public:
+    void* operator new(size_t size, Arena& arena) {
+        return arena.allocate(
+            size, alignof(std::max_align_t), Arena::destructor<Base>());
+    }
+};
+
+} // namespace lace
+
+#endif // LOVELACE_ARENA_H_
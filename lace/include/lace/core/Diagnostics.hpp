@@ -15,10 +15,17 @@
 #include "lace/types/SourceLocation.hpp"
 #include "lace/types/SourceSpan.hpp"
 
+#include <functional>
 #include <iostream>
 #include <ostream>
 #include <string>
 
+namespace lace {
+
+class SourceManager;
+
+} // namespace lace
+
 namespace lace::log {
 
 /// A location in source suitable for the logger.
@@ -49,6 +56,11 @@ struct Span final {
 /// If a custom stream is given, then it is to be borrowed and not owned.
 void init(std::ostream& os = std::cerr);
 
+/// Use |sources| to look up the source code shown by diagnostics, so that 
+/// files already read by the compiler are not read again. Until this is 
+/// called, the logger reads and keeps each file itself as needed.
+void set_source_manager(SourceManager& sources);
+
 /// Change the output stream of the logger to |os|.
 void set_output_stream(std::ostream& os);
 
@@ -58,13 +70,46 @@ void set_output_stream(std::ostream& os);
 /// via set_output_stream.
 void clear_output_stream();
 
-/// Flush the output stream and the compiler state if there have been any 
-/// errors declared.
+/// Write out the diagnostics logged so far, and stop the compiler if there 
+/// have been any errors declared.
+///
+/// Diagnostics are buffered per thread as they are logged, and are only 
+/// written to the output stream here, ordered by file and then by position 
+/// within the file, so that the output does not depend on how work was split
+/// between threads. Diagnostics without a file come first, in the order they 
+/// were logged.
 ///
 /// Effectively, if any non-fatal error calls were made, then flushing will crash the
 /// compiler at the point of the call.
 void flush();
 
+/// Test if any errors have been logged since the logger was initialized.
+bool has_errors();
+
+/// Call |hook| once a fatal error is logged, before the compiler stops, so 
+/// that work still pending elsewhere can be finished first. The hook is run at
+/// most once, and may log diagnostics of its own. Passing an empty |hook| 
+/// removes it.
+void set_fatal_hook(std::function<void()> hook);
+
+/// Attributes the diagnostics logged on the calling thread without a source
+/// location to the file at |path| for the lifetime of this object, so that 
+/// they are written out alongside the rest of the diagnostics of that file.
+class Context final {
+    std::string m_prev;
+
+public:
+    Context(const std::string& path);
+
+    ~Context();
+
+    Context(const Context&) = delete;
+    void operator=(const Context&) = delete;
+
+    Context(Context&&) noexcept = delete;
+    void operator=(Context&&) noexcept = delete;
+};
+
 /// Log the given |msg| as a note to the output stream.
 void note(const std::string& msg);
 
@@ -12,8 +12,11 @@
 //  process.
 //
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace lace {
 
@@ -28,9 +31,15 @@ struct Options final {
     };
 
     std::string output; //< (-o) The name of the output file.
+    std::string runtime; //< (-rt) The runtime object to link against.
+    std::string cache;  //< (-cache/-no-cache) The object cache directory.
+    std::string time_json; //< (-time-json) Where to write timings as JSON.
+    std::string time_trace; //< (-time-trace) Where to write a trace timeline.
     OptLevel opt;       //< (-O0/-O1/-O2/-O3/-Os) The optimization level.
     uint32_t threads;       //< (-j) Number of threads to use, overriden. 
 
+    bool compile_only;  //< (-c) If objects should be written, but not linked.
+    bool link;          //< (-o) If objects should be linked into an executable.
     bool debug;         //< (-g) If debugging symbols should be added.
     bool multithread;   //< (-st) If multithreading should be used.
     bool time;          //< (-t) If pipeline stages should be timed.
@@ -39,8 +48,23 @@ struct Options final {
 
     bool llvm;          //< (-LLVM) If the LLVM backend should be used.
 
-    bool print_tree;    //< (-ast) If the AST should be printed.
-    bool print_ir;      //< (-ir) If the middle-end IR should be printed.
+    /// (-dump-after) The passes to dump the output of, by name.
+    std::vector<std::string> dump_after = {};
+
+    /// (-dump-func) The functions to limit dumps to, or empty for all of them.
+    std::vector<std::string> dump_funcs = {};
+
+    /// Test if the output of the pass named |pass| should be dumped.
+    bool dumps_after(std::string_view pass) const {
+        return std::find(dump_after.begin(), dump_after.end(), pass) 
+            != dump_after.end();
+    }
+
+    /// Test if the function named |name| should be included in dumps.
+    bool dumps_function(std::string_view name) const {
+        return dump_funcs.empty() || std::find(
+            dump_funcs.begin(), dump_funcs.end(), name) != dump_funcs.end();
+    }
 };
 
 } // namespace lace
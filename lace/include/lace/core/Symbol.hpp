@@ -0,0 +1,70 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_SYMBOL_H_
+#define LOVELACE_SYMBOL_H_
+
+//
+//  This header file declares the Symbol class, a handle to a string interned
+//  for the duration of the compilation, such that equal strings always have
+//  the same handle.
+//
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace lace {
+
+/// An interned string, such as an identifier.
+///
+/// Symbols compare and hash by their id alone, so names can be matched and
+/// looked up without touching their characters. Interning is thread-safe, 
+/// and the interned strings live until the compiler exits.
+class Symbol final {
+    /// The id of this symbol. The empty string is always interned as zero.
+    uint32_t m_id = 0;
+
+public:
+    /// Create a symbol for the empty string.
+    Symbol() = default;
+
+    /// Create a symbol for |str|, interning it if it has not been seen yet.
+    ///
+    /// These are deliberately implicit, so that strings can be passed where 
+    /// symbols are expected, at the cost of a lookup in the interner.
+    Symbol(std::string_view str);
+    Symbol(const std::string& str) : Symbol(std::string_view(str)) {}
+    Symbol(const char* str) : Symbol(std::string_view(str)) {}
+
+    bool operator==(Symbol other) const { return m_id == other.m_id; }
+    bool operator!=(Symbol other) const { return m_id != other.m_id; }
+
+    /// Returns the id of this symbol, which is unique to its string.
+    uint32_t get_id() const { return m_id; }
+
+    /// Test if this is the symbol for the empty string.
+    bool empty() const { return m_id == 0; }
+
+    /// Returns the string that this symbol was interned from.
+    const std::string& str() const;
+};
+
+inline std::ostream& operator<<(std::ostream& os, Symbol symbol) {
+    return os << symbol.str();
+}
+
+} // namespace lace
+
+template<>
+struct std::hash<lace::Symbol> {
+    std::size_t operator()(lace::Symbol symbol) const noexcept {
+        return symbol.get_id();
+    }
+};
+
+#endif // LOVELACE_SYMBOL_H_
@@ -0,0 +1,125 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_TASK_GRAPH_H_
+#define LOVELACE_TASK_GRAPH_H_
+
+//
+//  This header file declares the TaskGraph class, which schedules a set of
+//  jobs with dependencies between them, either serially or across the
+//  threads of a ThreadPool.
+//
+
+#include "lace/core/ThreadPool.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace lace {
+
+/// A directed, acyclic graph of jobs. A job is started only once every job
+/// that it depends on has finished.
+class TaskGraph final {
+public:
+    using Task = uint32_t;
+
+private:
+    struct Node final {
+        Job job;
+        std::vector<Task> succs = {};
+        uint32_t preds = 0;
+    };
+
+    std::vector<Node> m_nodes = {};
+
+public:
+    TaskGraph() = default;
+
+    TaskGraph(const TaskGraph&) = delete;
+    void operator=(const TaskGraph&) = delete;
+
+    TaskGraph(TaskGraph&&) noexcept = delete;
+    void operator=(TaskGraph&&) noexcept = delete;
+
+    /// Add a new task to this graph that runs |job|, and return its handle.
+    Task add(Job job) {
+        m_nodes.push_back({ std::move(job) });
+        return m_nodes.size() - 1;
+    }
+
+    /// Declare that |task| may not start until |dep| has finished.
+    void depend(Task task, Task dep) {
+        assert(task < m_nodes.size() && dep < m_nodes.size() &&
+            "task not in graph!");
+        assert(task != dep && "task cannot depend on itself!");
+
+        m_nodes[dep].succs.push_back(task);
+        ++m_nodes[task].preds;
+    }
+
+    /// Returns the number of tasks in this graph.
+    uint32_t size() const { return m_nodes.size(); }
+
+    /// Run every task in this graph, and block until all of them have
+    /// finished.
+    ///
+    /// If a |pool| is given, then each task is pushed to it with its
+    /// dependencies as edges, so that it is started as soon as its last
+    /// dependency finishes. Otherwise, tasks are run on the calling thread in
+    /// a topological order.
+    void run(ThreadPool* pool = nullptr) {
+        const std::vector<Task> order = sort();
+
+        if (!pool) {
+            for (Task t : order)
+                m_nodes[t].job();
+
+            return;
+        }
+
+        std::vector<std::vector<ThreadPool::Task>> deps(m_nodes.size());
+        std::vector<ThreadPool::Task> handles(m_nodes.size());
+
+        for (Task t : order) {
+            handles[t] = pool->push(m_nodes[t].job, deps[t]);
+
+            for (Task succ : m_nodes[t].succs)
+                deps[succ].push_back(handles[t]);
+        }
+
+        // Waiting on the handles rather than the whole pool lets a graph be
+        // run from within a pool job, and leaves unrelated jobs alone.
+        for (const ThreadPool::Task& handle : handles)
+            pool->wait(handle);
+    }
+
+private:
+    /// Returns the tasks of this graph in a topological order.
+    std::vector<Task> sort() const {
+        std::vector<uint32_t> waiting(m_nodes.size());
+        std::vector<Task> order = {};
+        order.reserve(m_nodes.size());
+
+        for (Task t = 0, e = m_nodes.size(); t != e; ++t) {
+            waiting[t] = m_nodes[t].preds;
+            if (waiting[t] == 0)
+                order.push_back(t);
+        }
+
+        for (uint32_t i = 0; i != order.size(); ++i) {
+            for (Task succ : m_nodes[order[i]].succs)
+                if (--waiting[succ] == 0)
+                    order.push_back(succ);
+        }
+
+        assert(order.size() == m_nodes.size() && "task graph has a cycle!");
+        return order;
+    }
+};
+
+} // namespace lace
+
+#endif // LOVELACE_TASK_GRAPH_H_
@@ -6,40 +6,137 @@
 #ifndef LOVELACE_THREAD_POOL_H_
 #define LOVELACE_THREAD_POOL_H_
 
+//
+//  This header file defines the ThreadPool class, a work-stealing pool of
+//  worker threads that run jobs, optionally with dependencies between them.
+//
+
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <functional>
-#include <queue>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace lace {
 
 using Job = std::function<void()>;
 
+/// A pool of worker threads.
+///
+/// Each worker owns a deque of ready jobs. Jobs pushed from a worker go to the
+/// back of its own deque, and the worker takes from the back, so that related
+/// work stays on one thread. A worker that runs out of work steals from the
+/// front of the other deques. Jobs pushed from other threads go to a shared
+/// queue that every worker takes from.
+///
+/// A job can depend on other jobs, in which case it becomes ready only once
+/// all of them have finished.
 class ThreadPool final {
+    /// The state of a single job.
+    struct Node final {
+        Job job;
+
+        /// The number of unfinished dependencies, plus one while the job is
+        /// still being pushed.
+        std::atomic<uint32_t> waiting = 1;
+
+        std::atomic<bool> done = false;
+
+        /// The jobs that depend on this one. Guarded by |mutex|.
+        std::vector<std::shared_ptr<Node>> succs = {};
+        std::mutex mutex;
+
+        Node(Job job) : job(std::move(job)) {}
+    };
+
+    using NodeRef = std::shared_ptr<Node>;
+
+    /// The ready jobs of one worker.
+    struct Queue final {
+        std::deque<NodeRef> jobs = {};
+        std::mutex mutex;
+    };
+
+public:
+    /// A handle to a job pushed to the pool.
+    class Task final {
+        friend class ThreadPool;
+
+        NodeRef m_node = nullptr;
+
+        Task(NodeRef node) : m_node(std::move(node)) {}
+
+    public:
+        Task() = default;
+
+        /// Test if this handle refers to a job.
+        bool valid() const { return m_node != nullptr; }
+
+        /// Test if the job has finished.
+        bool done() const {
+            return m_node && m_node->done.load();
+        }
+    };
+
+private:
+    std::vector<std::unique_ptr<Queue>> m_queues = {};
+    Queue m_shared = {};
     std::vector<std::jthread> m_threads = {};
-    std::queue<Job> m_jobs = {};
+
+    /// The number of jobs that are ready but not yet taken.
+    std::atomic<uint32_t> m_ready = 0;
+
+    /// The number of jobs that have been pushed but not yet finished.
+    std::atomic<uint32_t> m_pending = 0;
+
+    /// The number of workers asleep, and the number of threads blocked in a
+    /// wait, respectively.
+    std::atomic<uint32_t> m_sleeping = 0;
+    std::atomic<uint32_t> m_waiting = 0;
 
     std::mutex m_mutex;
     std::condition_variable m_cv;
     std::condition_variable m_done;
 
-    uint32_t m_pending = 0;
+    std::atomic<bool> m_stop = false;
+
+    /// The pool and worker index of the current thread, if it is a worker.
+    inline static thread_local ThreadPool* s_pool = nullptr;
+    inline static thread_local int32_t s_worker = -1;
 
 public:
     ThreadPool(uint32_t count) {
-        m_threads.reserve(count);
+        count = std::max(count, 1u);
+        m_queues.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+            m_queues.push_back(std::make_unique<Queue>());
 
+        m_threads.reserve(count);
         for (uint32_t i = 0; i < count; ++i) {
-            m_threads.emplace_back([this](std::stop_token token) {
-                worker(token);
+            m_threads.emplace_back([this, i] {
+                s_pool = this;
+                s_worker = i;
+                worker();
             });
         }
     }
 
     ~ThreadPool() {
         request_stop();
+
+        // The workers are joined here rather than by their own destructors, 
+        // since those only run after the state the workers share is gone.
+        for (std::jthread& thread : m_threads) {
+            if (thread.joinable())
+                thread.join();
+        }
     }
 
     ThreadPool(const ThreadPool&) = delete;
@@ -48,58 +145,248 @@ public:
     ThreadPool(ThreadPool&&) noexcept = delete;
     void operator=(ThreadPool&&) noexcept = delete;
 
-    void push(Job job) {
-        {
-            std::lock_guard guard(m_mutex);
-            m_jobs.push(std::move(job));
-            ++m_pending;
+    /// Push |job| to the pool, to be run once each of the tasks in |deps|
+    /// has finished.
+    Task push(Job job, const std::vector<Task>& deps = {}) {
+        NodeRef node = std::make_shared<Node>(std::move(job));
+        m_pending.fetch_add(1, std::memory_order_relaxed);
+
+        for (const Task& dep : deps) {
+            if (!dep.valid())
+                continue;
+
+            std::lock_guard lock(dep.m_node->mutex);
+            if (dep.m_node->done.load(std::memory_order_acquire))
+                continue;
+
+            node->waiting.fetch_add(1, std::memory_order_relaxed);
+            dep.m_node->succs.push_back(node);
         }
 
-        m_cv.notify_one();
+        // Drop the hold taken while pushing; the job may be ready already.
+        if (node->waiting.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            schedule(node);
+
+        return Task(std::move(node));
+    }
+
+    /// Push the callable |fn| to the pool, to be run once each of the tasks
+    /// in |deps| has finished, and return a future for its result.
+    ///
+    /// Unlike wait, getting the result of the future does not run other jobs
+    /// in the meantime, so it should not be used from within a worker.
+    template<typename F>
+    auto async(F fn, const std::vector<Task>& deps = {})
+        -> std::future<std::invoke_result_t<F>> {
+        using Result = std::invoke_result_t<F>;
+
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            std::move(fn));
+
+        std::future<Result> future = task->get_future();
+        push([task] { (*task)(); }, deps);
+        return future;
     }
 
+    /// Block until every job pushed to the pool has finished.
     void wait() {
-        std::unique_lock lock(m_mutex);
-        m_done.wait(lock, [&] {
-            return m_pending == 0;
-        });
+        m_waiting.fetch_add(1);
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_done.wait(lock, [&] {
+                return m_pending.load(std::memory_order_acquire) == 0;
+            });
+        }
+
+        m_waiting.fetch_sub(1);
     }
 
-    uint32_t get_pending() const { return m_pending; }
+    /// Block until |task| has finished. Other ready jobs are run on the
+    /// calling thread in the meantime, so it is safe to wait from a worker.
+    void wait(const Task& task) {
+        while (!task.done()) {
+            if (NodeRef node = take()) {
+                run(node);
+                continue;
+            }
 
-private:
-    void worker(std::stop_token token) {
-        while (!token.stop_requested()) {
-            Job job;
+            m_waiting.fetch_add(1);
 
             {
                 std::unique_lock lock(m_mutex);
-                m_cv.wait(lock, [&] {
-                    return token.stop_requested() || !m_jobs.empty();
+                m_done.wait(lock, [&] {
+                    return task.done() || m_ready.load() > 0;
                 });
+            }
+
+            m_waiting.fetch_sub(1);
+        }
+    }
+
+    /// Run |fn| for each index in [|begin|, |end|), split into chunks across
+    /// the pool, and block until all of them have finished.
+    template<typename F>
+    void parallel_for(uint32_t begin, uint32_t end, F fn) {
+        if (begin >= end)
+            return;
 
-                if (token.stop_requested())
-                    return;
+        // Aim for a few chunks per worker, so that stealing can even out
+        // indices that take longer than others.
+        const uint32_t count = end - begin;
+        const uint32_t chunks = std::min<uint32_t>(count, m_queues.size() * 4);
+        const uint32_t size = (count + chunks - 1) / chunks;
 
-                job = std::move(m_jobs.front());
-                m_jobs.pop();
+        std::vector<Task> tasks = {};
+        tasks.reserve(chunks);
+
+        for (uint32_t first = begin; first < end; first += size) {
+            const uint32_t last = std::min(end, first + size);
+            tasks.push_back(push([&fn, first, last] {
+                for (uint32_t i = first; i < last; ++i)
+                    fn(i);
+            }));
+        }
+
+        for (const Task& task : tasks)
+            wait(task);
+    }
+
+    /// Returns the number of workers in this pool.
+    uint32_t size() const { return m_queues.size(); }
+
+    /// Returns the number of jobs that have been pushed, but not finished.
+    uint32_t get_pending() const {
+        return m_pending.load(std::memory_order_relaxed);
+    }
+
+    /// Returns the index of the pool worker running on the calling thread, or
+    /// -1 if the calling thread is not a pool worker.
+    static int32_t get_worker() { return s_worker; }
+
+private:
+    /// Returns the queue of the calling thread if it is a worker of this
+    /// pool, and the shared queue otherwise.
+    Queue& local_queue() {
+        return s_pool == this ? *m_queues[s_worker] : m_shared;
+    }
+
+    /// Make |node| ready to run.
+    void schedule(NodeRef node) {
+        Queue& queue = local_queue();
+        {
+            std::lock_guard lock(queue.mutex);
+            queue.jobs.push_back(std::move(node));
+            m_ready.fetch_add(1);
+        }
+
+        // Only take the pool lock if someone could be asleep, which is what
+        // keeps pushes from contending with each other.
+        if (m_sleeping.load() > 0 || m_waiting.load() > 0) {
+            std::lock_guard lock(m_mutex);
+            m_cv.notify_one();
+            m_done.notify_all();
+        }
+    }
+
+    /// Take a ready job: first from the back of the local queue, then from the
+    /// shared queue, and then from the front of the other workers' queues.
+    NodeRef take() {
+        const int32_t self = s_pool == this ? s_worker : -1;
+
+        if (self >= 0) {
+            Queue& queue = *m_queues[self];
+            std::lock_guard lock(queue.mutex);
+            if (!queue.jobs.empty()) {
+                NodeRef node = std::move(queue.jobs.back());
+                queue.jobs.pop_back();
+                m_ready.fetch_sub(1);
+                return node;
+            }
+        }
+
+        if (NodeRef node = steal(m_shared))
+            return node;
+
+        const uint32_t count = m_queues.size();
+        const uint32_t start = self >= 0 ? self + 1 : 0;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t victim = (start + i) % count;
+            if (static_cast<int32_t>(victim) == self)
+                continue;
+
+            if (NodeRef node = steal(*m_queues[victim]))
+                return node;
+        }
+
+        return nullptr;
+    }
+
+    /// Take the oldest job from |queue|, if it has any.
+    NodeRef steal(Queue& queue) {
+        std::lock_guard lock(queue.mutex);
+        if (queue.jobs.empty())
+            return nullptr;
+
+        NodeRef node = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        m_ready.fetch_sub(1);
+        return node;
+    }
+
+    /// Run the job of |node|, and then release the jobs that depend on it.
+    void run(const NodeRef& node) {
+        node->job();
+        node->job = nullptr;
+
+        std::vector<NodeRef> succs = {};
+        {
+            std::lock_guard lock(node->mutex);
+            node->done.store(true);
+            succs.swap(node->succs);
+        }
+
+        for (NodeRef& succ : succs) {
+            if (succ->waiting.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                schedule(std::move(succ));
+        }
+
+        // Successors are scheduled before this job retires, so the pool never
+        // looks idle while there is still work left.
+        if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1
+          || m_waiting.load() > 0) {
+            std::lock_guard lock(m_mutex);
+            m_done.notify_all();
+        }
+    }
+
+    void worker() {
+        while (!m_stop.load(std::memory_order_acquire)) {
+            if (NodeRef node = take()) {
+                run(node);
+                continue;
             }
 
-            job();
+            m_sleeping.fetch_add(1);
 
             {
-                std::lock_guard lock(m_mutex);
-                --m_pending;
-                
-                if (m_pending == 0)
-                    m_done.notify_all();
+                std::unique_lock lock(m_mutex);
+                m_cv.wait(lock, [&] {
+                    return m_stop.load(std::memory_order_acquire)
+                        || m_ready.load() > 0;
+                });
             }
+
+            m_sleeping.fetch_sub(1);
         }
     }
 
     void request_stop() {
-        for (std::jthread& thr : m_threads)
-            thr.request_stop();
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop.store(true, std::memory_order_release);
+        }
 
         m_cv.notify_all();
     }
@@ -0,0 +1,101 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_TIMING_H_
+#define LOVELACE_TIMING_H_
+
+//
+//  This header file declares the compiler self-timing interface, which
+//  accumulates the time spent in named regions of the compiler into a tree
+//  that can be reported at the end of a compilation, and optionally records
+//  each region as an event on a timeline.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace lace::timing {
+
+/// A handle to a node in the timing tree.
+using Node = uint32_t;
+
+/// The root of the timing tree, which is never timed itself.
+inline constexpr Node Root = 0;
+
+/// Enable timing. Regions created before this are not timed.
+void enable();
+
+/// Enable timing, and also record each region as a trace event, tagged with
+/// the thread pool worker that ran it.
+void enable_trace();
+
+/// Test if timing has been enabled.
+bool is_enabled();
+
+/// Returns the innermost node being timed on the calling thread.
+///
+/// This is used to hand a parent to regions that are timed on other threads,
+/// e.g. jobs pushed to a thread pool.
+Node current();
+
+/// Print the timing tree to |os|. Siblings are sorted by the time spent in
+/// them, and each node is shown with its share of its parent. Folded 
+/// breakdowns are left out.
+void print(std::ostream& os);
+
+/// Write the timing tree to |os| as JSON.
+void write_json(std::ostream& os);
+
+/// Write the recorded trace events to |os| in the Chrome trace event format,
+/// as read by chrome://tracing and Perfetto.
+void write_trace(std::ostream& os);
+
+/// How the breakdown of a region by its detail is reported.
+enum class Breakdown : uint8_t {
+    /// The breakdown is shown in every report.
+    Shown,
+
+    /// The breakdown is left out of the printed tree, which would otherwise
+    /// grow a line for every detail, e.g. for every function of a file. It is 
+    /// still written as JSON and to the trace.
+    Folded,
+};
+
+/// A scope whose lifetime is timed, if timing is enabled.
+///
+/// A region is placed under the region that encloses it on the same thread,
+/// or under an explicit parent. If a |detail| is given, such as a file or
+/// function name, then the time is recorded both for |name| and for a child
+/// of it named by |detail|, so that the report shows the total for |name| as
+/// well as its |breakdown|.
+class Region final {
+    Node m_node = Root;
+    Node m_detail = Root;
+    Node m_prev = Root;
+    std::chrono::steady_clock::time_point m_start;
+    bool m_active = false;
+
+public:
+    Region(const std::string& name, const std::string& detail = "")
+      : Region(current(), name, detail) {}
+
+    Region(Node parent, const std::string& name,
+           const std::string& detail = "", 
+           Breakdown breakdown = Breakdown::Shown);
+
+    ~Region();
+
+    Region(const Region&) = delete;
+    void operator=(const Region&) = delete;
+
+    Region(Region&&) noexcept = delete;
+    void operator=(Region&&) noexcept = delete;
+};
+
+} // namespace lace::timing
+
+#endif // LOVELACE_TIMING_H_
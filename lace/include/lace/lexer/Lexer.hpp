@@ -16,11 +16,12 @@
 
 #include <cassert>
 #include <string>
+#include <string_view>
 
 namespace lace {
 
 class Lexer final {
-    std::string m_source;
+    std::string_view m_source;
     std::string m_filename;
     uint32_t m_cursor = 0;
     SourceLocation m_loc = {};
@@ -28,17 +29,18 @@ class Lexer final {
     /// Returns the character the cursor is currently looking at.
     /// 
     /// If the end of the source buffer has been reached i.e. there is no
-    /// character to look at, then the null terminator is returned instead.
-    inline char curr() const { return is_eof() ? '\0' : m_source[m_cursor]; }
+    /// character to look at, then this is the null terminator of the buffer.
+    inline char curr() const { return m_source.data()[m_cursor]; }
+
+    /// Returns a pointer to the character the cursor is currently looking at.
+    inline const char* ptr() const { return m_source.data() + m_cursor; }
 
     /// Returns the character |n| positions ahead in the source code buffer.
     /// 
-    /// If |n| exceeds the size of the source buffer, then the null terminator
-    /// is returned instead.
+    /// This may only look as far as the null terminator of the buffer, so it
+    /// must not be used once curr() has returned the terminator.
     inline char peek(uint32_t n = 1) const {
-        return (m_cursor + n < m_source.size()) 
-            ? m_source[m_cursor + n] 
-            : '\0';
+        return m_source.data()[m_cursor + n];
     }
 
     /// Move the lexer cursor |n| positions forward, and update the location in
@@ -54,20 +56,44 @@ class Lexer final {
         m_loc.col = 1;
     }
 
+    /// Skip over any whitespace, line breaks and comments at the cursor.
+    void skip_trivia();
+
 public:
     /// Create a new lexer using the given |source| buffer.
     ///
+    /// The buffer is borrowed, not copied, and must be followed by a null 
+    /// terminator, as are string literals, std::string and the buffers of a 
+    /// SourceManager. The lexer stops on the terminator rather than checking
+    /// its bounds on each character.
+    ///
     /// Optionally, the |path| argument designates the source file which 
     /// |source| is from, and allows for more accurate diagnostics should there
     /// be unrecognized tokens. 
-    Lexer(const std::string& source, const std::string& filename = "")
-      : m_source(source), m_filename(filename) {}
+    Lexer(std::string_view source, const std::string& filename = "")
+      : m_source(source), m_filename(filename) {
+        assert(source.data()[source.size()] == '\0' && 
+            "source buffer is not null-terminated!");
+    }
+
+    /// Move the lexer to |offset| into the source buffer, which is at the 
+    /// location |loc|, so that lexing picks up from there. The offset must be
+    /// at the start of a token, such as one lexed before.
+    void seek(uint32_t offset, SourceLocation loc) {
+        assert(offset <= m_source.size() && "offset is out of bounds!");
+        m_cursor = offset;
+        m_loc = loc;
+    }
 
     /// Test if the end of the source code buffer has been reached.
     bool is_eof() const { return m_cursor >= m_source.size(); }
 
     /// Lex a new token and save its state to |token|.
     void lex(Token& token);
+
+    /// Returns the kind of keyword spelled by |ident|, or Token::Identifier if
+    /// |ident| is not a keyword.
+    static Token::Kind get_keyword(std::string_view ident);
 };
 
 } // namespace lace
@@ -0,0 +1,63 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_SCANNER_H_
+#define LOVELACE_SCANNER_H_
+
+//
+//  This header file declares the scanning routines used by the lexer to skip
+//  over runs of characters of the same class, e.g. whitespace or the rest of
+//  an identifier, many bytes at a time with SIMD where the CPU supports it.
+//
+
+#include <cstdint>
+
+namespace lace::scan {
+
+/// The instruction sets that scanning can be done with.
+enum class Level : uint32_t {
+    Scalar,
+    SSE2,
+    AVX2,
+};
+
+/// Returns the instruction set that scanning is currently done with. This is
+/// the best one supported by the CPU, unless lowered with set_level.
+Level get_level();
+
+/// Scan with the instruction set |level|, or the best one supported by the
+/// CPU if it does not support |level|. Mostly useful to compare the routines
+/// against each other.
+void set_level(Level level);
+
+/// Each of the following routines returns the length of the run of characters
+/// starting at |ptr| in some class.
+///
+/// |ptr| must point into a null-terminated buffer, and the terminator is never
+/// part of a run, so that scanning always stops at the end of the buffer. The
+/// routines may read past the terminator, but never past the aligned 32-byte
+/// block it is in, which is always mapped.
+
+/// Returns the length of the run of spaces and tabs at |ptr|.
+uint32_t skip_blanks(const char* ptr);
+
+/// Returns the length of the run of characters at |ptr| up to the next line
+/// break, as for the body of a line comment.
+uint32_t skip_line(const char* ptr);
+
+/// Returns the length of the run of letters, digits and underscores at |ptr|.
+uint32_t skip_ident(const char* ptr);
+
+/// Returns the length of the run of decimal digits at |ptr|.
+uint32_t skip_digits(const char* ptr);
+
+/// Returns the length of the run of characters at |ptr| up to the next quote,
+/// backslash or null character, as for the plain contents of a string
+/// literal.
+uint32_t skip_string(const char* ptr);
+
+} // namespace lace::scan
+
+#endif // LOVELACE_SCANNER_H_
@@ -12,10 +12,9 @@
 //  compiler.
 //
 
+#include "lace/core/Symbol.hpp"
 #include "lace/types/SourceLocation.hpp"
 
-#include <string>
-
 namespace lace {
 
 /// Represents a token lexed from source.
@@ -92,7 +91,7 @@ struct Token final {
         Tilde,
 		/// `$`
         Sign,
-		/// identifiers, e.g. `ret` and `_x`
+		/// identifiers, e.g. `main` and `_x`
         Identifier,
 		/// integers, e.g. `0` and `1337`
         Integer,
@@ -102,16 +101,82 @@ struct Token final {
         Character,
 		/// strings, e.g. `"hello"` and `"world"`
         String,
+		/// `cast`
+        KwCast,
+		/// `else`
+        KwElse,
+		/// `enum`
+        KwEnum,
+		/// `false`
+        KwFalse,
+		/// `if`
+        KwIf,
+		/// `let`
+        KwLet,
+		/// `load`
+        KwLoad,
+		/// `mut`
+        KwMut,
+		/// `null`
+        KwNull,
+		/// `restart`
+        KwRestart,
+		/// `ret`
+        KwRet,
+		/// `sizeof`
+        KwSizeof,
+		/// `stop`
+        KwStop,
+		/// `struct`
+        KwStruct,
+		/// `true`
+        KwTrue,
+		/// `union`
+        KwUnion,
+		/// `until`
+        KwUntil,
+		/// `void`
+        KwVoid,
+		/// `bool`
+        KwBool,
+		/// `char`
+        KwChar,
+		/// `s8`
+        KwS8,
+		/// `s16`
+        KwS16,
+		/// `s32`
+        KwS32,
+		/// `s64`
+        KwS64,
+		/// `u8`
+        KwU8,
+		/// `u16`
+        KwU16,
+		/// `u32`
+        KwU32,
+		/// `u64`
+        KwU64,
+		/// `f32`
+        KwF32,
+		/// `f64`
+        KwF64,
     } kind; //< The kind of token this is.
 
     /// The location of this token in source.
     SourceLocation loc;
 
-    /// The attached value of this token for literals and identifiers. 
-    std::string value;
+    /// The offset of the first character of this token into the source 
+    /// buffer it was lexed from.
+    uint32_t offset = 0;
+
+    /// The attached value of this token for literals and identifiers, as
+    /// interned by the lexer. Keywords have no value, since their kind says 
+    /// everything about them.
+    Symbol value;
 
     Token(Kind kind = Token::EndOfFile, SourceLocation loc = {}, 
-		  const std::string& value = "")
+		  Symbol value = {})
       : kind(kind), loc(loc), value(value) {}
 
     bool operator==(const Token& other) const {
@@ -120,6 +185,16 @@ struct Token final {
 
 	/// Test if this token marks the end of an input file.
     inline bool is_eof() const { return kind == Token::EndOfFile; }
+
+	/// Test if this token is a keyword, including the names of builtin types.
+    inline bool is_keyword() const {
+        return Token::KwCast <= kind && kind <= Token::KwF64;
+    }
+
+	/// Test if this token names a builtin type, e.g. `s32` or `void`.
+    inline bool is_builtin_type() const {
+        return Token::KwVoid <= kind && kind <= Token::KwF64;
+    }
 };
 
 } // namespace lace
@@ -0,0 +1,103 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_TOKEN_WINDOW_H_
+#define LOVELACE_TOKEN_WINDOW_H_
+
+//
+//  This header file defines the TokenWindow class, a fixed-size ring of the
+//  most recent tokens out of a lexer, so that the parser can look ahead a few
+//  tokens without holding onto every token in a file.
+//
+
+#include "lace/lexer/Lexer.hpp"
+#include "lace/lexer/Token.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+namespace lace {
+
+/// A window over the token stream of a lexer, holding the current token and
+/// up to a few tokens ahead of it. Tokens behind the current one are dropped.
+class TokenWindow final {
+public:
+    /// The number of tokens the window holds, including the current token.
+    /// This must be a power of two.
+    static constexpr uint32_t capacity = 4;
+
+    /// The furthest ahead of the current token that can be peeked at.
+    static constexpr uint32_t max_lookahead = capacity - 1;
+
+private:
+    static_assert((capacity & (capacity - 1)) == 0,
+        "token window capacity must be a power of two!");
+
+    Lexer& m_lexer;
+    std::array<Token, capacity> m_tokens = {};
+
+    /// The slot of the current token.
+    uint32_t m_head = 0;
+
+    /// The number of tokens lexed into the window, including the current one.
+    uint32_t m_size = 0;
+
+    /// Lex the token after the last one in the window.
+    inline void fill() {
+        assert(m_size < capacity && "token window is full!");
+        m_lexer.lex(m_tokens[(m_head + m_size) & (capacity - 1)]);
+        ++m_size;
+    }
+
+public:
+    /// Create a new window over the tokens of |lexer|, which must outlive the
+    /// window. No tokens are lexed until the first call to next.
+    TokenWindow(Lexer& lexer) : m_lexer(lexer) {}
+
+    TokenWindow(const TokenWindow&) = delete;
+    TokenWindow& operator=(const TokenWindow&) = delete;
+
+    /// Test if no tokens have been lexed yet.
+    bool empty() const { return m_size == 0; }
+
+    /// Returns the current token.
+    ///
+    /// Fails by assertion if no tokens have been lexed yet.
+    const Token& curr() const {
+        assert(!empty() && "no tokens have been lexed yet!");
+        return m_tokens[m_head];
+    }
+
+    /// Returns the token |n| positions ahead of the current one, lexing it and
+    /// any before it if they are not yet in the window. Past the end of the
+    /// input, this is an end of file token.
+    ///
+    /// Fails by assertion if |n| is past the maximum lookahead.
+    const Token& peek(uint32_t n = 1) {
+        assert(!empty() && "no tokens have been lexed yet!");
+        assert(n <= max_lookahead && "peek is past the maximum lookahead!");
+
+        while (m_size <= n)
+            fill();
+
+        return m_tokens[(m_head + n) & (capacity - 1)];
+    }
+
+    /// Move onto the next token, dropping the current one.
+    void next() {
+        if (m_size > 0) {
+            m_head = (m_head + 1) & (capacity - 1);
+            --m_size;
+        }
+
+        if (m_size == 0)
+            fill();
+    }
+};
+
+} // namespace lace
+
+#endif // LOVELACE_TOKEN_WINDOW_H_
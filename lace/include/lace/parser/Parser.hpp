@@ -12,39 +12,42 @@
 //
 
 #include "lace/lexer/Lexer.hpp"
+#include "lace/lexer/TokenWindow.hpp"
 #include "lace/tree/AST.hpp"
 #include "lace/tree/Defn.hpp"
 #include "lace/tree/Expr.hpp"
 #include "lace/tree/Scope.hpp"
+#include "lace/tree/SymbolTable.hpp"
 #include "lace/types/SourceLocation.hpp"
 
 namespace lace {
 
+class ThreadPool;
+
 /// Definition of a parser for a lace translation unit into a syntax tree.
 class Parser final {
-    using Tokens = std::vector<Token>;
-
     std::string m_file;
     Lexer m_lexer;
-    Tokens m_tokens = {};
+    TokenWindow m_tokens;
     AST* m_ast = nullptr;
     AST::Context* m_context = nullptr;
     Scope* m_scope = nullptr;
+    SymbolTable m_symbols = {};
+
+    /// If function bodies should be skipped over, to be parsed later on.
+    bool m_defer_bodies = false;
 
     /// Returns the current token in use.
     ///
     /// Fails by assertion if no tokens have been lexed yet.
-    inline const Token& curr() const {
-        assert(!m_tokens.empty() && "no tokens have been lexed yet!");
-        return m_tokens.back();
-    }
+    inline const Token& curr() const { return m_tokens.curr(); }
 
-    /// Lex the next token.
-    inline void next() {
-        Token token;
-        m_lexer.lex(token);
-        m_tokens.push_back(token); 
-    }
+    /// Returns the token |n| positions ahead of the current one, up to the
+    /// lookahead of the token window.
+    inline const Token& peek(uint32_t n = 1) { return m_tokens.peek(n); }
+
+    /// Move onto the next token.
+    inline void next() { m_tokens.next(); }
 
     /// Returns the current location in source, based on the current token.
     inline SourceLocation loc() const { return curr().loc; }
@@ -58,12 +61,6 @@ class Parser final {
     /// Test if the kind of the current token matches with |kind|.
     inline bool match(Token::Kind kind) const { return curr().kind == kind; }
 
-    /// Test if the current token is an identifier and has a value that matches
-    /// with |kw|.
-    inline bool match(const char* kw) const {
-        return curr().kind == Token::Identifier && curr().value == kw;
-    }
-
     /// Expect the kind of the current token to match with |kind|. 
     ///
     /// If the token is a match, it will be consumed and the function will
@@ -76,34 +73,35 @@ class Parser final {
         return true;
     }
 
-    /// Expect the current token to be an identifier whose values matches with 
-    /// |kw|.
-    ///
-    /// If the token is a match, it will be consumed and the function will
-    /// return true. Otherwise, the routine returns false.
-    inline bool expect(const char* kw) {
-        if (!match(kw))
-            return false;
-
-        next();
-        return true;
-    }
-
     /// Test if |ident| is a reserved identifier, i.e. conflicts with a keyword
     /// in the language.
-    bool is_reserved(const std::string& ident) const;
+    bool is_reserved(Symbol ident) const;
 
     /// Enter a new scope, with the current scope as the parent node. Returns
     /// an unmanaged pointer to the new scope.
     [[nodiscard]] inline Scope* enter_scope() {
-        m_scope = new Scope(m_scope);
+        m_scope = new (m_context->get_arena()) Scope(m_scope);
+        m_symbols.enter();
         return m_scope;
     }
 
     /// Exit the current scope, and move up to the parent node.
     ///
     /// If there is no parent scope, then the current scope just becomes null.
-    inline void exit_scope() { m_scope = m_scope->get_parent(); }
+    inline void exit_scope() { 
+        m_scope = m_scope->get_parent(); 
+        m_symbols.exit();
+    }
+
+    /// Add |defn| to the current scope, unless a definition of the same name
+    /// is already visible from it, in which case the first one is kept.
+    inline void declare(NamedDefn* defn) {
+        if (m_symbols.get(defn->get_symbol()))
+            return;
+
+        m_scope->add(defn);
+        m_symbols.add(defn);
+    }
 
     /// Returns the equivelant unary operator for the given token |kind|.
     UnaryOp::Operator get_unary_op(Token::Kind kind) const;
@@ -111,6 +109,10 @@ class Parser final {
     /// Returns the equivelant binary operator for the given token |kind|.
     BinaryOp::Operator get_binary_op(Token::Kind kind) const;
 
+    /// Returns the builtin type named by the token |kind|, which must be one
+    /// of the builtin type keywords.
+    BuiltinType::Kind get_builtin_type(Token::Kind kind) const;
+
     /// Returns the integer precedence for the binary operator |op|.
     int8_t get_op_precedence(BinaryOp::Operator op) const;
 
@@ -125,12 +127,15 @@ class Parser final {
     
     Stmt* parse_initial_statement();
     Stmt* parse_block_statement();
+
+    /// Skip over the block statement at the current token by matching its 
+    /// braces, without parsing it. Returns the location of the closing brace.
+    SourceLocation skip_block_statement();
     Stmt* parse_control_statement();
     Stmt* parse_declarative_statement();
 
     Expr* parse_initial_expression();
     Expr* parse_primary_expression();
-    Expr* parse_identifier_expression();
     Expr* parse_prefix_operator();
     Expr* parse_postfix_operator();
     Expr* parse_binary_operator(Expr* base, int8_t precedence);
@@ -148,14 +153,34 @@ class Parser final {
     Expr* parse_named_reference();
 
 public:
-    /// Create a new parser instance to work on |source|. Optionally, a |path|
+    /// Create a new parser instance to work on |source|, which is borrowed
+    /// and must be null-terminated, as per the Lexer. Optionally, a |path|
     /// may be provided for better diagnostics i.e. reading in faulty code
     /// from a file which contains |source|.
-    Parser(const std::string& source, const std::string& path = "");
+    ///
+    /// If |defer_bodies| is set, then the bodies of functions are skipped over
+    /// and left to be parsed with parse_body or parse_bodies.
+    Parser(std::string_view source, const std::string& path = "", 
+           bool defer_bodies = false);
 
     /// Attempt to parse and return an abstract syntax tree from the source
     /// this parser was constructed with.
     [[nodiscard]] AST* parse();
+
+    /// Parse the deferred body of |function| in the tree |ast|, which was 
+    /// parsed from |source|. The nodes of the body are allocated in |context|,
+    /// which is either the context of |ast| or a fork of it.
+    ///
+    /// Bodies of different functions may be parsed at the same time, so long
+    /// as each thread allocates in a fork of its own.
+    static void parse_body(std::string_view source, AST* ast, 
+                           AST::Context& context, FunctionDefn* function);
+
+    /// Parse every deferred function body in the tree |ast|, which was parsed
+    /// from |source|. If a |pool| is given, then the bodies are parsed as jobs
+    /// on it, each allocating in a fork of the context of |ast|.
+    static void parse_bodies(std::string_view source, AST* ast, 
+                             ThreadPool* pool = nullptr);
 };
 
 } // namespace lace
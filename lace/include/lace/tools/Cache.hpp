@@ -0,0 +1,81 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_CACHE_H_
+#define LOVELACE_CACHE_H_
+
+//
+//  This header file declares the Cache class, an on-disk store of compiled
+//  objects keyed by a hash of everything that went into them, and the Hasher
+//  class used to compute such keys.
+//
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace lace {
+
+/// An incremental 64-bit FNV-1a hash.
+class Hasher final {
+    uint64_t m_hash = 0xcbf29ce484222325;
+
+public:
+    Hasher() = default;
+
+    /// Mix |size| bytes from |data| into the hash.
+    void add(const void* data, uint64_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (uint64_t i = 0; i < size; ++i) {
+            m_hash ^= bytes[i];
+            m_hash *= 0x100000001b3;
+        }
+    }
+
+    /// Mix the string |str| into the hash. The length is mixed in as well, so
+    /// that consecutive strings cannot alias each other.
+    void add(std::string_view str) {
+        add(static_cast<uint64_t>(str.size()));
+        add(str.data(), str.size());
+    }
+
+    void add(uint64_t value) { add(&value, sizeof(value)); }
+
+    uint64_t get() const { return m_hash; }
+};
+
+/// A directory of objects, each named by the hash of its inputs.
+///
+/// Entries are written to a temporary file first and then renamed into
+/// place, so concurrent compilations sharing a cache never observe a partial
+/// entry.
+class Cache final {
+    std::string m_dir;
+
+    /// Returns the path of the entry for |key|.
+    std::string get_path(uint64_t key) const;
+
+public:
+    /// Create a cache in the directory at |dir|, which is created on demand.
+    Cache(const std::string& dir) : m_dir(dir) {}
+
+    Cache(const Cache&) = delete;
+    void operator=(const Cache&) = delete;
+
+    Cache(Cache&&) noexcept = delete;
+    void operator=(Cache&&) noexcept = delete;
+
+    /// Look up the object for |key|, and if it exists, read it into |object|.
+    /// Returns true if the entry was found.
+    bool load(uint64_t key, std::string& object) const;
+
+    /// Store |object| as the entry for |key|. Failing to write to the cache
+    /// is not an error; the entry is simply missing on the next lookup.
+    void store(uint64_t key, const std::string& object) const;
+};
+
+} // namespace lace
+
+#endif // LOVELACE_CACHE_H_
@@ -0,0 +1,108 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_DUMP_H_
+#define LOVELACE_DUMP_H_
+
+//
+//  This header file declares the DumpBuffer and DumpWriter classes, used to
+//  write the compiler dumps asked for with -dump-after and -dump-func off of
+//  the path of compilation.
+//
+//  A dump is built up in memory in a DumpBuffer, and is then handed to the
+//  DumpWriter, whose thread writes it out to disk while compilation carries
+//  on. Nothing is built or written for passes that were not asked for.
+//
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace lace {
+
+/// An output stream that appends everything written to it to a single string,
+/// which can then be taken out of it without a copy.
+class DumpBuffer final : public std::ostream {
+    /// The stream buffer that appends to |m_text|.
+    class Buf final : public std::streambuf {
+        std::string& m_text;
+
+    public:
+        Buf(std::string& text) : m_text(text) {}
+
+    protected:
+        int_type overflow(int_type ch) override;
+        std::streamsize xsputn(const char* str, std::streamsize n) override;
+    };
+
+    std::string m_text = {};
+    Buf m_buf;
+
+public:
+    /// The number of bytes reserved up front for each buffer, so that most
+    /// dumps are built without having to grow.
+    static constexpr uint64_t InitialCapacity = 256 * 1024;
+
+    DumpBuffer();
+
+    DumpBuffer(const DumpBuffer&) = delete;
+    void operator=(const DumpBuffer&) = delete;
+
+    DumpBuffer(DumpBuffer&&) noexcept = delete;
+    void operator=(DumpBuffer&&) noexcept = delete;
+
+    /// Take the text written so far out of this buffer, leaving it empty.
+    std::string take();
+};
+
+/// Writes dumps out to disk on a background thread.
+///
+/// Dumps are written in the order they are submitted. Failing to open a file
+/// for a dump is logged as a warning, but does not stop the compiler.
+class DumpWriter final {
+    using Entry = std::pair<std::string, std::string>;
+
+    std::deque<Entry> m_queue = {};
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::condition_variable m_idle;
+
+    /// If the thread is in the middle of writing an entry.
+    bool m_busy = false;
+    bool m_stop = false;
+
+    std::thread m_thread;
+
+    /// The loop run by the writer thread.
+    void work();
+
+public:
+    DumpWriter();
+
+    /// Write out all pending dumps, and stop the writer thread.
+    ~DumpWriter();
+
+    DumpWriter(const DumpWriter&) = delete;
+    void operator=(const DumpWriter&) = delete;
+
+    DumpWriter(DumpWriter&&) noexcept = delete;
+    void operator=(DumpWriter&&) noexcept = delete;
+
+    /// Queue |text| to be written to the file at |path|, replacing it.
+    void submit(std::string path, std::string text);
+
+    /// Wait until every dump submitted so far has been written.
+    void finish();
+};
+
+} // namespace lace
+
+#endif // LOVELACE_DUMP_H_
@@ -11,10 +11,39 @@
 //  I/O.
 //
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace lace {
 
+/// A read-only view of the file at a path, mapped into memory rather than
+/// read into a buffer of our own.
+///
+/// The contents are always followed by a null terminator, even when the file
+/// ends on a page boundary, so they can be handed straight to the Lexer.
+class MappedFile final {
+    const char* m_data = "";
+    uint64_t m_size = 0;
+
+    /// The size of the mapping, which is zero for an empty file.
+    uint64_t m_mapped = 0;
+
+public:
+    /// Map the file at |path|. Fails fatally if the file cannot be read.
+    MappedFile(const std::string& path);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    void operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&&) noexcept = delete;
+    void operator=(MappedFile&&) noexcept = delete;
+
+    std::string_view get_text() const { return { m_data, m_size }; }
+};
+
 /// Read in the file at |path| and return its contents as a string.
 std::string read_file(const std::string& path);
 
@@ -0,0 +1,107 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_SOURCE_MANAGER_H_
+#define LOVELACE_SOURCE_MANAGER_H_
+
+//
+//  This header file declares the SourceManager class, which owns the contents
+//  of each source file given to the compiler, so that a file is read from
+//  disk once and then shared by the lexer and by diagnostics.
+//
+
+#include "lace/tools/Files.hpp"
+#include "lace/types/SourceLocation.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace lace {
+
+/// The contents of a single source file, either mapped from disk or held in
+/// memory. Either way, the contents are followed by a null terminator.
+///
+/// The offsets at which each line starts are only computed the first time a
+/// line is looked up, since most files never have a diagnostic rendered.
+class SourceBuffer final {
+    std::string m_path;
+    std::unique_ptr<MappedFile> m_file = nullptr;
+    std::string m_owned = "";
+    std::string_view m_text;
+
+    mutable std::vector<uint32_t> m_lines = {};
+    mutable std::once_flag m_once;
+
+    /// Compute the offsets at which each line of this buffer starts.
+    void index_lines() const;
+
+public:
+    SourceBuffer(const std::string& path, std::string text)
+      : m_path(path), m_owned(std::move(text)), m_text(m_owned) {}
+
+    SourceBuffer(const std::string& path, std::unique_ptr<MappedFile> file)
+      : m_path(path), m_file(std::move(file)), m_text(m_file->get_text()) {}
+
+    SourceBuffer(const SourceBuffer&) = delete;
+    void operator=(const SourceBuffer&) = delete;
+
+    SourceBuffer(SourceBuffer&&) noexcept = delete;
+    void operator=(SourceBuffer&&) noexcept = delete;
+
+    const std::string& get_path() const { return m_path; }
+
+    std::string_view get_text() const { return m_text; }
+
+    /// Returns the number of lines in this buffer.
+    uint32_t num_lines() const;
+
+    /// Returns the text of the 1-based |line|, without its line break, or an
+    /// empty string if this buffer has no such line.
+    std::string_view get_line(uint32_t line) const;
+
+    /// Returns the line and column of the character at |offset|.
+    SourceLocation get_location(uint32_t offset) const;
+};
+
+/// The set of source buffers known to the compiler, keyed by path.
+///
+/// Buffers are never removed, so references to them stay valid for the
+/// lifetime of the manager. It is safe to add and look up buffers from many
+/// threads at once.
+class SourceManager final {
+    std::unordered_map<std::string, std::unique_ptr<SourceBuffer>> m_buffers;
+    mutable std::mutex m_mutex;
+
+public:
+    SourceManager() = default;
+
+    SourceManager(const SourceManager&) = delete;
+    void operator=(const SourceManager&) = delete;
+
+    SourceManager(SourceManager&&) noexcept = delete;
+    void operator=(SourceManager&&) noexcept = delete;
+
+    /// Add the contents |text| of the file at |path|, and return its buffer.
+    /// If a buffer was already added for |path|, then that one is returned
+    /// and |text| is dropped.
+    const SourceBuffer& add(const std::string& path, std::string text);
+
+    /// Returns the buffer for the file at |path|, or null if it was never
+    /// added.
+    const SourceBuffer* get(const std::string& path) const;
+
+    /// Returns the buffer for the file at |path|, mapping it from disk first
+    /// if it was never added.
+    const SourceBuffer& load(const std::string& path);
+};
+
+} // namespace lace
+
+#endif // LOVELACE_SOURCE_MANAGER_H_
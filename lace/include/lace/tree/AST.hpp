@@ -10,14 +10,20 @@
 //  This header file declares the AST type, which represents the root of an
 //  abstract syntax tree parsed from a source file.
 //
-//  It also includes the nested Context class, which is used as a manager for
-//  frontend type ownership.
+//  It also includes the nested Context class, which owns the arena that every
+//  node, scope and frontend type of the tree is allocated in. None of them are
+//  deleted on their own; they are all destroyed along with the context.
 //
 
+#include "lace/core/Arena.hpp"
+#include "lace/core/Symbol.hpp"
 #include "lace/tree/Visitor.hpp"
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -31,13 +37,18 @@ class DeferredType;
 class Defn;
 class EnumType;
 class FunctionType;
+class NamedDefn;
 class PointerType;
 class Scope;
 class StructType;
 
+template<typename Derived>
+class StaticVisitor;
+
 class AST final {
 public:
     using Defns = std::vector<Defn*>;
+    using Exports = std::vector<NamedDefn*>;
 
     class Context final {
         friend class SymbolAnalysis;
@@ -50,15 +61,19 @@ public:
         friend class PointerType;
         friend class StructType;
 
-        using AliasTypePool = std::unordered_map<std::string, AliasType*>;
-        using ArrayTypePool = std::vector<ArrayType*>;
+        // Structural types are uniqued by the hash of what they are made of,
+        // and checked against the other types in the same bucket.
+
+        using AliasTypePool = std::unordered_map<Symbol, AliasType*>;
+        using ArrayTypePool = std::unordered_multimap<size_t, ArrayType*>;
         using BuiltinTypePool = std::vector<BuiltinType*>;
-        using DeferredTypePool = std::vector<DeferredType*>;
-        using EnumTypePool = std::unordered_map<std::string, EnumType*>;
-        using FunctionTypePool = std::vector<FunctionType*>;
-        using PointerTypePool = std::vector<PointerType*>;
-        using StructTypePool = std::unordered_map<std::string, StructType*>;
+        using DeferredTypePool = std::unordered_map<Symbol, DeferredType*>;
+        using EnumTypePool = std::unordered_map<Symbol, EnumType*>;
+        using FunctionTypePool = std::unordered_multimap<size_t, FunctionType*>;
+        using PointerTypePool = std::unordered_multimap<size_t, PointerType*>;
+        using StructTypePool = std::unordered_map<Symbol, StructType*>;
 
+        Arena m_arena;
         AliasTypePool m_aliases = {};
         ArrayTypePool m_arrays = {};
         BuiltinTypePool m_builtins = {};
@@ -68,16 +83,57 @@ public:
         PointerTypePool m_pointers = {};
         StructTypePool m_structs = {};
 
+        /// The context that types are made in, which is this one unless it is
+        /// a fork of another.
+        Context* m_root = this;
+
+        /// The forks of this context, which live as long as it does.
+        std::vector<std::unique_ptr<Context>> m_forks = {};
+
+        /// Guards the type pools, as forks may make types from other threads.
+        std::recursive_mutex m_types_mutex;
+
+        /// If this context has been forked, directly or through one of its
+        /// forks. Only set on the root context.
+        bool m_forked = false;
+
+        /// Create a fork of the context |root|.
+        Context(Context& root) : m_root(&root) {}
+
+        /// Returns a lock on the type pools of this context. The lock is only
+        /// taken once the context has been forked, as until then nothing else
+        /// can make types in it, and sequential compiles never pay for it.
+        std::unique_lock<std::recursive_mutex> lock_types() {
+            if (!m_forked)
+                return std::unique_lock<std::recursive_mutex>();
+
+            return std::unique_lock<std::recursive_mutex>(m_types_mutex);
+        }
+
     public:
         Context();
 
-        ~Context();
+        ~Context() = default;
 
         Context(const Context&) = delete;
         void operator=(const Context&) = delete;
 
         Context(Context&& other) noexcept = delete;
         void operator=(Context&& other) noexcept = delete;
+
+        /// Returns the arena that the tree of this context is allocated in.
+        Arena& get_arena() { return m_arena; }
+
+        /// Returns the context that types are made in.
+        Context& get_root() { return *m_root; }
+
+        /// Create a fork of this context, for another thread to allocate the
+        /// nodes of a part of the same tree in.
+        ///
+        /// A fork has an arena of its own, but makes its types in the root
+        /// context, so that types stay unique across the whole tree. Forks are
+        /// destroyed along with this context. Creating them is not thread-safe.
+        Context& fork();
     };
 
 private:
@@ -85,6 +141,7 @@ private:
     std::string m_file;
     std::vector<Defn*> m_defns = {};
     std::vector<Defn*> m_loaded = {};
+    Exports m_exports = {};
     Scope* m_scope = nullptr;
 
     AST(const std::string& file);
@@ -92,7 +149,7 @@ private:
 public:
     [[nodiscard]] static AST* create(const std::string& file);
 
-    ~AST();
+    ~AST() = default;
 
     AST(const AST&) = delete;
     void operator=(const AST&) = delete;
@@ -102,6 +159,13 @@ public:
 
     void accept(Visitor& visitor) { visitor.visit(*this); }
 
+    /// Accept the static |visitor|, which is called without going through a
+    /// virtual visit.
+    template<typename Derived>
+    void accept(StaticVisitor<Derived>& visitor) {
+        static_cast<Derived&>(visitor).visit(*this);
+    }
+
     const std::string& get_file() const { return m_file; }
 
     const Context& get_context() const { return m_context; }
@@ -128,6 +192,13 @@ public:
 
     uint32_t num_loaded() const { return m_loaded.size(); }
 
+    /// Returns the public definitions of this tree, which other trees bind to
+    /// when they load it. These are gathered by the parser.
+    const Exports& get_exports() const { return m_exports; }
+    Exports& get_exports() { return m_exports; }
+
+    uint32_t num_exports() const { return m_exports.size(); }
+
     const Scope* get_scope() const { return m_scope; }
     Scope* get_scope() { return m_scope; }
 };
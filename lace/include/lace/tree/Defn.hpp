@@ -11,6 +11,8 @@
 //  language definitions in the abstract syntax tree.
 //
 
+#include "lace/core/Arena.hpp"
+#include "lace/core/Symbol.hpp"
 #include "lace/tree/AST.hpp"
 #include "lace/tree/Rune.hpp"
 #include "lace/tree/Type.hpp"
@@ -18,6 +20,7 @@
 #include "lace/types/SourceSpan.hpp"
 
 #include <cassert>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -31,7 +34,7 @@ class Stmt;
 class Type;
 
 /// Base class for all definition types in the abstract syntax tree.
-class Defn {
+class Defn : public ArenaAllocated<Defn> {
 public:
     /// The different kinds of definitions.
     enum Kind : uint32_t {
@@ -128,15 +131,15 @@ public:
 /// Base class for definitions with a name and potential rune set.
 class NamedDefn : public Defn {
 protected:
-    std::string m_name;
+    Symbol m_name;
     Runes m_runes;
 
-    NamedDefn(Defn::Kind kind, SourceSpan span, const std::string& name, 
+    NamedDefn(Defn::Kind kind, SourceSpan span, Symbol name, 
               const Runes& runes)
       : Defn(kind, span), m_name(name), m_runes(runes) {}
 
 public:
-    virtual ~NamedDefn() override;
+    virtual ~NamedDefn() = default;
 
     NamedDefn(const NamedDefn&) = delete;
     void operator=(const NamedDefn&) = delete;
@@ -144,9 +147,12 @@ public:
     NamedDefn(NamedDefn&&) noexcept = delete;
     void operator=(NamedDefn&&) noexcept = delete;
 
-    void set_name(const std::string& name) { m_name = name; }
-    const std::string& get_name() const { return m_name; }
-    std::string& get_name() { return m_name; }
+    void set_name(Symbol name) { m_name = name; }
+    const std::string& get_name() const { return m_name.str(); }
+
+    /// Returns the interned name of this definition, for comparisons and 
+    /// lookups that should not touch the characters of the name.
+    Symbol get_symbol() const { return m_name; }
 
     const Runes& get_runes() const { return m_runes; }
     Runes& get_runes() { return m_runes; }
@@ -199,7 +205,7 @@ class ValueDefn : public NamedDefn {
 protected:
     QualType m_type;
 
-    ValueDefn(Defn::Kind kind, SourceSpan span, const std::string& name, 
+    ValueDefn(Defn::Kind kind, SourceSpan span, Symbol name, 
               const Runes& runes, const QualType& type)
       : NamedDefn(kind, span, name, runes), m_type(type) {}
 
@@ -227,7 +233,7 @@ class VariableDefn final : public ValueDefn {
     // If this is a global variable.
     bool m_global;
 
-    VariableDefn(SourceSpan span, const std::string& name, const Runes& runes, 
+    VariableDefn(SourceSpan span, Symbol name, const Runes& runes, 
                  const QualType& type, Expr* init, bool global)
       : ValueDefn(Defn::Variable, span, name, runes, type), m_init(init), 
         m_global(global) {}
@@ -235,10 +241,10 @@ class VariableDefn final : public ValueDefn {
 public:
     [[nodiscard]]
     static VariableDefn* create(AST::Context& ctx, SourceSpan span, 
-                                const std::string& name, const Runes& runes, 
+                                Symbol name, const Runes& runes, 
                                 const QualType& type, Expr* init, bool global);
 
-    ~VariableDefn() override;
+    ~VariableDefn() = default;
 
     VariableDefn(const VariableDefn&) = delete;
     void operator=(const VariableDefn&) = delete;
@@ -258,14 +264,14 @@ public:
 
 /// Represents a function parameter definition.
 class ParameterDefn final : public ValueDefn {
-    ParameterDefn(SourceSpan span, const std::string& name, const Runes& runes,
+    ParameterDefn(SourceSpan span, Symbol name, const Runes& runes,
                   const QualType& type)
       : ValueDefn(Defn::Parameter, span, name, runes, type) {}
       
 public:
     [[nodiscard]]
     static ParameterDefn* create(AST::Context& ctx, SourceSpan span, 
-                                 const std::string& name, const Runes& runes,
+                                 Symbol name, const Runes& runes,
                                  const QualType& type);
 
     ~ParameterDefn() = default;
@@ -284,6 +290,20 @@ class FunctionDefn final : public ValueDefn {
 public:
     using Params = std::vector<ParameterDefn*>;
 
+    /// Where the body of a function is in source, for bodies that the parser
+    /// skipped over to be parsed later on.
+    struct DeferredBody final {
+        /// The offset of the opening brace of the body into the source.
+        uint32_t offset;
+
+        /// The location of the opening brace of the body.
+        SourceLocation loc;
+
+        /// The number of definitions in the scope of the file that the body 
+        /// could see when it was skipped over.
+        uint32_t visible;
+    };
+
 private:
     /// The scope of this function.
     ///
@@ -298,7 +318,10 @@ private:
     /// The body of the function, if it has one.
     BlockStmt* m_body;
 
-    FunctionDefn(SourceSpan span, const std::string& name, const Runes& runes, 
+    /// The body of the function, if it has one that is yet to be parsed.
+    std::optional<DeferredBody> m_deferred = std::nullopt;
+
+    FunctionDefn(SourceSpan span, Symbol name, const Runes& runes, 
                  const QualType& type, Scope* scope, const Params& params, 
                  BlockStmt* body)
       : ValueDefn(Defn::Function, span, name, runes, type), m_scope(scope), 
@@ -307,11 +330,11 @@ private:
 public:
     [[nodiscard]]
     static FunctionDefn* create(AST::Context& ctx, SourceSpan span, 
-                                const std::string& name, const Runes& runes, 
+                                Symbol name, const Runes& runes, 
                                 const QualType& type, Scope* scope, 
                                 const Params& params, BlockStmt* body = nullptr);
 
-    ~FunctionDefn() override;
+    ~FunctionDefn() = default;
 
     FunctionDefn(const FunctionDefn&) = delete;
     void operator=(const FunctionDefn&) = delete;
@@ -359,20 +382,29 @@ public:
     BlockStmt* get_body() { return m_body; }
 
     bool has_body() const { return m_body != nullptr; }
+
+    void set_deferred_body(const DeferredBody& body) { m_deferred = body; }
+    void clear_deferred_body() { m_deferred = std::nullopt; }
+    const std::optional<DeferredBody>& get_deferred_body() const { 
+        return m_deferred; 
+    }
+
+    /// Test if this function has a body which has not been parsed yet.
+    bool has_deferred_body() const { return m_deferred.has_value(); }
 };
 
 /// Represents a field definition within a structure.
 class FieldDefn final : public ValueDefn {
     uint32_t m_index;
 
-    FieldDefn(SourceSpan span, const std::string& name, const Runes& runes, 
+    FieldDefn(SourceSpan span, Symbol name, const Runes& runes, 
               const QualType& type, uint32_t index)
       : ValueDefn(Defn::Field, span, name, runes, type), m_index(index) {}
 
 public:
     [[nodiscard]]
     static FieldDefn* create(AST::Context& ctx, SourceSpan span, 
-                             const std::string& name, const Runes& runes, 
+                             Symbol name, const Runes& runes, 
                              const QualType& type, uint32_t index);
 
     ~FieldDefn() = default;
@@ -392,14 +424,14 @@ public:
 class VariantDefn final : public ValueDefn {
     const int64_t m_value;
 
-    VariantDefn(SourceSpan span, const std::string& name, const Runes& runes, 
+    VariantDefn(SourceSpan span, Symbol name, const Runes& runes, 
                 const QualType& type, int64_t value)
       : ValueDefn(Defn::Variant, span, name, runes, type), m_value(value) {}
 
 public:
     [[nodiscard]]
     static VariantDefn* create(AST::Context& ctx, SourceSpan span, 
-                               const std::string& name, const Runes& runes, 
+                               Symbol name, const Runes& runes, 
                                const QualType& type, int64_t value);
 
     ~VariantDefn() = default;
@@ -421,7 +453,7 @@ protected:
     /// The type defined by this definition.
     const Type* m_type;
 
-    TypeDefn(Defn::Kind kind, SourceSpan span, const std::string& name, 
+    TypeDefn(Defn::Kind kind, SourceSpan span, Symbol name, 
              const Runes& runes, const Type* type)
       : NamedDefn(kind, span, name, runes), m_type(type) {}
 
@@ -440,14 +472,14 @@ public:
 
 /// Represents a type alias definition.
 class AliasDefn final : public TypeDefn {
-    AliasDefn(SourceSpan span, const std::string& name, const Runes& runes, 
+    AliasDefn(SourceSpan span, Symbol name, const Runes& runes, 
               const Type* type)
       : TypeDefn(Defn::Alias, span, name, runes, type) {}
 
 public:
     [[nodiscard]]
     static AliasDefn* create(AST::Context& ctx, SourceSpan span, 
-                             const std::string& name, const Runes& runes, 
+                             Symbol name, const Runes& runes, 
                              const Type* type);
 
     ~AliasDefn() = default;
@@ -469,17 +501,17 @@ public:
 private:
     Fields m_fields = {};
 
-    StructDefn(SourceSpan span, const std::string& name, const Runes& runes, 
+    StructDefn(SourceSpan span, Symbol name, const Runes& runes, 
                const Type* type)
       : TypeDefn(Defn::Struct, span, name, runes, type) {}
       
 public:
     [[nodiscard]]
     static StructDefn* create(AST::Context& ctx, SourceSpan span, 
-                              const std::string& name, const Runes& runes, 
+                              Symbol name, const Runes& runes, 
                               const Type* type);
 
-    ~StructDefn() override;
+    ~StructDefn() = default;
 
     StructDefn(const StructDefn&) = delete;
     void operator=(const StructDefn&) = delete;
@@ -503,15 +535,15 @@ public:
         return m_fields[i];
     }
 
-    const FieldDefn* get_field(const std::string& name) const {
+    const FieldDefn* get_field(Symbol name) const {
         for (const auto& field : m_fields)
-            if (field->get_name() == name)
+            if (field->get_symbol() == name)
                 return field;
 
         return nullptr;
     }
 
-    FieldDefn* get_field(const std::string& name) {
+    FieldDefn* get_field(Symbol name) {
         return const_cast<FieldDefn*>(
             static_cast<const StructDefn*>(this)->get_field(name));
     }
@@ -528,17 +560,17 @@ public:
 private:
     Variants m_variants = {};
 
-    EnumDefn(SourceSpan span, const std::string& name, const Runes& runes, 
+    EnumDefn(SourceSpan span, Symbol name, const Runes& runes, 
              const Type* type)
       : TypeDefn(Kind::Enum, span, name, runes, type) {}
 
 public:
     [[nodiscard]]
     static EnumDefn* create(AST::Context& ctx, SourceSpan span, 
-                            const std::string& name, const Runes& runes, 
+                            Symbol name, const Runes& runes, 
                             const Type* type);
 
-    ~EnumDefn() override;
+    ~EnumDefn() = default;
 
     EnumDefn(const EnumDefn&) = delete;
     void operator=(const EnumDefn&) = delete;
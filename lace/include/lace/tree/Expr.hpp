@@ -11,6 +11,7 @@
 //  expressions in the abstract syntax tree.
 //
 
+#include "lace/core/Arena.hpp"
 #include "lace/tree/Stmt.hpp"
 #include "lace/tree/Type.hpp"
 #include "lace/tree/Visitor.hpp"
@@ -29,7 +30,7 @@ class Type;
 class ValueDefn;
 
 /// Base class for all expression nodes in the abstract syntax tree.
-class Expr {
+class Expr : public ArenaAllocated<Expr> {
 public:
     /// The different kinds of expressions.
     enum Kind : uint32_t {
@@ -368,7 +369,7 @@ public:
     static BinaryOp* create(AST::Context& ctx, SourceSpan span, Operator op, 
                             Expr* lhs, Expr* rhs);
 
-    ~BinaryOp() override;
+    ~BinaryOp() = default;
     
     BinaryOp(const BinaryOp&) = delete;
     void operator=(const BinaryOp&) = delete;
@@ -435,7 +436,7 @@ public:
     static UnaryOp* create(AST::Context& ctx, SourceSpan span, Operator op, 
                            bool prefix, Expr* expr);
 
-    ~UnaryOp() override;
+    ~UnaryOp() = default;
 
     UnaryOp(const UnaryOp&) = delete;
     void operator=(const UnaryOp&) = delete;
@@ -470,22 +471,22 @@ class AccessExpr final : public Expr {
     
     ///  The name of the structure field to access. Used for the sake of 
     /// forwarding referencing.
-    std::string m_name;
+    Symbol m_name;
 
     /// The field to access.
     const FieldDefn* m_field;
 
     AccessExpr(SourceSpan span, const QualType& type, Expr* base, 
-               const std::string& name, const FieldDefn* field)
+               Symbol name, const FieldDefn* field)
       : Expr(Expr::Access, span, type), m_base(base), m_name(name), 
         m_field(field) {}
 
 public:
     [[nodiscard]]
     static AccessExpr* create(AST::Context& ctx, SourceSpan span, Expr* base, 
-                              const std::string& name);
+                              Symbol name);
 
-    ~AccessExpr() override;
+    ~AccessExpr() = default;
 
     AccessExpr(const AccessExpr&) = delete;
     void operator=(const AccessExpr&) = delete;
@@ -500,7 +501,8 @@ public:
     const Expr* get_base() const { return m_base; }
     Expr* get_base() { return m_base; }
 
-    const std::string& get_name() { return m_name; }
+    const std::string& get_name() { return m_name.str(); }
+    Symbol get_symbol() const { return m_name; }
 
     void set_field(const FieldDefn* field) { m_field = field; }
     const FieldDefn* get_field() const { return m_field; }
@@ -526,7 +528,7 @@ public:
     static CallExpr* create(AST::Context& ctx, SourceSpan span, Expr* callee, 
                             const Args& args);
 
-    ~CallExpr() override;
+    ~CallExpr() = default;
     
     CallExpr(const CallExpr&) = delete;
     void operator=(const CallExpr&) = delete;
@@ -568,7 +570,7 @@ public:
     static CastExpr* create(AST::Context& ctx, SourceSpan span, 
                             const QualType& type, Expr* expr);
 
-    ~CastExpr() override;
+    ~CastExpr() = default;
     
     CastExpr(const CastExpr&) = delete;
     void operator=(const CastExpr&) = delete;
@@ -595,7 +597,7 @@ public:
     [[nodiscard]]
     static ParenExpr* create(AST::Context& ctx, SourceSpan span, Expr* expr);
 
-    ~ParenExpr() override;
+    ~ParenExpr() = default;
 
     ParenExpr(const ParenExpr&) = delete;
     void operator=(const ParenExpr&) = delete;
@@ -613,18 +615,18 @@ public:
 
 /// Represents a named definition reference expression.
 class RefExpr final : public Expr {
-    const std::string m_name;
+    const Symbol m_name;
     const ValueDefn* m_defn;
 
 public:
-    RefExpr(SourceSpan span, const QualType& type, const std::string& name, 
+    RefExpr(SourceSpan span, const QualType& type, Symbol name, 
                 const ValueDefn* defn)
       : Expr(Expr::Ref, span, type), m_name(name), m_defn(defn) {}
 
 public:
     [[nodiscard]]
     static RefExpr* create(AST::Context& ctx, SourceSpan span, 
-                           const std::string& name, const ValueDefn* defn);
+                           Symbol name, const ValueDefn* defn);
 
     ~RefExpr() = default;
     
@@ -638,7 +640,8 @@ public:
 
     bool is_lvalue() const override;
 
-    const std::string& get_name() const { return m_name; }
+    const std::string& get_name() const { return m_name.str(); }
+    Symbol get_symbol() const { return m_name; }
 
     void set_defn(const ValueDefn* defn) { m_defn = defn; }
     const ValueDefn* get_defn() const { return m_defn; }
@@ -687,7 +690,7 @@ public:
     static SubscriptExpr* create(AST::Context& ctx, SourceSpan span, Expr* base, 
                                  Expr* index);
 
-    ~SubscriptExpr() override;
+    ~SubscriptExpr() = default;
     
     SubscriptExpr(const SubscriptExpr&) = delete;
     void operator=(const SubscriptExpr&) = delete;
@@ -0,0 +1,52 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_INTERFACE_H_
+#define LOVELACE_INTERFACE_H_
+
+//
+//  This header file declares functions to write and read module interfaces,
+//  a compact binary summary of what a syntax tree exposes to the files that
+//  load it.
+//
+//  An interface holds the loads of a tree, the layout of every type it
+//  defines, and the signatures of its public functions and globals. Reading
+//  one back gives a tree with the same definitions, minus function bodies and
+//  initializers, which is enough for other files to be analyzed and compiled
+//  against without parsing the source again.
+//
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace lace {
+
+class AST;
+
+/// Write the interface of the analyzed tree |ast| to |out|. The |hash| is of
+/// the source the tree was parsed from, and is what a later read is checked
+/// against to tell if the source changed since. The |deps| stamp is of the 
+/// files the tree loads, and is kept for the reader to check in turn once 
+/// those files are known.
+void write_interface(const AST* ast, uint64_t hash, uint64_t deps,
+                     std::ostream& out);
+
+/// Read the interface in |data| back into a new tree for the source file at
+/// |file|. Named types in the tree are left deferred, for name analysis to
+/// resolve as it would for a parsed tree.
+///
+/// Returns null if |data| is not a well-formed interface, or if it was
+/// written for a source that does not hash to |hash|. Otherwise, the stamp of
+/// the loaded files that the interface was written with is stored in |deps|, 
+/// if given.
+[[nodiscard]] AST* read_interface(std::string_view data,
+                                  const std::string& file, uint64_t hash,
+                                  uint64_t* deps = nullptr);
+
+} // namespace lace
+
+#endif // LOVELACE_INTERFACE_H_
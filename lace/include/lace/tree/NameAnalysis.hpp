@@ -7,18 +7,18 @@
 #define LOVELACE_NAME_ANALYSIS_H_
 
 #include "lace/core/Options.hpp"
-#include "lace/tree/Scope.hpp"
+#include "lace/tree/StaticVisitor.hpp"
+#include "lace/tree/SymbolTable.hpp"
 #include "lace/tree/Type.hpp"
-#include "lace/tree/Visitor.hpp"
 
 namespace lace {
 
-class NameAnalysis final : public Visitor {
+class NameAnalysis final : public StaticVisitor<NameAnalysis> {
     const Options& m_options;
     
     AST* m_ast = nullptr;
     AST::Context* m_context = nullptr;
-    const Scope* m_scope = nullptr;
+    SymbolTable m_symbols = {};
 
     /// Replace all deferred types composed in |type| and return the new,
     /// fully resolved type. If a part could not be resolved, then null is
@@ -28,14 +28,16 @@ class NameAnalysis final : public Visitor {
 public:
     NameAnalysis(const Options& options);
 
-    void visit(AST& ast) override;
+    using StaticVisitor::visit;
 
-    void visit(VariableDefn& node) override;
-    void visit(FunctionDefn& node) override;
-    void visit(FieldDefn& node) override;
-    void visit(VariantDefn& node) override;
-    void visit(StructDefn& node) override;
-    void visit(EnumDefn& node) override;
+    void visit(AST& ast);
+
+    void visit(VariableDefn& node);
+    void visit(FunctionDefn& node);
+    void visit(FieldDefn& node);
+    void visit(VariantDefn& node);
+    void visit(StructDefn& node);
+    void visit(EnumDefn& node);
 };
 
 } // namespace lace
@@ -12,6 +12,8 @@
 //  programming abilities in the language.
 //
 
+#include "lace/core/Arena.hpp"
+
 #include <cstdint>
 #include <vector>
 
@@ -23,7 +25,7 @@ class Rune;
 using Runes = std::vector<Rune*>;
 
 /// Represents a rune in the AST.
-class Rune final {
+class Rune final : public ArenaAllocated<Rune> {
 public:
     using Args = std::vector<Expr*>;
 
@@ -40,8 +42,8 @@ private:
 public:
     Rune(Kind kind, const Args& args) : m_kind(kind), m_args(args) {}
 
-    ~Rune();
-        
+    ~Rune() = default;
+
     Rune(const Rune&) = delete;
     void operator=(const Rune&) = delete;
 
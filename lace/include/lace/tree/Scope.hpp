@@ -13,8 +13,9 @@
 //  used during syntax tree analysis passes.
 //
 
-#include <string>
-#include <unordered_map>
+#include "lace/core/Arena.hpp"
+
+#include <vector>
 
 namespace lace {
 
@@ -23,14 +24,16 @@ class NamedDefn;
 /// Represents a node in a greater scope tree.
 ///
 /// Scopes make up a tree-like structure that is linked to the corresponding
-/// syntax tree, and contain a set of named symbols.
-class Scope final {
+/// syntax tree, and record the named definitions made in each of them. Names
+/// are looked up through a SymbolTable, which passes fill in from the scopes
+/// as they walk the tree.
+class Scope final : public ArenaAllocated<Scope> {
 public:
-    using DefnTable = std::unordered_map<std::string, NamedDefn*>;
+    using Defns = std::vector<NamedDefn*>;
 
 private:
     Scope* m_parent;
-    DefnTable m_defns = {};
+    Defns m_defns = {};
 
 public:
     Scope(Scope* parent = nullptr) : m_parent(parent) {}
@@ -48,15 +51,18 @@ public:
     /// Test if this scope has a parent scope.
     bool has_parent() const { return m_parent != nullptr; }
 
-    /// Add the given |defn| to this scope. 
-    /// 
-    /// If it conflicts name-wise with another definition, then this routine 
-    /// returns false. Otherwise, it returns true.
-    bool add(NamedDefn* defn);
+    /// Add the given |defn| to this scope. Checking that its name does not
+    /// conflict with another definition is left to the caller.
+    void add(NamedDefn* defn) { m_defns.push_back(defn); }
+
+    /// Add all of the given |defns| to this scope, as with add.
+    void add(const Defns& defns) {
+        m_defns.insert(m_defns.end(), defns.begin(), defns.end());
+    }
 
-    /// Returns the definition in this scope with the given |name|, and null 
-    /// if one does not exist.
-    NamedDefn* get(const std::string& name) const;
+    /// Returns the definitions made in this scope, in the order they were
+    /// added.
+    const Defns& get_defns() const { return m_defns; }
 };
 
 } // namespace lace
@@ -15,11 +15,11 @@
 #include "lace/core/Options.hpp"
 #include "lace/tree/Defn.hpp"
 #include "lace/tree/Expr.hpp"
-#include "lace/tree/Visitor.hpp"
+#include "lace/tree/StaticVisitor.hpp"
 
 namespace lace {
 
-class SemanticAnalysis final : public Visitor {
+class SemanticAnalysis final : public StaticVisitor<SemanticAnalysis> {
     /// The different kinds of loops.
     enum Loop : uint32_t {
         None = 0,
@@ -55,28 +55,30 @@ class SemanticAnalysis final : public Visitor {
 public:
     SemanticAnalysis(const Options& options);
 
-    void visit(AST& ast) override;
+    using StaticVisitor::visit;
 
-    void visit(VariableDefn& node) override;
-    void visit(FunctionDefn& node) override;
+    void visit(AST& ast);
+
+    void visit(VariableDefn& node);
+    void visit(FunctionDefn& node);
     
-    void visit(AdapterStmt& node) override;
-    void visit(BlockStmt& node) override;
-    void visit(IfStmt& node) override;
-    void visit(RestartStmt& node) override;
-    void visit(RetStmt& node) override;
-    void visit(StopStmt& node) override;
-    void visit(UntilStmt& node) override;
-
-    void visit(BinaryOp& node) override;
-    void visit(UnaryOp& node) override;
-
-    void visit(AccessExpr& node) override;
-    void visit(CallExpr& node) override;
-    void visit(CastExpr& node) override;
-    void visit(ParenExpr& node) override;
-    void visit(RefExpr& node) override;
-    void visit(SubscriptExpr& node) override;
+    void visit(AdapterStmt& node);
+    void visit(BlockStmt& node);
+    void visit(IfStmt& node);
+    void visit(RestartStmt& node);
+    void visit(RetStmt& node);
+    void visit(StopStmt& node);
+    void visit(UntilStmt& node);
+
+    void visit(BinaryOp& node);
+    void visit(UnaryOp& node);
+
+    void visit(AccessExpr& node);
+    void visit(CallExpr& node);
+    void visit(CastExpr& node);
+    void visit(ParenExpr& node);
+    void visit(RefExpr& node);
+    void visit(SubscriptExpr& node);
 };
 
 } // namespace lace
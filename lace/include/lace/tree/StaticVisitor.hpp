@@ -0,0 +1,172 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_STATIC_VISITOR_H_
+#define LOVELACE_STATIC_VISITOR_H_
+
+//
+//  This header file defines the StaticVisitor class, a visitor over the
+//  abstract syntax tree which dispatches on the kind of each node rather than
+//  through virtual calls, so that hot handlers can be inlined into the walk.
+//
+
+#include "lace/tree/AST.hpp"
+#include "lace/tree/Defn.hpp"
+#include "lace/tree/Expr.hpp"
+#include "lace/tree/Stmt.hpp"
+
+#include <cassert>
+
+namespace lace {
+
+/// Base class for visitors over the abstract syntax tree that are dispatched
+/// to statically, as the |Derived| class.
+///
+/// Nodes are visited by calling dispatch on them, which switches on their kind
+/// and calls the visit overload of |Derived| for it. The overloads here do
+/// nothing, so |Derived| only needs to define the ones it cares about, and
+/// should pull the rest in with `using StaticVisitor::visit`.
+template<typename Derived>
+class StaticVisitor {
+protected:
+    StaticVisitor() = default;
+
+    Derived& self() { return static_cast<Derived&>(*this); }
+
+public:
+    StaticVisitor(const StaticVisitor&) = delete;
+    void operator=(const StaticVisitor&) = delete;
+
+    StaticVisitor(StaticVisitor&&) noexcept = delete;
+    void operator=(StaticVisitor&&) noexcept = delete;
+
+    /// Visit the definition |node| as whichever kind of definition it is.
+    void dispatch(Defn& node) {
+        switch (node.get_kind()) {
+            case Defn::Alias:
+                return self().visit(static_cast<AliasDefn&>(node));
+            case Defn::Enum:
+                return self().visit(static_cast<EnumDefn&>(node));
+            case Defn::Field:
+                return self().visit(static_cast<FieldDefn&>(node));
+            case Defn::Function:
+                return self().visit(static_cast<FunctionDefn&>(node));
+            case Defn::Load:
+                return self().visit(static_cast<LoadDefn&>(node));
+            case Defn::Parameter:
+                return self().visit(static_cast<ParameterDefn&>(node));
+            case Defn::Struct:
+                return self().visit(static_cast<StructDefn&>(node));
+            case Defn::Variable:
+                return self().visit(static_cast<VariableDefn&>(node));
+            case Defn::Variant:
+                return self().visit(static_cast<VariantDefn&>(node));
+        }
+
+        assert(false && "unknown definition kind!");
+    }
+
+    /// Visit the statement |node| as whichever kind of statement it is.
+    void dispatch(Stmt& node) {
+        switch (node.get_kind()) {
+            case Stmt::Adapter:
+                return self().visit(static_cast<AdapterStmt&>(node));
+            case Stmt::Block:
+                return self().visit(static_cast<BlockStmt&>(node));
+            case Stmt::If:
+                return self().visit(static_cast<IfStmt&>(node));
+            case Stmt::Restart:
+                return self().visit(static_cast<RestartStmt&>(node));
+            case Stmt::Ret:
+                return self().visit(static_cast<RetStmt&>(node));
+            case Stmt::Stop:
+                return self().visit(static_cast<StopStmt&>(node));
+            case Stmt::Until:
+                return self().visit(static_cast<UntilStmt&>(node));
+        }
+
+        assert(false && "unknown statement kind!");
+    }
+
+    /// Visit the expression |node| as whichever kind of expression it is.
+    void dispatch(Expr& node) {
+        switch (node.get_kind()) {
+            case Expr::Bool:
+                return self().visit(static_cast<BoolLiteral&>(node));
+            case Expr::Char:
+                return self().visit(static_cast<CharLiteral&>(node));
+            case Expr::Integer:
+                return self().visit(static_cast<IntegerLiteral&>(node));
+            case Expr::Float:
+                return self().visit(static_cast<FloatLiteral&>(node));
+            case Expr::Null:
+                return self().visit(static_cast<NullLiteral&>(node));
+            case Expr::String:
+                return self().visit(static_cast<StringLiteral&>(node));
+            case Expr::Binary:
+                return self().visit(static_cast<BinaryOp&>(node));
+            case Expr::Unary:
+                return self().visit(static_cast<UnaryOp&>(node));
+            case Expr::Access:
+                return self().visit(static_cast<AccessExpr&>(node));
+            case Expr::Call:
+                return self().visit(static_cast<CallExpr&>(node));
+            case Expr::Cast:
+                return self().visit(static_cast<CastExpr&>(node));
+            case Expr::Paren:
+                return self().visit(static_cast<ParenExpr&>(node));
+            case Expr::Ref:
+                return self().visit(static_cast<RefExpr&>(node));
+            case Expr::Sizeof:
+                return self().visit(static_cast<SizeofExpr&>(node));
+            case Expr::Subscript:
+                return self().visit(static_cast<SubscriptExpr&>(node));
+        }
+
+        assert(false && "unknown expression kind!");
+    }
+
+    void visit(AST&) {}
+
+    void visit(AliasDefn&) {}
+    void visit(EnumDefn&) {}
+    void visit(FieldDefn&) {}
+    void visit(FunctionDefn&) {}
+    void visit(LoadDefn&) {}
+    void visit(ParameterDefn&) {}
+    void visit(StructDefn&) {}
+    void visit(VariableDefn&) {}
+    void visit(VariantDefn&) {}
+
+    void visit(AdapterStmt&) {}
+    void visit(BlockStmt&) {}
+    void visit(IfStmt&) {}
+    void visit(RestartStmt&) {}
+    void visit(RetStmt&) {}
+    void visit(StopStmt&) {}
+    void visit(UntilStmt&) {}
+
+    void visit(BoolLiteral&) {}
+    void visit(CharLiteral&) {}
+    void visit(IntegerLiteral&) {}
+    void visit(FloatLiteral&) {}
+    void visit(NullLiteral&) {}
+    void visit(StringLiteral&) {}
+
+    void visit(BinaryOp&) {}
+    void visit(UnaryOp&) {}
+
+    void visit(AccessExpr&) {}
+    void visit(CallExpr&) {}
+    void visit(CastExpr&) {}
+    void visit(SizeofExpr&) {}
+    void visit(SubscriptExpr&) {}
+    void visit(ParenExpr&) {}
+    void visit(RefExpr&) {}
+};
+
+} // namespace lace
+
+#endif // LOVELACE_STATIC_VISITOR_H_
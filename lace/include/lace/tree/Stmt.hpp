@@ -11,6 +11,7 @@
 //  statements in the abstract syntax tree.
 //
 
+#include "lace/core/Arena.hpp"
 #include "lace/tree/AST.hpp"
 #include "lace/tree/Visitor.hpp"
 #include "lace/types/SourceSpan.hpp"
@@ -24,7 +25,7 @@ class Expr;
 class Scope;
 
 /// Base class for all statement nodes in the abstract syntax tree.
-class Stmt {
+class Stmt : public ArenaAllocated<Stmt> {
 public:
     /// The different kinds of statements.
     enum Kind : uint32_t {
@@ -216,7 +217,7 @@ public:
     [[nodiscard]]
     static AdapterStmt* create(AST::Context& ctx, Expr* expr);
 
-    ~AdapterStmt() override;
+    ~AdapterStmt() = default;
 
     AdapterStmt(const AdapterStmt&) = delete;
     void operator=(const AdapterStmt&) = delete;
@@ -260,7 +261,7 @@ public:
     static BlockStmt* create(AST::Context& ctx, SourceSpan span, Scope* scope,
                              const Stmts& stmts);
 
-    ~BlockStmt() override;
+    ~BlockStmt() = default;
 
     BlockStmt(const BlockStmt&) = delete;
     void operator=(const BlockStmt&) = delete;
@@ -305,7 +306,7 @@ public:
     static IfStmt* create(AST::Context& ctx, SourceSpan span, Expr* cond, 
                           Stmt* then, Stmt* els);
 
-    ~IfStmt() override;
+    ~IfStmt() = default;
 
     IfStmt(const IfStmt&) = delete;
     void operator=(const IfStmt&) = delete;
@@ -360,7 +361,7 @@ public:
     [[nodiscard]]
     static RetStmt* create(AST::Context& ctx, SourceSpan span, Expr* expr);
 
-    ~RetStmt() override;
+    ~RetStmt() = default;
 
     RetStmt(const RetStmt&) = delete;
     void operator=(const RetStmt&) = delete;
@@ -408,7 +409,7 @@ public:
     static UntilStmt* create(AST::Context& ctx, SourceSpan span, Expr* cond, 
                              Stmt* body);
 
-    ~UntilStmt() override;
+    ~UntilStmt() = default;
 
     UntilStmt(const UntilStmt&) = delete;
     void operator=(const UntilStmt&) = delete;
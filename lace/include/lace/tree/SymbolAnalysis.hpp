@@ -13,18 +13,18 @@
 //
 
 #include "lace/core/Options.hpp"
-#include "lace/tree/Scope.hpp"
+#include "lace/tree/StaticVisitor.hpp"
+#include "lace/tree/SymbolTable.hpp"
 #include "lace/tree/Type.hpp"
-#include "lace/tree/Visitor.hpp"
 
 namespace lace {
 
-class SymbolAnalysis final : public Visitor {
+class SymbolAnalysis final : public StaticVisitor<SymbolAnalysis> {
     const Options& m_options;
     
     AST* m_ast = nullptr;
     AST::Context* m_context = nullptr;
-    const Scope* m_scope = nullptr;
+    SymbolTable m_symbols = {};
 
     /// Replace all deferred types composed in |type| and return the new,
     /// fully resolved type. If a part could not be resolved, then null is
@@ -34,28 +34,30 @@ class SymbolAnalysis final : public Visitor {
 public:
     SymbolAnalysis(const Options& options);
 
-    void visit(AST& ast) override;
+    using StaticVisitor::visit;
 
-    void visit(VariableDefn& node) override;
-    void visit(FunctionDefn& node) override;
-    void visit(StructDefn& node) override;
+    void visit(AST& ast);
 
-    void visit(AdapterStmt& node) override;
-    void visit(BlockStmt& node) override;
-    void visit(IfStmt& node) override;
-    void visit(RetStmt& node) override;
-    void visit(UntilStmt& node) override;
+    void visit(VariableDefn& node);
+    void visit(FunctionDefn& node);
+    void visit(StructDefn& node);
+
+    void visit(AdapterStmt& node);
+    void visit(BlockStmt& node);
+    void visit(IfStmt& node);
+    void visit(RetStmt& node);
+    void visit(UntilStmt& node);
     
-    void visit(BinaryOp& node) override;
-    void visit(UnaryOp& node) override;
-
-    void visit(AccessExpr& node) override;
-    void visit(CallExpr& node) override;
-    void visit(CastExpr& node) override;
-    void visit(ParenExpr& node) override;
-    void visit(RefExpr& node) override;
-    void visit(SizeofExpr& node) override;
-    void visit(SubscriptExpr& node) override;
+    void visit(BinaryOp& node);
+    void visit(UnaryOp& node);
+
+    void visit(AccessExpr& node);
+    void visit(CallExpr& node);
+    void visit(CastExpr& node);
+    void visit(ParenExpr& node);
+    void visit(RefExpr& node);
+    void visit(SizeofExpr& node);
+    void visit(SubscriptExpr& node);
 };
 
 } // namespace lace
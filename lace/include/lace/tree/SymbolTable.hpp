@@ -0,0 +1,85 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_SYMBOL_TABLE_H_
+#define LOVELACE_SYMBOL_TABLE_H_
+
+//
+//  This header file declares the SymbolTable class, a flat table of the named
+//  definitions visible at some point in a syntax tree, which is kept up to
+//  date as passes enter and exit scopes.
+//
+
+#include "lace/core/Symbol.hpp"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace lace {
+
+class NamedDefn;
+class Scope;
+
+/// A table of the named definitions visible from the current scope.
+///
+/// Rather than probing a table for each scope out to the root, all scopes 
+/// share one table mapping names to a stack of their definitions, innermost
+/// last. Entering a scope pushes onto those stacks and exiting it pops them,
+/// so looking up a name is one probe no matter how deep the scope is.
+class SymbolTable final {
+    /// A definition visible under some name.
+    struct Entry final {
+        /// The depth of the scope the definition is in.
+        uint32_t depth;
+        NamedDefn* defn;
+    };
+
+    using Entries = std::vector<Entry>;
+
+    std::unordered_map<Symbol, Entries> m_table = {};
+
+    /// The names added to the table, in the order they were added.
+    std::vector<Symbol> m_added = {};
+
+    /// For each open scope, the number of names added before it was entered.
+    std::vector<uint32_t> m_marks = {};
+
+public:
+    SymbolTable() = default;
+
+    SymbolTable(const SymbolTable&) = delete;
+    void operator=(const SymbolTable&) = delete;
+
+    /// Returns the depth of the current scope, where the outermost scope is 
+    /// at depth zero.
+    uint32_t depth() const { return m_marks.size(); }
+
+    /// Enter a new, empty scope.
+    void enter() { m_marks.push_back(m_added.size()); }
+
+    /// Enter a new scope with every definition in |scope|.
+    void enter(const Scope* scope);
+
+    /// Exit the current scope, dropping every definition added since it was
+    /// entered.
+    void exit();
+
+    /// Add |defn| to the current scope. It shadows any other definition of
+    /// the same name until the scope is exited.
+    void add(NamedDefn* defn);
+
+    /// Returns the innermost definition named |name|, and null if there is
+    /// none visible.
+    NamedDefn* get(Symbol name) const;
+
+    /// Returns the definition named |name| in the current scope, and null if
+    /// the current scope does not have one.
+    NamedDefn* get_local(Symbol name) const;
+};
+
+} // namespace lace
+
+#endif // LOVELACE_SYMBOL_TABLE_H_
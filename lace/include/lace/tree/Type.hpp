@@ -11,10 +11,13 @@
 //  types in the language type system.
 //
 
+#include "lace/core/Arena.hpp"
 #include "lace/tree/AST.hpp"
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -49,7 +52,8 @@ public:
     const Type& operator*() const { return *m_type; }
     const Type* operator->() const { return m_type; }
 
-    /// Compare this type with |other| for type equality.
+    /// Compare this type with |other| for type equality, not counting any
+    /// qualifiers.
     bool compare(const QualType& other) const;
 
     /// Test if this type can be casted to |other|. The |implicitly| flag
@@ -59,6 +63,13 @@ public:
     void set_type(const Type* type) const { m_type = type; }
     const Type* get_type() const { return m_type; }
 
+    /// Returns the canonical form of this type, without any qualifiers.
+    QualType get_canonical() const;
+
+    /// Test if this type is in canonical form, i.e. it has no qualifiers and
+    /// neither do any of the types it is composed of.
+    bool is_canonical() const;
+
     void set_qualifiers(uint32_t quals) { m_quals = quals; }
     const uint32_t& get_qualifiers() const { return m_quals; }
     uint32_t& get_qualifiers() { return m_quals; }
@@ -80,7 +91,7 @@ public:
 };
 
 /// Base class for all type nodes used in the abstract syntax tree (AST).
-class Type {
+class Type : public ArenaAllocated<Type> {
 public:
     /// The different type classes.
     enum Class : uint32_t {
@@ -98,7 +109,16 @@ protected:
     /// The class of this type.
     const Class m_class;
 
-    Type(Class cls) : m_class(cls) {}
+    /// The context that owns this type.
+    const AST::Context* m_context;
+
+    /// The canonical form of this type, which is the same type but with every
+    /// qualifier on the types it is composed of dropped. Within a context, 
+    /// types are uniqued, so two types are equal just when they share the 
+    /// same canonical type.
+    const Type* m_canonical = this;
+
+    Type(const AST::Context& ctx, Class cls) : m_class(cls), m_context(&ctx) {}
 
 public:
     virtual ~Type() = default;
@@ -106,7 +126,11 @@ public:
     /// Returns the string equivelant of this type.
     virtual std::string to_string() const = 0;
 
-    /// Compare this type with |other| for type equality.
+    /// Compare this type with |other| for type equality by their structure.
+    ///
+    /// QualType::compare only falls back on this for types whose canonical 
+    /// types differ, which may still be equal if they are made of types owned
+    /// by different contexts.
     virtual bool compare(const Type* other) const { return false; }
 
     /// Returns true if this type can be casted to |other|. The |implicitly|
@@ -128,6 +152,12 @@ public:
     virtual bool is_floating_point() const { return false; }
 
     Class get_class() const { return m_class; }
+
+    /// Returns the context that owns this type.
+    const AST::Context* get_context() const { return m_context; }
+
+    /// Returns the canonical form of this type.
+    const Type* get_canonical() const { return m_canonical; }
  
     /// Test if this is an alias type.
     bool is_alias() const { return m_class == Alias; }
@@ -167,13 +197,14 @@ private:
     /// The definition that defines this type.
     mutable const AliasDefn* m_defn;
 
-    AliasType(const QualType& underlying, const AliasDefn* defn) 
-      : Type(Type::Alias), m_underlying(underlying), m_defn(defn) {}
+    AliasType(const AST::Context& ctx, const QualType& underlying, 
+              const AliasDefn* defn) 
+      : Type(ctx, Type::Alias), m_underlying(underlying), m_defn(defn) {}
 
 public:
     static AliasType* create(AST::Context& ctx, const QualType& underlying,
                              const AliasDefn* defn);
-    static AliasType* get(AST::Context& ctx, const std::string& name);
+    static AliasType* get(AST::Context& ctx, Symbol name);
 
     std::string to_string() const override;
 
@@ -197,8 +228,8 @@ class ArrayType final : public Type {
     QualType m_element;
     const uint32_t m_size;
 
-    ArrayType(const QualType& element, uint32_t size)
-      : Type(Type::Array), m_element(element), m_size(size) {}
+    ArrayType(const AST::Context& ctx, const QualType& element, uint32_t size)
+      : Type(ctx, Type::Array), m_element(element), m_size(size) {}
 
 public:
     static ArrayType* get(AST::Context& ctx, const QualType& element, 
@@ -244,7 +275,8 @@ private:
     // The kind of built-in type this is.
     const Kind m_kind;
 
-    BuiltinType(Kind kind) : Type(Type::Builtin), m_kind(kind) {}
+    BuiltinType(const AST::Context& ctx, Kind kind) 
+      : Type(ctx, Type::Builtin), m_kind(kind) {}
 
 public:
     static BuiltinType* get(AST::Context& ctx, Kind kind);
@@ -278,17 +310,20 @@ public:
 class DeferredType final : public Type {
     friend class AST::Context;
 
-    const std::string m_name;
+    const Symbol m_name;
 
-    DeferredType(const std::string& name) 
-      : Type(Type::Deferred), m_name(name) {}
+    DeferredType(const AST::Context& ctx, Symbol name) 
+      : Type(ctx, Type::Deferred), m_name(name) {}
 
 public:
-    static DeferredType* get(AST::Context& ctx, const std::string& name);
+    static DeferredType* get(AST::Context& ctx, Symbol name);
 
-    std::string to_string() const override { return "'" + m_name + "'"; }
+    std::string to_string() const override { 
+        return "'" + m_name.str() + "'"; 
+    }
 
-    const std::string& get_name() const { return m_name; }
+    const std::string& get_name() const { return m_name.str(); }
+    Symbol get_symbol() const { return m_name; }
 };
 
 /// Represents named types defined by an enum definition.
@@ -300,13 +335,14 @@ class EnumType final : public Type {
     /// The definition that defines this type.
     mutable const EnumDefn* m_defn;
 
-    EnumType(const QualType& underlying, const EnumDefn* defn) 
-      : Type(Type::Enum), m_underlying(underlying), m_defn(defn) {}
+    EnumType(const AST::Context& ctx, const QualType& underlying, 
+             const EnumDefn* defn) 
+      : Type(ctx, Type::Enum), m_underlying(underlying), m_defn(defn) {}
 
 public:
     static EnumType* create(AST::Context& ctx, const QualType& underlying, 
                             const EnumDefn* defn);
-    static EnumType* get(AST::Context& ctx, const std::string& name);
+    static EnumType* get(AST::Context& ctx, Symbol name);
 
     std::string to_string() const override;
 
@@ -335,8 +371,9 @@ private:
     QualType m_ret;
     Params m_params;
 
-    FunctionType(const QualType& ret, const Params& params)
-      : Type(Type::Function), m_ret(ret), m_params(params) {}
+    FunctionType(const AST::Context& ctx, const QualType& ret, 
+                 const Params& params)
+      : Type(ctx, Type::Function), m_ret(ret), m_params(params) {}
 
 public:
     static FunctionType* get(AST::Context& ctx, const QualType& ret, 
@@ -377,8 +414,8 @@ class PointerType final : public Type {
 
     QualType m_pointee;
 
-    PointerType(const QualType& pointee) 
-      : Type(Type::Pointer), m_pointee(pointee) {}
+    PointerType(const AST::Context& ctx, const QualType& pointee) 
+      : Type(ctx, Type::Pointer), m_pointee(pointee) {}
 
 public:
     static PointerType* get(AST::Context& ctx, const QualType& pointee);
@@ -402,11 +439,12 @@ class StructType final : public Type {
     /// The definition that defines this type.
     mutable const StructDefn* m_defn;
 
-    StructType(const StructDefn* defn) : Type(Type::Struct), m_defn(defn) {}
+    StructType(const AST::Context& ctx, const StructDefn* defn) 
+      : Type(ctx, Type::Struct), m_defn(defn) {}
 
 public:
     static StructType* create(AST::Context& ctx, const StructDefn* defn);
-    static StructType* get(AST::Context& ctx, const std::string& name);    
+    static StructType* get(AST::Context& ctx, Symbol name);    
 
     std::string to_string() const override;
 
@@ -420,4 +458,12 @@ public:
 
 } // namespace lace
 
+template<>
+struct std::hash<lace::QualType> {
+    std::size_t operator()(const lace::QualType& type) const noexcept {
+        return std::hash<const lace::Type*>()(type.get_type()) 
+            ^ type.get_qualifiers();
+    }
+};
+
 #endif // LOVELACE_TYPE_H_
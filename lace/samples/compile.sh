@@ -1,7 +1,6 @@
 #!/bin/bash
 
 cd /home/lovelace/lace
-./lace samples/linux.lace samples/A.lace samples/mem.lace
+./lace samples/linux.lace samples/A.lace samples/mem.lace -rt samples/rt.o -o samples/main
 cd samples/
-ld rt.o linux.lace.o A.lace.o mem.lace.o -o main
 ./main
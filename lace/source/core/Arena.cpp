@@ -0,0 +1,36 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/core/Arena.hpp"
+
+#include <cstdlib>
+#include <new>
+
+using namespace lace;
+
+Arena::~Arena() {
+    // Objects may still refer to each other in their destructors, so they are
+    // destroyed before any memory is given back.
+    for (auto it = m_cleanups.rbegin(); it != m_cleanups.rend(); ++it)
+        it->dtor(it->ptr);
+
+    for (char* slab : m_slabs)
+        std::free(slab);
+
+    m_cleanups.clear();
+    m_slabs.clear();
+}
+
+void Arena::grow(size_t size, size_t align) {
+    const size_t capacity = size + align > SlabSize ? size + align : SlabSize;
+
+    char* slab = static_cast<char*>(std::malloc(capacity));
+    if (!slab)
+        throw std::bad_alloc();
+
+    m_slabs.push_back(slab);
+    m_ptr = slab;
+    m_end = slab + capacity;
+}
@@ -4,80 +4,169 @@
 //
 
 #include "lace/core/Diagnostics.hpp"
-#include "lace/tools/Files.hpp"
+#include "lace/tools/SourceManager.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <mutex>
+#include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace lace;
 using namespace lace::log;
 
-static std::ostream* g_out = nullptr;
+namespace {
+
+/// A diagnostic that has been logged, but not yet written out.
+struct Record final {
+    /// The file that the diagnostic belongs to, if any.
+    std::string path;
+
+    /// The position of the diagnostic in its file, or zero if it has none.
+    uint32_t line = 0;
+    uint32_t col = 0;
+
+    /// The order in which this diagnostic was logged, across all threads.
+    uint64_t seq = 0;
+
+    std::string text;
+};
+
+/// The diagnostics logged by a single thread since the last flush.
+struct Buffer final {
+    std::vector<Record> records = {};
+    std::mutex mutex;
+};
+
+} // namespace
+
+static std::atomic<std::ostream*> g_out = nullptr;
 static std::mutex g_mutex;
-static bool g_color = false;
-static bool g_errors = false;
+static std::atomic<bool> g_color = false;
+static std::atomic<bool> g_errors = false;
+static std::atomic<uint64_t> g_seq = 0;
+
+/// The hook to run before a fatal error stops the compiler, guarded by 
+/// |g_mutex|.
+static std::function<void()> g_fatal_hook = nullptr;
+
+/// The buffers of every thread that has logged something. Buffers outlive
+/// their threads, so that nothing logged by a finished job is lost.
+static std::vector<std::shared_ptr<Buffer>> g_buffers = {};
+
+/// The sources to render spans from, and the manager to fall back to if the
+/// compiler has not provided one.
+static std::atomic<SourceManager*> g_sources = nullptr;
+static SourceManager g_own_sources = {};
+
+static thread_local std::shared_ptr<Buffer> t_buffer = nullptr;
+static thread_local std::string t_context = "";
 
 /// Reassess whether colors should be used for the current output stream.
 static void adjust_color_compatibility() {
-    g_color = (g_out == &std::cout || g_out == &std::cerr);
+    std::ostream* out = g_out.load();
+    g_color = (out == &std::cout || out == &std::cerr);
 }
 
-/// Read in the lines of source code that |span| covers from the source file
-/// at |path|.
-static std::vector<std::string> read_source(const Span& span) {
+/// Print the lines of source code that |span| covers from the source file at
+/// |path| to |os|.
+static void print_source(std::ostream& os, const Span& span) {
     assert(span.end.line >= span.start.line && "span ends before it starts!");
-    
-    const std::string contents = read_file(span.path);
-    std::size_t line = 1, start = 0;
-    std::vector<std::string> lines = {};
-    lines.reserve(std::min(1, span.end.line - span.start.line + 1));
-
-    for (std::size_t i = 0, e = contents.size(); i <= e; ++i) {
-        if (i == e || contents[i] == '\n') {
-            if (span.start.line <= line && line <= span.end.line)
-                lines.push_back(contents.substr(start, i - start));
-
-            start = i + 1;
-            ++line;
-        }
-    }
 
-    return lines;
-}
+    SourceManager* sources = g_sources.load();
+    const SourceBuffer& buffer = (sources ? *sources : g_own_sources)
+        .load(span.path);
 
-/// Print the lines of source code that |span| covers from the source file at
-/// |path|.
-static void print_source(const Span& span) {
     const uint32_t line_len = std::to_string(span.start.line).size();
-    const std::vector<std::string> lines = read_source(span);
-    uint32_t line_n = span.start.line;
+    const uint32_t last = std::min<uint32_t>(span.end.line, 
+        buffer.num_lines());
+
+    os << std::string(line_len + 2, ' ') << "┌─[" << span.path << ':'
+       << span.start.line << "]\n";
 
-    *g_out << std::string(line_len + 2, ' ') << "┌─[" << span.path << ':'
-           << span.start.line << "]\n";
+    for (uint32_t line_n = span.start.line; line_n <= last; ++line_n) {
+        const std::string_view line = buffer.get_line(line_n);
 
-    for (const std::string& line : lines) {
         if (g_color) {
             std::string line_str = std::to_string(line_n);
 
-            *g_out << "\e[38;5;240m" << line_str << "\033[0m" 
-                   << std::string(line_len + 2 - line_str.length(), ' ') 
-                   << "│ " << line << '\n';
+            os << "\e[38;5;240m" << line_str << "\033[0m" 
+               << std::string(line_len + 2 - line_str.length(), ' ') 
+               << "│ " << line << '\n';
         } else {
-            *g_out << line_n << ' ' << line << '\n';
+            os << line_n << ' ' << line << '\n';
         }
+    }
+
+    os << std::string(line_len + 2, ' ') << "╰──\n";
+}
 
-        ++line_n;
+/// Add the rendered diagnostic |text| to the buffer of the calling thread.
+/// Diagnostics without a |path| are attributed to the current context, if
+/// there is one.
+static void emit(std::string path, uint32_t line, uint32_t col, 
+                 std::string text) {
+    if (!t_buffer) {
+        t_buffer = std::make_shared<Buffer>();
+
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_buffers.push_back(t_buffer);
     }
 
-    *g_out << std::string(line_len + 2, ' ') << "╰──\n";
+    if (path.empty())
+        path = t_context;
+
+    std::lock_guard<std::mutex> lock(t_buffer->mutex);
+    t_buffer->records.push_back({ std::move(path), line, col, 
+        g_seq.fetch_add(1, std::memory_order_relaxed), std::move(text) });
+}
+
+/// Write out the diagnostics of every thread, merged in a stable order. 
+/// Assumes that |g_mutex| is held.
+static void drain() {
+    std::vector<Record> records = {};
+    for (const std::shared_ptr<Buffer>& buffer : g_buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        std::move(buffer->records.begin(), buffer->records.end(), 
+            std::back_inserter(records));
+        buffer->records.clear();
+    }
+
+    std::sort(records.begin(), records.end(), 
+        [](const Record& a, const Record& b) {
+            if (a.path != b.path)
+                return a.path < b.path;
+            if (a.line != b.line)
+                return a.line < b.line;
+            if (a.col != b.col)
+                return a.col < b.col;
+
+            return a.seq < b.seq;
+        });
+
+    std::ostream* out = g_out.load();
+    if (!out)
+        return;
+
+    for (const Record& record : records)
+        *out << record.text;
 }
 
 void log::init(std::ostream& os) {
     set_output_stream(os);
 }
 
+void log::set_source_manager(SourceManager& sources) {
+    g_sources = &sources;
+}
+
 void log::set_output_stream(std::ostream& os) {
     std::lock_guard<std::mutex> lock(g_mutex);
     g_out = &os;
@@ -90,135 +179,174 @@ void log::clear_output_stream() {
 }
 
 void log::flush() {
-    std::lock_guard<std::mutex> lock(g_mutex);
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        drain();
+    }
 
-    if (g_errors) {
+    // The lock must be released first, since fatal takes it as well.
+    if (g_errors)
         log::fatal("unrecoverable errors found, stopping");
-        std::exit(1);
-    }
 
-    if (g_out)
-        g_out->flush();
+    if (std::ostream* out = g_out.load())
+        out->flush();
 }
 
-void log::note(const std::string& msg) {
+bool log::has_errors() {
+    return g_errors;
+}
+
+void log::set_fatal_hook(std::function<void()> hook) {
     std::lock_guard<std::mutex> lock(g_mutex);
+    g_fatal_hook = std::move(hook);
+}
+
+Context::Context(const std::string& path) : m_prev(t_context) {
+    t_context = path;
+}
+
+Context::~Context() {
+    t_context = std::move(m_prev);
+}
 
+void log::note(const std::string& msg) {
     if (!g_out)
         return;
 
-    *g_out << (g_color ? "\033[1;35mnote:\033[0m " : "note: ") << msg << '\n';
+    std::ostringstream os;
+    os << (g_color ? "\033[1;35mnote:\033[0m " : "note: ") << msg << '\n';
+    emit("", 0, 0, os.str());
 }
 
 void log::note(const std::string& msg, const Location& loc) {
-    std::lock_guard<std::mutex> lock(g_mutex);
-
     if (!g_out)
         return;
 
-    *g_out << loc.path << ':' << loc.line << ':' << loc.col << ':'
-           << (g_color ? " \033[1;35mnote:\033[0m " : " note: ") << msg << '\n';
+    std::ostringstream os;
+    os << loc.path << ':' << loc.line << ':' << loc.col << ':'
+       << (g_color ? " \033[1;35mnote:\033[0m " : " note: ") << msg << '\n';
+    emit(loc.path, loc.line, loc.col, os.str());
 }
 
 void log::note(const std::string& msg, const Span& span) {
-    std::lock_guard<std::mutex> lock(g_mutex);
-
     if (!g_out)
         return;
 
-    *g_out << (g_color ? "\033[1;35m ! \033[0m" : " ! ") << msg << '\n';
-    print_source(span);
+    std::ostringstream os;
+    os << (g_color ? "\033[1;35m ! \033[0m" : " ! ") << msg << '\n';
+    print_source(os, span);
+    emit(span.path, span.start.line, span.start.col, os.str());
 }
 
 void log::warn(const std::string& msg) {
-    std::lock_guard<std::mutex> lock(g_mutex);
-
     if (!g_out)
         return;
 
-    *g_out << (g_color ? "\033[1;33mwarning:\033[0m " : "warning: ") << msg 
-           << '\n';
+    std::ostringstream os;
+    os << (g_color ? "\033[1;33mwarning:\033[0m " : "warning: ") << msg 
+       << '\n';
+    emit("", 0, 0, os.str());
 }
 
 void log::warn(const std::string& msg, const Location& loc) {
-    std::lock_guard<std::mutex> lock(g_mutex);
-
     if (!g_out)
         return;
 
-    *g_out << loc.path << ':' << loc.line << ':' << loc.col << ':'
-           << (g_color ? " \033[1;33mwarning:\033[0m " : " warning: ") << msg 
-           << '\n';
+    std::ostringstream os;
+    os << loc.path << ':' << loc.line << ':' << loc.col << ':'
+       << (g_color ? " \033[1;33mwarning:\033[0m " : " warning: ") << msg 
+       << '\n';
+    emit(loc.path, loc.line, loc.col, os.str());
 }
 
 void log::warn(const std::string& msg, const Span& span) {
-    std::lock_guard<std::mutex> lock(g_mutex);
-
     if (!g_out)
         return;
 
-    *g_out << (g_color ? "\033[33m * \033[0m" : " * ") << msg << '\n';
-    print_source(span);
+    std::ostringstream os;
+    os << (g_color ? "\033[33m * \033[0m" : " * ") << msg << '\n';
+    print_source(os, span);
+    emit(span.path, span.start.line, span.start.col, os.str());
 }
 
 void log::error(const std::string& msg) {
-    std::lock_guard<std::mutex> lock(g_mutex);
+    g_errors = true;
 
-    if (g_out) {
-        *g_out << (g_color ? "\033[1;31merror:\033[0m " : "error: ") << msg 
-               << '\n';
-    }
+    if (!g_out)
+        return;
 
-    g_errors = true;
+    std::ostringstream os;
+    os << (g_color ? "\033[1;31merror:\033[0m " : "error: ") << msg << '\n';
+    emit("", 0, 0, os.str());
 }
 
 void log::error(const std::string& msg, const Location& loc) {
-    std::lock_guard<std::mutex> lock(g_mutex);
+    g_errors = true;
 
-    if (g_out) {
-        *g_out << loc.path << ':' << loc.line << ':' << loc.col << ':'
-               << (g_color ? " \033[1;31merror:\033[0m " : " error: ") << msg 
-               << '\n';
-    }
+    if (!g_out)
+        return;
 
-    g_errors = true;
+    std::ostringstream os;
+    os << loc.path << ':' << loc.line << ':' << loc.col << ':'
+       << (g_color ? " \033[1;31merror:\033[0m " : " error: ") << msg 
+       << '\n';
+    emit(loc.path, loc.line, loc.col, os.str());
 }
 
 void log::error(const std::string& msg, const Span& span) {
-    std::lock_guard<std::mutex> lock(g_mutex);
+    g_errors = true;
 
-    if (g_out) {
-        *g_out << (g_color ? "\033[1;31m x \033[0m" : " x ") << msg << '\n';
-        print_source(span);
-    }
+    if (!g_out)
+        return;
 
-    g_errors = true;
+    std::ostringstream os;
+    os << (g_color ? "\033[1;31m x \033[0m" : " x ") << msg << '\n';
+    print_source(os, span);
+    emit(span.path, span.start.line, span.start.col, os.str());
 }
 
-void log::fatal(const std::string& msg) {
-    std::lock_guard<std::mutex> lock(g_mutex);
-
-    if (g_out) {
-        *g_out << (g_color ? "\033[1;31mfatal:\033[0m " : "fatal: ") << msg 
-               << '\n';
+/// Run the fatal hook, if there is one, then write out any pending diagnostics
+/// and |text|, and stop the compiler.
+[[noreturn]] static void stop(const std::string& text) {
+    std::function<void()> hook = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        hook = std::exchange(g_fatal_hook, nullptr);
     }
 
-    std::exit(1);
-}
+    // The hook is taken out first so that it runs only once, even if it
+    // fails itself, and is run without the lock since it may log as well.
+    if (hook)
+        hook();
 
-void log::fatal(const std::string& msg, const Location& loc) {
     std::lock_guard<std::mutex> lock(g_mutex);
+    drain();
 
-    if (g_out) {
-        *g_out << loc.path << ':' << loc.line << ':' << loc.col << ':'
-               << (g_color ? " \033[1;31mfatal:\033[0m " : " fatal: ") << msg 
-               << '\n';
+    if (std::ostream* out = g_out.load()) {
+        *out << text;
+        out->flush();
     }
 
     std::exit(1);
 }
 
+void log::fatal(const std::string& msg) {
+    std::ostringstream os;
+    os << (g_color ? "\033[1;31mfatal:\033[0m " : "fatal: ") << msg << '\n';
+    stop(os.str());
+}
+
+void log::fatal(const std::string& msg, const Location& loc) {
+    std::ostringstream os;
+    os << loc.path << ':' << loc.line << ':' << loc.col << ':'
+       << (g_color ? " \033[1;31mfatal:\033[0m " : " fatal: ") << msg 
+       << '\n';
+    stop(os.str());
+}
+
 void log::fatal(const std::string& msg, const Span& span) {
-    error(msg, span); // Functionally identical to what we want here.
-    std::exit(1);
+    std::ostringstream os;
+    os << (g_color ? "\033[1;31m x \033[0m" : " x ") << msg << '\n';
+    print_source(os, span);
+    stop(os.str());
 }
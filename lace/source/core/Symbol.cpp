@@ -0,0 +1,104 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/core/Symbol.hpp"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <unordered_map>
+
+using namespace lace;
+
+namespace {
+
+/// The table of interned strings.
+///
+/// Strings are stored in fixed-size chunks that never move once allocated,
+/// so that a symbol can be resolved to its string without taking a lock. The
+/// lookup from string to id is split into shards, each with its own lock, so
+/// that parsing jobs rarely contend with each other.
+class Interner final {
+    static constexpr uint32_t ChunkBits = 12;
+    static constexpr uint32_t ChunkSize = 1 << ChunkBits;
+    static constexpr uint32_t NumChunks = 1 << 12;
+    static constexpr uint32_t NumShards = 16;
+
+    struct Shard final {
+        std::unordered_map<std::string_view, uint32_t> ids = {};
+        std::mutex mutex;
+    };
+
+    std::array<Shard, NumShards> m_shards = {};
+    std::array<std::atomic<std::string*>, NumChunks> m_chunks = {};
+    std::atomic<uint32_t> m_next = 1;
+    std::mutex m_chunk_mutex;
+
+    /// Returns the slot for the string of |id|, allocating its chunk if
+    /// needed.
+    std::string& get_slot(uint32_t id) {
+        const uint32_t chunk = id >> ChunkBits;
+        assert(chunk < NumChunks && "too many symbols interned!");
+
+        std::string* strings = m_chunks[chunk].load(std::memory_order_acquire);
+        if (!strings) {
+            std::lock_guard<std::mutex> lock(m_chunk_mutex);
+            strings = m_chunks[chunk].load(std::memory_order_acquire);
+            if (!strings) {
+                strings = new std::string[ChunkSize];
+                m_chunks[chunk].store(strings, std::memory_order_release);
+            }
+        }
+
+        return strings[id & (ChunkSize - 1)];
+    }
+
+public:
+    uint32_t intern(std::string_view str) {
+        if (str.empty())
+            return 0;
+
+        Shard& shard = m_shards[std::hash<std::string_view>()(str) % NumShards];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.ids.find(str);
+        if (it != shard.ids.end())
+            return it->second;
+
+        const uint32_t id = m_next.fetch_add(1, std::memory_order_relaxed);
+        std::string& slot = get_slot(id);
+        slot = str;
+
+        // Key the shard by the stored copy, which outlives |str|.
+        shard.ids.emplace(slot, id);
+        return id;
+    }
+
+    const std::string& get(uint32_t id) const {
+        static const std::string empty = "";
+        if (id == 0)
+            return empty;
+
+        const std::string* strings = 
+            m_chunks[id >> ChunkBits].load(std::memory_order_acquire);
+        return strings[id & (ChunkSize - 1)];
+    }
+};
+
+} // namespace
+
+/// Returns the interner. It is never destroyed, so that symbols can still be
+/// resolved while other static objects are being torn down.
+static Interner& get_interner() {
+    static Interner* interner = new Interner();
+    return *interner;
+}
+
+Symbol::Symbol(std::string_view str) : m_id(get_interner().intern(str)) {}
+
+const std::string& Symbol::str() const {
+    return get_interner().get(m_id);
+}
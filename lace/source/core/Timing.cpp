@@ -0,0 +1,429 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/core/ThreadPool.hpp"
+#include "lace/core/Timing.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace lace;
+using namespace lace::timing;
+
+namespace {
+
+/// A node in the timing tree.
+struct TimeNode final {
+    std::string name;
+    Node parent = Root;
+
+    /// The total time spent in this node, in nanoseconds.
+    uint64_t time = 0;
+
+    /// The number of times this node was entered.
+    uint32_t count = 0;
+
+    /// If the children of this node are left out of the printed tree.
+    bool folded = false;
+
+    std::vector<Node> children = {};
+    std::unordered_map<std::string, Node> lookup = {};
+};
+
+/// A region recorded on the timeline.
+struct TraceEvent final {
+    Node node;
+    Node detail;
+
+    /// The start of the region, relative to the start of the process, and its
+    /// duration, in nanoseconds.
+    uint64_t start;
+    uint64_t duration;
+
+    /// The thread pool worker that ran the region, or -1 for other threads.
+    int32_t worker;
+};
+
+/// The time spent in a node by a single thread.
+struct Sample final {
+    uint64_t time = 0;
+    uint32_t count = 0;
+};
+
+/// What a single thread has recorded.
+///
+/// Regions only touch the record of the thread they end on, so that timing
+/// does not make threads wait on each other. The records are merged into the
+/// tree when it is reported, and their events gathered when the trace is
+/// written.
+struct ThreadRecord final {
+    /// Only contended while the record is being merged.
+    std::mutex mutex;
+
+    /// The samples of each node since the tree was last reported, indexed by
+    /// node.
+    std::vector<Sample> samples = {};
+
+    /// The regions that ended on this thread, if tracing.
+    std::vector<TraceEvent> events = {};
+
+    /// The children of each node that this thread has looked up before, 
+    /// indexed by parent. Only used by the owning thread.
+    std::vector<std::unordered_map<std::string, Node>> lookup = {};
+
+    /// The nodes that this thread has folded before, indexed by node. Only 
+    /// used by the owning thread.
+    std::vector<bool> folded = {};
+};
+
+} // namespace
+
+static std::mutex g_mutex;
+static std::atomic<bool> g_enabled = false;
+static std::atomic<bool> g_tracing = false;
+static std::vector<TimeNode> g_nodes = { TimeNode { "total" } };
+static std::vector<std::unique_ptr<ThreadRecord>> g_records = {};
+static const auto g_epoch = std::chrono::steady_clock::now();
+
+static thread_local Node t_current = Root;
+static thread_local ThreadRecord* t_record = nullptr;
+
+/// Returns the child of |parent| named |name|, creating it if it does not yet
+/// exist. Assumes that |g_mutex| is held.
+static Node get_child(Node parent, const std::string& name) {
+    auto it = g_nodes[parent].lookup.find(name);
+    if (it != g_nodes[parent].lookup.end())
+        return it->second;
+
+    const Node node = g_nodes.size();
+    g_nodes.push_back({ name, parent });
+    g_nodes[parent].children.push_back(node);
+    g_nodes[parent].lookup.emplace(name, node);
+    return node;
+}
+
+/// Returns the record of the calling thread. Records outlive their threads, 
+/// as the workers of a pool may be gone by the time the tree is reported.
+static ThreadRecord& get_record() {
+    if (!t_record) {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        t_record = g_records.emplace_back(
+            std::make_unique<ThreadRecord>()).get();
+    }
+
+    return *t_record;
+}
+
+/// Returns the child of |parent| named |name| like get_child, but only takes
+/// the lock the first time the calling thread looks the child up.
+static Node find_child(Node parent, const std::string& name) {
+    ThreadRecord& record = get_record();
+    if (record.lookup.size() <= parent)
+        record.lookup.resize(parent + 1);
+
+    auto it = record.lookup[parent].find(name);
+    if (it != record.lookup[parent].end())
+        return it->second;
+
+    Node node;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        node = get_child(parent, name);
+    }
+
+    record.lookup[parent].emplace(name, node);
+    return node;
+}
+
+/// Leave the children of |node| out of the printed tree. Like find_child, this
+/// only takes the lock the first time the calling thread folds the node.
+static void fold(Node node) {
+    ThreadRecord& record = get_record();
+    if (record.folded.size() <= node)
+        record.folded.resize(node + 1);
+
+    if (record.folded[node])
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_nodes[node].folded = true;
+    }
+
+    record.folded[node] = true;
+}
+
+/// Merge the samples of every thread into the tree. Assumes that |g_mutex| 
+/// is held.
+static void merge() {
+    for (const auto& record : g_records) {
+        std::lock_guard<std::mutex> lock(record->mutex);
+        for (Node node = 0; node < record->samples.size(); ++node) {
+            g_nodes[node].time += record->samples[node].time;
+            g_nodes[node].count += record->samples[node].count;
+        }
+
+        record->samples.clear();
+    }
+}
+
+/// Returns the total time of |node|. The root is never timed itself, so its
+/// time is that of its children.
+static uint64_t get_time(Node node) {
+    if (node != Root)
+        return g_nodes[node].time;
+
+    uint64_t time = 0;
+    for (Node child : g_nodes[Root].children)
+        time += g_nodes[child].time;
+
+    return time;
+}
+
+/// Returns the children of |node|, sorted by the time spent in them.
+static std::vector<Node> get_sorted_children(Node node) {
+    std::vector<Node> children = g_nodes[node].children;
+    std::stable_sort(children.begin(), children.end(), [](Node a, Node b) {
+        return g_nodes[a].time > g_nodes[b].time;
+    });
+
+    return children;
+}
+
+static void print_node(std::ostream& os, Node node, uint32_t depth) {
+    const uint64_t time = get_time(node);
+
+    for (Node child : get_sorted_children(node)) {
+        const TimeNode& data = g_nodes[child];
+        const double share = time == 0
+            ? 0.0
+            : 100.0 * data.time / time;
+
+        char line[64];
+        std::snprintf(line, sizeof(line), "%12.3f ms (%5.1f%%)  ",
+            data.time / 1e6, share);
+
+        os << line << std::string(depth * 2, ' ') << data.name;
+        if (data.count > 1)
+            os << " (x" << data.count << ')';
+
+        os << '\n';
+        if (!data.folded)
+            print_node(os, child, depth + 1);
+    }
+}
+
+/// Write |str| as a JSON string literal to |os|.
+static void write_json_string(std::ostream& os, const std::string& str) {
+    os << '"';
+    for (char c : str) {
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            case '\t':
+                os << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escape[8];
+                    std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+                    os << escape;
+                } else {
+                    os << c;
+                }
+                break;
+        }
+    }
+
+    os << '"';
+}
+
+static void write_json_node(std::ostream& os, Node node) {
+    const TimeNode& data = g_nodes[node];
+
+    os << "{\"name\":";
+    write_json_string(os, data.name);
+    os << ",\"ns\":" << get_time(node)
+       << ",\"count\":" << data.count
+       << ",\"children\":[";
+
+    bool first = true;
+    for (Node child : get_sorted_children(node)) {
+        if (!first)
+            os << ',';
+
+        write_json_node(os, child);
+        first = false;
+    }
+
+    os << "]}";
+}
+
+void timing::enable() {
+    g_enabled.store(true, std::memory_order_relaxed);
+}
+
+void timing::enable_trace() {
+    g_tracing.store(true, std::memory_order_relaxed);
+    enable();
+}
+
+bool timing::is_enabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+Node timing::current() {
+    return t_current;
+}
+
+void timing::print(std::ostream& os) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    merge();
+
+    os << "timing report (nested times are summed across threads):\n";
+    print_node(os, Root, 0);
+    os.flush();
+}
+
+void timing::write_json(std::ostream& os) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    merge();
+
+    write_json_node(os, Root);
+    os << '\n';
+}
+
+void timing::write_trace(std::ostream& os) {
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    std::vector<TraceEvent> events = {};
+    for (const auto& record : g_records) {
+        std::lock_guard<std::mutex> lock(record->mutex);
+        events.insert(events.end(), record->events.begin(), 
+            record->events.end());
+    }
+
+    // Name the thread of each worker so the timeline labels them properly.
+    std::vector<int32_t> workers = {};
+    for (const TraceEvent& event : events) {
+        if (std::find(workers.begin(), workers.end(), event.worker) 
+          == workers.end())
+            workers.push_back(event.worker);
+    }
+
+    std::sort(workers.begin(), workers.end());
+
+    os << "{\"traceEvents\":[\n";
+
+    bool first = true;
+    for (int32_t worker : workers) {
+        if (!first)
+            os << ",\n";
+
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" 
+           << worker + 1 << ",\"args\":{\"name\":\"" 
+           << (worker < 0 ? "main" : "worker " + std::to_string(worker))
+           << "\"}}";
+
+        first = false;
+    }
+
+    for (const TraceEvent& event : events) {
+        if (!first)
+            os << ",\n";
+
+        char times[64];
+        std::snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f",
+            event.start / 1e3, event.duration / 1e3);
+
+        // Categorize each event by the region it was nested in, since the 
+        // names of per-file regions say little on their own.
+        const Node parent = g_nodes[event.node].parent;
+
+        os << "{\"name\":";
+        write_json_string(os, g_nodes[event.node].name);
+        os << ",\"cat\":";
+        write_json_string(os, parent == Root ? "lace" : g_nodes[parent].name);
+        os << ",\"ph\":\"X\"," << times
+           << ",\"pid\":1,\"tid\":" << event.worker + 1;
+
+        if (event.detail != event.node) {
+            os << ",\"args\":{\"detail\":";
+            write_json_string(os, g_nodes[event.detail].name);
+            os << '}';
+        }
+
+        os << '}';
+        first = false;
+    }
+
+    os << "\n]}\n";
+}
+
+Region::Region(Node parent, const std::string& name,
+               const std::string& detail, Breakdown breakdown) {
+    if (!is_enabled())
+        return;
+
+    m_node = find_child(parent, name);
+    m_detail = detail.empty() ? m_node : find_child(m_node, detail);
+
+    if (m_detail != m_node && breakdown == Breakdown::Folded)
+        fold(m_node);
+
+    m_prev = t_current;
+    t_current = m_detail;
+    m_active = true;
+    m_start = std::chrono::steady_clock::now();
+}
+
+Region::~Region() {
+    if (!m_active)
+        return;
+
+    const auto end = std::chrono::steady_clock::now();
+    const uint64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        end - m_start).count();
+
+    t_current = m_prev;
+
+    ThreadRecord& record = get_record();
+    {
+        std::lock_guard<std::mutex> lock(record.mutex);
+        const Node last = std::max(m_node, m_detail);
+        if (record.samples.size() <= last)
+            record.samples.resize(last + 1);
+
+        record.samples[m_node].time += time;
+        record.samples[m_node].count += 1;
+
+        if (m_detail != m_node) {
+            record.samples[m_detail].time += time;
+            record.samples[m_detail].count += 1;
+        }
+
+        if (g_tracing.load(std::memory_order_relaxed)) {
+            const uint64_t start = 
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    m_start - g_epoch).count();
+
+            record.events.push_back({ m_node, m_detail, start, time, 
+                ThreadPool::get_worker() });
+        }
+    }
+}
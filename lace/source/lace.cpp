@@ -6,19 +6,30 @@
 #include "lace/codegen/LIRCodegen.hpp"
 #include "lace/codegen/LLVMCodegen.hpp"
 #include "lace/core/Diagnostics.hpp"
-#include "lace/core/ThreadPool.hpp"
 #include "lace/core/Options.hpp"
+#include "lace/core/TaskGraph.hpp"
+#include "lace/core/Timing.hpp"
+#include "lace/core/ThreadPool.hpp"
 #include "lace/parser/Parser.hpp"
+#include "lace/tools/Cache.hpp"
+#include "lace/tools/Dump.hpp"
 #include "lace/tools/Files.hpp"
+#include "lace/tools/SourceManager.hpp"
 #include "lace/tree/AST.hpp"
+#include "lace/tree/Interface.hpp"
 #include "lace/tree/NameAnalysis.hpp"
 #include "lace/tree/Printer.hpp"
+#include "lace/tree/Scope.hpp"
 #include "lace/tree/SemanticAnalysis.hpp"
 #include "lace/tree/SymbolAnalysis.hpp"
+#include "lace/tree/SymbolTable.hpp"
 
 #include "lir/analysis/LoweringPass.hpp"
+#include "lir/analysis/PassInstrumentation.hpp"
 #include "lir/machine/AsmWriter.hpp"
+#include "lir/machine/Linker.hpp"
 #include "lir/machine/Machine.hpp"
+#include "lir/machine/ObjectWriter.hpp"
 #include "lir/machine/RegisterAnalysis.hpp"
 
 #include "llvm/ADT/Twine.h"
@@ -41,10 +52,14 @@
 #include "llvm/Transforms/Scalar/SimplifyCFG.h"
 #include "llvm/Transforms/Scalar/SROA.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <optional>
+#include <sstream>
 #include <string>
 #include <system_error>
 #include <thread>
@@ -61,15 +76,92 @@ using namespace std::filesystem;
 using Asts = std::unordered_set<AST*>;
 using DepTable = std::unordered_map<AST*, Asts>;
 using FileTable = std::unordered_map<std::string, AST*>;
+using HashTable = std::unordered_map<AST*, uint64_t>;
 
 struct InputFile final {
     std::string file;
     AST* ast;
 
+    /// A hash of the contents of the file.
+    uint64_t hash = 0;
+
     InputFile(const std::string& file, AST* ast = nullptr) 
       : file(file), ast(ast) {}
 };
 
+/// The passes that can be named with -dump-after, in the order they run.
+static constexpr const char* DumpPasses[] = {
+    "parse",
+    "name-analysis",
+    "symbol-analysis",
+    "semantic-analysis",
+    "codegen",
+    "register-analysis",
+};
+
+/// The writer that dumps are handed off to, or null if none were asked for.
+static DumpWriter* g_dumps = nullptr;
+
+/// The trees that were read from interfaces rather than parsed, for files that
+/// are loaded but were not given as inputs.
+static Asts g_interfaces = {};
+
+/// The stamps of the loaded files that each tree in |g_interfaces| had when 
+/// its interface was written.
+static HashTable g_stamps = {};
+
+/// Dump the tree |ast| to its file with the extension |ext|, if the output of
+/// the pass named |pass| was asked for. Trees read from an interface are only 
+/// a part of their file, so they are left alone.
+void dump_tree(const Options& options, AST* ast, const char* pass, 
+               const std::string& ext) {
+    if (!options.dumps_after(pass) || g_interfaces.count(ast))
+        return;
+
+    DumpBuffer out;
+    Printer printer(options, out);
+    ast->accept(printer);
+    g_dumps->submit(ast->get_file() + ext, out.take());
+}
+
+/// The size of a file, in bytes, from which on the bodies of its functions are 
+/// parsed as separate jobs. Smaller files are not worth lexing bodies twice for.
+static constexpr uint64_t DeferBodiesThreshold = 64 * 1024;
+
+/// Parse the input file |f|, and hash its contents for the compilation cache.
+/// The contents are kept in |sources| for diagnostics to refer back to. The 
+/// time spent is recorded under the timing node |parent|.
+///
+/// If a |pool| is given and the file is large, then the bodies of functions 
+/// are skipped over at first, and then parsed as jobs on it.
+void parse_file(const Options& options, SourceManager& sources, InputFile& f,
+                timing::Node parent, ThreadPool* pool) {
+    timing::Region region(parent, f.file);
+    log::Context context(f.file);
+
+    if (options.verbose)
+        log::note("parsing file: " + f.file);
+
+    const SourceBuffer& buffer = sources.load(f.file);
+
+    Hasher hasher;
+    hasher.add(buffer.get_text());
+    f.hash = hasher.get();
+
+    const bool defer = pool && buffer.get_text().size() >= DeferBodiesThreshold;
+
+    Parser parser(buffer.get_text(), f.file, defer);
+    f.ast = parser.parse();
+
+    if (defer)
+        Parser::parse_bodies(buffer.get_text(), f.ast, pool);
+
+    dump_tree(options, f.ast, "parse", ".parse.ast");
+
+    if (options.verbose)
+        log::note("finishing parsing for: " + f.file);
+}
+
 /// A mapping between the absolute path of an input file and its parsed AST.
 static FileTable g_files = {};
 
@@ -83,18 +175,100 @@ void setup_file_table(const Asts& asts) {
     }
 }
 
-/// Compute the dependency order and a dependency table for each file in the 
-/// list of |asts|.
+/// Returns the path of the interface written alongside the object of the 
+/// source file at |file|.
+std::string interface_path(const std::string& file) {
+    return file + ".lif";
+}
+
+/// Read the tree for the source file at |file|, which is loaded but is not an
+/// input, from the interface written by an earlier compilation with -c. The 
+/// hash of the file is saved to |hashes|.
+///
+/// Returns null if there is no interface and object for the file, or if the 
+/// file has changed since they were written.
+AST* load_interface(const Options& options, const std::string& file,
+                    HashTable& hashes) {
+    const std::string path = interface_path(file);
+    if (!exists(file) || !exists(path) || !exists(file + ".o"))
+        return nullptr;
+
+    timing::Region region("interface", file);
+
+    Hasher hasher;
+    {
+        MappedFile source(file);
+        hasher.add(source.get_text());
+    }
+
+    uint64_t stamp = 0;
+    MappedFile interface(path);
+    AST* ast = read_interface(interface.get_text(), file, hasher.get(), &stamp);
+    if (!ast)
+        return nullptr;
+
+    hashes.emplace(ast, hasher.get());
+    g_stamps.emplace(ast, stamp);
+
+    if (options.verbose)
+        log::note("using interface for: " + file);
+
+    return ast;
+}
+
+/// Returns the stamp of the files that the tree |ast| loads, memoized for
+/// each tree in |stamps|.
+///
+/// The stamp covers the contents of every file that |ast| loads, directly or 
+/// not, as per |hashes|, so that it changes along with any of them.
+uint64_t hash_loads(AST* ast, const DepTable& deps, const HashTable& hashes,
+                    HashTable& stamps) {
+    auto it = stamps.find(ast);
+    if (it != stamps.end())
+        return it->second;
+
+    // Mix in dependencies in a fixed order, regardless of how they happen to 
+    // be laid out in the table.
+    std::vector<uint64_t> dep_hashes = {};
+    for (AST* dep : deps.at(ast)) {
+        Hasher hasher;
+        hasher.add(hashes.at(dep));
+        hasher.add(hash_loads(dep, deps, hashes, stamps));
+        dep_hashes.push_back(hasher.get());
+    }
+
+    std::sort(dep_hashes.begin(), dep_hashes.end());
+
+    Hasher hasher;
+    for (uint64_t hash : dep_hashes)
+        hasher.add(hash);
+
+    return stamps[ast] = hasher.get();
+}
+
+/// Compute a dependency table for each file in the list of |asts| and save 
+/// it to |deps|.
 ///
-/// This function produces an ordering of the files without cycles to 
-/// |ordering|, s.t. any given file relies on only the ones which come 
-/// before it in the set. This means the result is a valid ordering in which to 
-/// sequentially perform name analysis on each syntax tree.
+/// Loaded files that are not in |asts| are read from their interfaces, and 
+/// added to |g_files|, |g_interfaces| and |hashes|, if they are unchanged 
+/// since their interface was written. Otherwise, they are unresolved.
 ///
-/// Moreover, as it computes dependencies, it saves them to |deps|.
-void compute_dependencies(const Asts& asts, Asts& ordering, DepTable& deps) {
-    for (AST* ast : asts) {
+/// Every tree is given an entry in |deps|, even if it does not load any other 
+/// files. Fails if the dependencies between files contain a cycle, or if any
+/// of the files that an interface loads have changed since it was written, as 
+/// its object may then be out of date as well.
+void compute_dependencies(const Options& options, const Asts& asts, 
+                          DepTable& deps, HashTable& hashes) {
+    // Trees read from interfaces have their own loads to resolve, so they
+    // are visited once they are found.
+    std::vector<AST*> worklist(asts.begin(), asts.end());
+
+    while (!worklist.empty()) {
+        AST* ast = worklist.back();
+        worklist.pop_back();
+
         path parent = absolute(ast->get_file()).parent_path();
+        deps[ast];
     
         for (Defn* defn : ast->get_defns()) {
             LoadDefn* load = dynamic_cast<LoadDefn*>(defn);
@@ -106,13 +280,20 @@ void compute_dependencies(const Asts& asts, Asts& ordering, DepTable& deps) {
             target = weakly_canonical(target);
 
             auto it = g_files.find(target.string());
-            if (it != g_files.end()) {
-                deps[ast].insert(it->second);
-                load->set_path(target.string());
-            } else {
-                log::fatal("unresolved file: " + target.string(), 
-                    log::Span(ast->get_file(), load->get_span()));
+            if (it == g_files.end()) {
+                AST* stub = load_interface(options, target.string(), hashes);
+                if (!stub) {
+                    log::fatal("unresolved file: " + target.string(), 
+                        log::Span(ast->get_file(), load->get_span()));
+                }
+
+                it = g_files.emplace(target.string(), stub).first;
+                g_interfaces.insert(stub);
+                worklist.push_back(stub);
             }
+
+            deps[ast].insert(it->second);
+            load->set_path(target.string());
         }
     }
 
@@ -134,100 +315,490 @@ void compute_dependencies(const Asts& asts, Asts& ordering, DepTable& deps) {
 
         visiting.erase(ast);
         visited.insert(ast);
-        ordering.insert(ast);
     };
 
     for (AST* ast : asts)
         dfs(ast);
+
+    std::vector<AST*> stubs(g_interfaces.begin(), g_interfaces.end());
+    std::sort(stubs.begin(), stubs.end(), [](AST* a, AST* b) {
+        return a->get_file() < b->get_file();
+    });
+
+    HashTable stamps = {};
+    for (AST* stub : stubs) {
+        if (hash_loads(stub, deps, hashes, stamps) != g_stamps.at(stub)) {
+            log::fatal("out of date interface, as a file it loads has "
+                "changed: " + stub->get_file());
+        }
+    }
 }
 
-/// Resolve the dependent symbols for each tree in |asts|, based on their
-/// dependencies defined in |deps|. Assumes that |asts| contains syntax 
-/// trees in their dependency order.
-void resolve_dependencies(const Options& options, const Asts& asts, 
+/// Resolve the dependent symbols for the tree |ast| based on its dependencies
+/// defined in |deps|, and then run name analysis on it. Assumes that name 
+/// analysis has already finished for each of those dependencies.
+void resolve_dependencies(const Options& options, AST* ast, 
                           const DepTable& deps) {
-    for (AST* ast : asts) {
-        Asts dep_list = deps.at(ast);
-        std::vector<NamedDefn*> symbols = {};
-
-        // For each dependency, fetch all of its public, named definitions.
-        for (AST* dep : dep_list) {
-            for (Defn* defn : dep->get_defns()) {
-                NamedDefn* symbol = dynamic_cast<NamedDefn*>(defn);
-                if (symbol && symbol->has_rune(Rune::Public))
-                    symbols.push_back(symbol);
-            }
-        }
+    Scope* scope = ast->get_scope();
+    SymbolTable table = {};
+    table.enter(scope);
 
-        Scope* scope = ast->get_scope();
-        for (NamedDefn* symbol : symbols) {
-            bool res = scope->add(symbol);
-            if (!res) {
+    // The public definitions of each dependency were gathered when it was 
+    // parsed, so they only need checking for conflicts before being bound.
+    for (AST* dep : deps.at(ast)) {
+        const AST::Exports& exports = dep->get_exports();
+
+        for (NamedDefn* symbol : exports) {
+            if (table.get(symbol->get_symbol())) {
                 log::fatal("name-wise conflict with an existing definition: " 
-                    + symbol->get_name(), log::Location(ast->get_file(), { 1, 1 }));
+                    + symbol->get_name(), 
+                    log::Location(ast->get_file(), { 1, 1 }));
             }
 
-            ast->get_loaded().push_back(symbol);
-            
+            table.add(symbol);
+
             if (options.verbose) {
-                log::note("added '" + symbol->get_name() + "' to " + ast->get_file());
+                log::note("added '" + symbol->get_name() + "' to " 
+                    + ast->get_file());
             }
         }
 
-        if (options.verbose)
-            log::note("running name analysis on: " + ast->get_file());
+        scope->add(exports);
+        ast->get_loaded().insert(
+            ast->get_loaded().end(), exports.begin(), exports.end());
+    }
 
-        NameAnalysis name_analysis(options);
-        ast->accept(name_analysis);
+    if (options.verbose)
+        log::note("running name analysis on: " + ast->get_file());
 
-        if (options.verbose)
-            log::note("finished name analysis for: " + ast->get_file());
-    }
+    NameAnalysis name_analysis(options);
+    ast->accept(name_analysis);
+
+    if (options.verbose)
+        log::note("finished name analysis for: " + ast->get_file());
+
+    dump_tree(options, ast, "name-analysis", ".names.ast");
 }
 
-void drive_lir_backend(const Options& options, const Asts& asts) {
-    lir::Machine mach(lir::Machine::Linux);
+/// Run symbol analysis on the tree |ast|.
+void analyze_symbols(const Options& options, AST* ast) {
+    if (options.verbose)
+        log::note("running symbol analysis on: " + ast->get_file());
 
-    for (AST* ast : asts) {
-        lir::CFG cfg(mach, ast->get_file());
+    SymbolAnalysis symbol_analysis(options);
+    ast->accept(symbol_analysis);
 
-        if (options.verbose)
-            log::note("running code generation for: " + ast->get_file());
+    if (options.verbose)
+        log::note("finished symbol analysis for: " + ast->get_file());
+
+    dump_tree(options, ast, "symbol-analysis", ".symbols.ast");
+}
+
+/// Run semantic analysis on the tree |ast|.
+void analyze_semantics(const Options& options, AST* ast) {
+    if (options.verbose)
+        log::note("running semantic analysis on: " + ast->get_file());
+
+    SemanticAnalysis semantic_analysis(options);
+    ast->accept(semantic_analysis);
+
+    if (options.verbose)
+        log::note("finished semantic analysis for: " + ast->get_file());
+
+    dump_tree(options, ast, "semantic-analysis", ".ast");
+}
+
+/// Run name, symbol and semantic analysis over each of the given |asts| as a 
+/// task graph shaped by the dependencies in |deps|.
+///
+/// Each phase of a tree starts once the same phase has finished for all of 
+/// its dependencies, and the previous phase has finished for the tree itself.
+/// Trees that do not depend on one another are analyzed concurrently if a 
+/// |pool| is given. Once an error has been logged, no new phases are started.
+void drive_frontend(const Options& options, const Asts& asts, 
+                    const DepTable& deps, ThreadPool* pool) {
+    using Phase = std::function<void(AST*)>;
+
+    const Phase phases[] = {
+        [&](AST* ast) { resolve_dependencies(options, ast, deps); },
+        [&](AST* ast) { analyze_symbols(options, ast); },
+        [&](AST* ast) { analyze_semantics(options, ast); },
+    };
+
+    const char* names[] = {
+        "name analysis",
+        "symbol analysis",
+        "semantic analysis",
+    };
+
+    timing::Region region("frontend");
+    const timing::Node parent = timing::current();
 
+    TaskGraph graph;
+    std::unordered_map<AST*, TaskGraph::Task> prev = {};
+    std::unordered_map<AST*, TaskGraph::Task> curr = {};
+    prev.reserve(asts.size());
+    curr.reserve(asts.size());
+
+    for (uint32_t i = 0; i < std::size(phases); ++i) {
+        for (AST* ast : asts) {
+            curr[ast] = graph.add([&phases, &names, parent, i, ast] {
+                if (log::has_errors())
+                    return;
+
+                timing::Region region(parent, names[i], ast->get_file());
+                log::Context context(ast->get_file());
+                phases[i](ast);
+            });
+        }
+
+        for (AST* ast : asts) {
+            if (prev.count(ast))
+                graph.depend(curr[ast], prev[ast]);
+
+            for (AST* dep : deps.at(ast))
+                graph.depend(curr[ast], curr[dep]);
+        }
+
+        prev.swap(curr);
+        curr.clear();
+    }
+
+    graph.run(pool);
+    log::flush();
+}
+
+/// Times the per-function work of backend passes, nested under whichever 
+/// region encloses the pass.
+///
+/// The breakdown by function is folded, so that the printed tree does not 
+/// grow a line for every function. It is still in the -time-json output.
+class PassTimer final : public lir::PassInstrumentation {
+    std::optional<timing::Region> m_region = std::nullopt;
+
+public:
+    void before(const char* pass, const std::string& function) override {
+        m_region.emplace(timing::current(), pass, function, 
+            timing::Breakdown::Folded);
+    }
+
+    void after(const char*, const std::string&) override {
+        m_region.reset();
+    }
+};
+
+/// Run the LIR backend pipeline for a single syntax tree |ast|, from code 
+/// generation down to a relocatable object, which is returned as-is.
+///
+/// Each invocation owns its own graph and segment, and only reads from the 
+/// shared |mach|, so it is safe to run it concurrently for different trees.
+std::string compile_lir(const Options& options, const lir::Machine& mach, 
+                        AST* ast) {
+    lir::CFG cfg(mach, ast->get_file());
+    log::Context context(ast->get_file());
+
+    if (options.verbose)
+        log::note("running code generation for: " + ast->get_file());
+
+    {
+        timing::Region region("codegen");
         LIRCodegen codegen(options, ast, cfg);
         codegen.run();
+    }
 
-        if (options.verbose)
-            log::note("finished code generation for: " + ast->get_file());
-
-        if (options.print_ir) {
-            std::ofstream file(ast->get_file() + ".lir");
-            if (!file || !file.is_open())
-                log::fatal("failed to open: " + ast->get_file() + ".s");
-            
-            cfg.print(file);
-            file.close();
+    if (options.verbose)
+        log::note("finished code generation for: " + ast->get_file());
+
+    if (options.dumps_after("codegen")) {
+        DumpBuffer out;
+        if (options.dump_funcs.empty()) {
+            cfg.print(out);
+        } else for (const std::string& name : options.dump_funcs) {
+            if (const lir::Function* function = cfg.get_function(name)) {
+                function->print(out, lir::PrintPolicy::Def);
+                out << '\n';
+            }
         }
 
-        lir::Segment seg(cfg);
+        g_dumps->submit(ast->get_file() + ".lir", out.take());
+    }
+
+    lir::Segment seg(cfg);
+    PassTimer timer;
 
-        lir::LoweringPass lowering(cfg, seg);
+    {
+        timing::Region region("lowering");
+        lir::LoweringPass lowering(cfg, seg, &timer);
         lowering.run();
+    }
 
-        lir::RegisterAnalysis rega(seg);
+    {
+        timing::Region region("register analysis");
+        lir::RegisterAnalysis rega(seg, &timer);
         rega.run();
+    }
 
-        std::ofstream as(ast->get_file() + ".s");
-        if (!as || !as.is_open())
-            log::fatal("failed to open: " + ast->get_file() + ".s");
+    // The assembly is always of the whole file, as functions cannot be
+    // written out on their own.
+    if (options.dumps_after("register-analysis")) {
+        timing::Region region("asm dump");
 
+        DumpBuffer out;
         lir::AsmWriter writer(seg);
-        writer.run(as);
-        as.close();
+        writer.run(out);
+        g_dumps->submit(ast->get_file() + ".s", out.take());
+    }
+
+    timing::Region region("object emission");
+
+    std::ostringstream obj;
+    lir::ObjectWriter writer(seg);
+    writer.run(obj);
+    return obj.str();
+}
+
+/// Link the given |objects|, and the runtime if there is one, into the 
+/// executable named by the output option.
+void link_objects(const Options& options, 
+                  std::vector<std::pair<std::string, std::string>>& objects) {
+    timing::Region region("link");
+    lir::Linker linker;
+
+    if (!options.runtime.empty())
+        linker.add_object(options.runtime, read_file(options.runtime));
+
+    for (auto& [name, image] : objects)
+        linker.add_object(name, std::move(image));
 
-        std::string assembler = "as " + ast->get_file() + ".s -o " + ast->get_file() + ".o";
-        std::system(assembler.c_str());
+    std::ostringstream exe;
+    if (!linker.run(exe)) {
+        for (const std::string& error : linker.get_errors())
+            log::error(error);
+
+        log::flush();
+    }
+
+    std::ofstream file(options.output, std::ios::binary);
+    if (!file || !file.is_open())
+        log::fatal("failed to open: " + options.output);
+
+    file << exe.str();
+    file.close();
+
+    permissions(options.output, perms::owner_exec | perms::group_exec | 
+        perms::others_exec, perm_options::add);
+
+    if (options.verbose)
+        log::note("linked executable: " + options.output);
+}
+
+/// Mix the name and runes of |defn| into |hasher|.
+void hash_named_defn(Hasher& hasher, const NamedDefn* defn) {
+    hasher.add(static_cast<uint64_t>(defn->get_kind()));
+    hasher.add(defn->get_name());
+
+    hasher.add(static_cast<uint64_t>(defn->num_runes()));
+    for (const Rune* rune : defn->get_runes())
+        hasher.add(static_cast<uint64_t>(rune->get_kind()));
+}
+
+/// Returns a hash of the interface that the tree |ast| exposes to the files 
+/// that load it, memoized in |interfaces|.
+///
+/// The interface is made up of the signatures of public values and the layout 
+/// of every type, public or not, since private types can still reach other 
+/// files through public signatures. Types may also come from the files that 
+/// |ast| loads, so the interfaces of those are mixed in as well.
+uint64_t hash_interface(AST* ast, const DepTable& deps, 
+                        HashTable& interfaces) {
+    auto it = interfaces.find(ast);
+    if (it != interfaces.end())
+        return it->second;
+
+    Hasher hasher;
+
+    for (const Defn* defn : ast->get_defns()) {
+        if (const auto* structure = dynamic_cast<const StructDefn*>(defn)) {
+            hash_named_defn(hasher, structure);
+            for (const FieldDefn* field : structure->get_fields()) {
+                hasher.add(field->get_name());
+                hasher.add(field->get_type().to_string());
+            }
+        } else if (const auto* enumeration = dynamic_cast<const EnumDefn*>(defn)) {
+            hash_named_defn(hasher, enumeration);
+            hasher.add(static_cast<const EnumType*>(enumeration->get_type())
+                ->get_underlying().to_string());
+
+            for (const VariantDefn* variant : enumeration->get_variants()) {
+                hasher.add(variant->get_name());
+                hasher.add(static_cast<uint64_t>(variant->get_value()));
+            }
+        } else if (const auto* alias = dynamic_cast<const AliasDefn*>(defn)) {
+            hash_named_defn(hasher, alias);
+            hasher.add(static_cast<const AliasType*>(alias->get_type())
+                ->get_underlying().to_string());
+        } else if (const auto* value = dynamic_cast<const ValueDefn*>(defn)) {
+            if (!value->has_rune(Rune::Public))
+                continue;
+
+            hash_named_defn(hasher, value);
+            hasher.add(value->get_type().to_string());
+        }
     }
+
+    // Mix in dependencies in a fixed order, regardless of how they happen to 
+    // be laid out in the table.
+    std::vector<uint64_t> dep_hashes = {};
+    for (AST* dep : deps.at(ast))
+        dep_hashes.push_back(hash_interface(dep, deps, interfaces));
+
+    std::sort(dep_hashes.begin(), dep_hashes.end());
+    for (uint64_t hash : dep_hashes)
+        hasher.add(hash);
+
+    return interfaces[ast] = hasher.get();
+}
+
+/// Returns the compilation cache key for the tree |ast|, which covers the 
+/// compiler version, the options that affect code generation, the contents of 
+/// the file and the interfaces of the files it loads.
+uint64_t hash_unit(const Options& options, AST* ast, const DepTable& deps,
+                   const HashTable& hashes, HashTable& interfaces) {
+    Hasher hasher;
+    hasher.add(static_cast<uint64_t>(LACE_VERSION_MAJOR));
+    hasher.add(static_cast<uint64_t>(LACE_VERSION_MINOR));
+    hasher.add(static_cast<uint64_t>(options.opt));
+    hasher.add(static_cast<uint64_t>(options.debug));
+    hasher.add(ast->get_file());
+    hasher.add(hashes.at(ast));
+
+    std::vector<uint64_t> dep_hashes = {};
+    for (AST* dep : deps.at(ast))
+        dep_hashes.push_back(hash_interface(dep, deps, interfaces));
+
+    std::sort(dep_hashes.begin(), dep_hashes.end());
+    for (uint64_t hash : dep_hashes)
+        hasher.add(hash);
+
+    return hasher.get();
+}
+
+/// Run the LIR backend over each of the given |asts|.
+///
+/// If a |pool| is provided, then each tree is compiled as an independent job 
+/// on it. Each object is written next to its source file, along with its
+/// interface. If an executable was asked for with -o, and not -c, then the 
+/// objects are also linked in the order of their file names, so the output is
+/// the same regardless of the order in which the jobs finish.
+///
+/// If the compilation cache is enabled with -cache, then trees whose key, as 
+/// per hash_unit, is already in the cache reuse the cached object and skip 
+/// code generation entirely. The cache is not used when the output of code 
+/// generation or register analysis is to be dumped.
+void drive_lir_backend(const Options& options, const Asts& asts, 
+                       const DepTable& deps, const HashTable& hashes,
+                       ThreadPool* pool) {
+    const lir::Machine mach(lir::Machine::Linux);
+
+    std::optional<timing::Region> region(std::in_place, "backend");
+    const timing::Node parent = timing::current();
+
+    std::vector<AST*> order(asts.begin(), asts.end());
+    std::sort(order.begin(), order.end(), [](AST* a, AST* b) {
+        return a->get_file() < b->get_file();
+    });
+
+    std::vector<std::pair<std::string, std::string>> objects(order.size());
+
+    // Code generation has to actually run for its output to be dumped, so the
+    // cache is passed over when any of it was asked for.
+    const bool use_cache = !options.cache.empty() && 
+        !options.dumps_after("codegen") && 
+        !options.dumps_after("register-analysis");
+
+    const Cache cache(options.cache);
+    std::vector<uint64_t> keys(order.size(), 0);
+    std::vector<bool> cached(order.size(), false);
+    HashTable interfaces = {};
+    HashTable stamps = {};
+
+    for (uint32_t i = 0, e = order.size(); i < e; ++i) {
+        AST* ast = order[i];
+        objects[i].first = ast->get_file() + ".o";
+
+        if (!use_cache)
+            continue;
+
+        timing::Region region("cache lookup");
+        keys[i] = hash_unit(options, ast, deps, hashes, interfaces);
+        cached[i] = cache.load(keys[i], objects[i].second);
+
+        if (cached[i] && options.verbose)
+            log::note("using cached object for: " + ast->get_file());
+    }
+
+    auto compile = [&](uint32_t i) {
+        timing::Region region(parent, order[i]->get_file());
+        objects[i].second = compile_lir(options, mach, order[i]);
+
+        // Don't let an object from a failed compilation poison the cache.
+        if (use_cache && !log::has_errors())
+            cache.store(keys[i], objects[i].second);
+    };
+
+    std::vector<uint32_t> misses = {};
+    for (uint32_t i = 0, e = order.size(); i < e; ++i)
+        if (!cached[i])
+            misses.push_back(i);
+
+    if (pool) {
+        pool->parallel_for(0, misses.size(), [&](uint32_t i) {
+            compile(misses[i]);
+        });
+    } else for (uint32_t i : misses) {
+        compile(i);
+    }
+
+    region.reset();
+    log::flush();
+
+    for (uint32_t i = 0, e = order.size(); i < e; ++i) {
+        const std::string& name = objects[i].first;
+        std::ofstream file(name, std::ios::binary);
+        if (!file || !file.is_open())
+            log::fatal("failed to open: " + name);
+
+        file << objects[i].second;
+        file.close();
+
+        // Write the interface alongside the object, so that later runs can
+        // load the file without parsing it again while it is unchanged.
+        const std::string iface = interface_path(order[i]->get_file());
+        std::ofstream out(iface, std::ios::binary);
+        if (!out || !out.is_open())
+            log::fatal("failed to open: " + iface);
+
+        write_interface(order[i], hashes.at(order[i]), 
+            hash_loads(order[i], deps, hashes, stamps), out);
+        out.close();
+    }
+
+    if (!options.link || options.compile_only)
+        return;
+
+    // Files read from interfaces were compiled by an earlier run, which left
+    // their objects next to their sources.
+    std::vector<AST*> stubs(g_interfaces.begin(), g_interfaces.end());
+    std::sort(stubs.begin(), stubs.end(), [](AST* a, AST* b) {
+        return a->get_file() < b->get_file();
+    });
+
+    for (AST* stub : stubs) {
+        const std::string name = stub->get_file() + ".o";
+        objects.emplace_back(name, read_file(name));
+    }
+
+    link_objects(options, objects);
 }
 
 void drive_llvm_backend(const Options& options, const Asts& asts) {
@@ -292,14 +863,13 @@ void drive_llvm_backend(const Options& options, const Asts& asts) {
         mod->setDataLayout(mach->createDataLayout());
         mod->setTargetTriple(triple);
 
-        if (options.print_ir) {
-            std::error_code err;
-            llvm::raw_fd_ostream ir(ast->get_file() + ".ll", err);
-            if (err)
-                log::fatal("failed to open file: " + ast->get_file() + ".ll");
-            
+        if (options.dumps_after("codegen")) {
+            std::string text = {};
+            llvm::raw_string_ostream ir(text);
             mod->print(ir, nullptr);
-            ir.close();
+            ir.flush();
+
+            g_dumps->submit(ast->get_file() + ".ll", std::move(text));
         }
 
         contexts.push_back(ctx);
@@ -365,20 +935,22 @@ void drive_llvm_backend(const Options& options, const Asts& asts) {
 
 int32_t main(int32_t argc, char** argv) {
     Options options;
-    options.output = "main";
     options.opt = Options::OptLevel::None;
     options.threads = 1;
 
     options.debug = true;
     options.multithread = true;
-    options.time = true;
+    options.time = false;
     options.verbose = true;
     options.version = true;
     options.llvm = false;
-    options.print_tree = true;
-    options.print_ir = true;
+    options.compile_only = false;
+    options.link = false;
+
+    SourceManager sources;
 
     log::init();
+    log::set_source_manager(sources);
 
     std::vector<InputFile> files = {};
 
@@ -391,6 +963,17 @@ int32_t main(int32_t argc, char** argv) {
             options.debug = true;
         } else if (arg == "-t") {
             options.time = true;
+        } else if (arg == "-time-json") {
+            if (i + 1 == argc)
+                log::fatal("expected filename after -time-json");
+
+            options.time = true;
+            options.time_json = argv[++i];
+        } else if (arg == "-time-trace") {
+            if (i + 1 == argc)
+                log::fatal("expected filename after -time-trace");
+
+            options.time_trace = argv[++i];
         } else if (arg == "-v") {
             log::note("version: " + std::to_string(LACE_VERSION_MAJOR) + "." + 
                 std::to_string(LACE_VERSION_MINOR));
@@ -407,9 +990,23 @@ int32_t main(int32_t argc, char** argv) {
         } else if (arg == "-st") {
             options.multithread = false;
         } else if (arg == "-dump-ast") {
-            options.print_tree = true;
+            options.dump_after.push_back("semantic-analysis");
         } else if (arg == "-dump-ir") {
-            options.print_ir = true;
+            options.dump_after.push_back("codegen");
+        } else if (arg == "-dump-asm") {
+            options.dump_after.push_back("register-analysis");
+        } else if (arg.starts_with("-dump-after=")) {
+            const std::string pass = arg.substr(std::strlen("-dump-after="));
+            if (std::find_if(std::begin(DumpPasses), std::end(DumpPasses), 
+                    [&](const char* name) { return pass == name; }) 
+                    == std::end(DumpPasses)) {
+                log::fatal("unknown pass for -dump-after: " + pass);
+            }
+
+            options.dump_after.push_back(pass);
+        } else if (arg.starts_with("-dump-func=")) {
+            options.dump_funcs.push_back(
+                arg.substr(std::strlen("-dump-func=")));
         } else if (arg == "-j") {
             if (i + 1 == argc)
                 log::fatal("expected number after -j");
@@ -420,11 +1017,26 @@ int32_t main(int32_t argc, char** argv) {
                     + std::to_string(threads));
 
             options.threads = static_cast<uint32_t>(threads);
+        } else if (arg == "-c") {
+            options.compile_only = true;
+        } else if (arg == "-rt") {
+            if (i + 1 == argc)
+                log::fatal("expected filename after -rt");
+
+            options.runtime = argv[++i];
+        } else if (arg == "-cache") {
+            if (i + 1 == argc)
+                log::fatal("expected directory after -cache");
+
+            options.cache = argv[++i];
+        } else if (arg == "-no-cache") {
+            options.cache.clear();
         } else if (arg == "-o") {
             if (i + 1 == argc)
                 log::fatal("expected filename after -o");
 
             options.output = argv[++i];
+            options.link = true;
         } else {
             if (arg.size() < 4 || arg.substr(arg.size() - 5) != ".lace")
                 log::error("expected source file ending with \".lace\", got " + arg);
@@ -436,6 +1048,19 @@ int32_t main(int32_t argc, char** argv) {
     if (files.empty())
         log::fatal("no input files");
 
+    // Dumps are most useful when the compiler fails, so the ones that were 
+    // already submitted are still written out if it stops on a fatal error.
+    if (!options.dump_after.empty()) {
+        g_dumps = new DumpWriter();
+        log::set_fatal_hook([] { g_dumps->finish(); });
+    }
+
+    if (!options.time_trace.empty()) {
+        timing::enable_trace();
+    } else if (options.time) {
+        timing::enable();
+    }
+
     log::flush();
 
     if (options.multithread) {
@@ -451,9 +1076,20 @@ int32_t main(int32_t argc, char** argv) {
             options.threads = std::min(options.threads, supported_threads);
         }
 
-        // No point in us using more threads than there are files.
-        options.threads = std::min(options.threads, 
-            static_cast<uint32_t>(files.size()));
+        // No point in us using more threads than there are files, unless a 
+        // file is large enough for the bodies of its functions to be parsed 
+        // as jobs of their own.
+        const bool large = std::any_of(files.begin(), files.end(), 
+            [](const InputFile& f) {
+                std::error_code err;
+                const uintmax_t size = file_size(f.file, err);
+                return !err && size >= DeferBodiesThreshold;
+            });
+
+        if (!large) {
+            options.threads = std::min(options.threads, 
+                static_cast<uint32_t>(files.size()));
+        }
     }
 
     ThreadPool* pool = nullptr;
@@ -465,104 +1101,92 @@ int32_t main(int32_t argc, char** argv) {
             log::note("using " + std::to_string(options.threads) + " threads");
     }
 
+    std::optional<timing::Region> region(std::in_place, "parse");
+    const timing::Node parent = timing::current();
+
     if (options.multithread) {
         assert(pool);
 
-        for (InputFile& f : files) {
-            pool->push([&f, options] {
-                if (options.verbose)
-                    log::note("parsing file: " + f.file);
-
-                Parser parser(read_file(f.file), f.file);
-                f.ast = parser.parse();
-
-                if (options.verbose)
-                    log::note("finishing parsing for: " + f.file);
-            });
-        }
-
-        pool->wait();
+        pool->parallel_for(0, files.size(), [&](uint32_t i) {
+            parse_file(options, sources, files[i], parent, pool);
+        });
     } else for (InputFile& f : files) {
-        if (options.verbose)
-            log::note("parsing file: " + f.file);
-
-        Parser parser(read_file(f.file), f.file);
-        f.ast = parser.parse();
-        
-        if (options.verbose)
-            log::note("finishing parsing for: " + f.file);
+        parse_file(options, sources, f, parent, nullptr);
     }
 
+    region.reset();
+
     log::flush();
 
     Asts asts = {};
     asts.reserve(files.size());
-    for (InputFile& file : files)
+    HashTable hashes = {};
+    hashes.reserve(files.size());
+
+    for (InputFile& file : files) {
         asts.insert(file.ast);
+        hashes.emplace(file.ast, file.hash);
+    }
 
     setup_file_table(asts);
 
-    Asts ordering = {};
     DepTable deps = {};
-    ordering.reserve(asts.size());
     deps.reserve(asts.size());
 
-    compute_dependencies(asts, ordering, deps);
-    resolve_dependencies(options, ordering, deps);
+    compute_dependencies(options, asts, deps, hashes);
 
-    // Perform symbol analysis on each syntax tree.
-    //
-    // @Todo: expirement if this needs the dependency ordering or not.
-    for (AST* ast : asts) {
-        if (options.verbose)
-            log::note("running symbol analysis on: " + ast->get_file());
+    // Trees read from interfaces are analyzed along with the inputs, so that
+    // the names in them are resolved, but they are not compiled again.
+    Asts trees = asts;
+    trees.insert(g_interfaces.begin(), g_interfaces.end());
+    drive_frontend(options, trees, deps, pool);
 
-        SymbolAnalysis symbol_analysis(options);
-        ast->accept(symbol_analysis);
+    if (options.llvm) {
+        timing::Region region("llvm backend");
+        drive_llvm_backend(options, asts);
+    } else {
+        // Default to LIR.
+        drive_lir_backend(options, asts, deps, hashes, pool);
+    }
 
-        if (options.verbose)
-            log::note("finished symbol analysis for: " + ast->get_file());
+    // Wait on the dumps still being written. A dump that cannot be written only
+    // logs a warning, so that it does not fail an otherwise good build.
+    if (g_dumps) {
+        timing::Region region("dump");
+        log::set_fatal_hook(nullptr);
+        delete g_dumps;
+        g_dumps = nullptr;
     }
 
     log::flush();
 
-    // Perform semantic analysis on each syntax tree.
-    for (AST* ast : asts) {
-        if (options.verbose)
-            log::note("running semantic analysis on: " + ast->get_file());
+    for (AST* ast : trees)
+        delete ast;
 
-        SemanticAnalysis semantic_analysis(options);
-        ast->accept(semantic_analysis);
+    asts.clear();
+    files.clear();
 
-        if (options.verbose)
-            log::note("finished semantic analysis for: " + ast->get_file());
+    if (options.time) {
+        timing::print(std::cerr);
 
-        // AST is now considered valid, so print it if needbe.
-        if (options.print_tree) {
-            std::ofstream out(ast->get_file() + ".ast");
+        if (!options.time_json.empty()) {
+            std::ofstream out(options.time_json);
             if (!out || !out.is_open())
-                log::fatal("failed to open file: " + ast->get_file() + ".ast");
+                log::fatal("failed to open: " + options.time_json);
 
-            Printer printer(options, out);
-            ast->accept(printer);
+            timing::write_json(out);
             out.close();
         }
     }
 
-    log::flush();
+    if (!options.time_trace.empty()) {
+        std::ofstream out(options.time_trace);
+        if (!out || !out.is_open())
+            log::fatal("failed to open: " + options.time_trace);
 
-    if (options.llvm) {
-        drive_llvm_backend(options, asts);
-    } else {
-        // Default to LIR.
-        drive_lir_backend(options, asts);
+        timing::write_trace(out);
+        out.close();
     }
 
-    for (AST* ast : asts)
-        delete ast;
-
-    asts.clear();
-    files.clear();
-
     return 0;
 }
@@ -5,20 +5,129 @@
 
 #include "lace/core/Diagnostics.hpp"
 #include "lace/lexer/Lexer.hpp"
+#include "lace/lexer/Scanner.hpp"
 #include "lace/lexer/Token.hpp"
 
+#include <array>
+#include <cstdint>
+#include <string_view>
+
 using namespace lace;
 
+namespace {
+
+/// A keyword and the kind of token it is lexed as.
+struct Keyword final {
+    std::string_view name;
+    Token::Kind kind;
+};
+
+constexpr Keyword g_keywords[] = {
+    { "cast", Token::KwCast },
+    { "else", Token::KwElse },
+    { "enum", Token::KwEnum },
+    { "false", Token::KwFalse },
+    { "if", Token::KwIf },
+    { "let", Token::KwLet },
+    { "load", Token::KwLoad },
+    { "mut", Token::KwMut },
+    { "null", Token::KwNull },
+    { "restart", Token::KwRestart },
+    { "ret", Token::KwRet },
+    { "sizeof", Token::KwSizeof },
+    { "stop", Token::KwStop },
+    { "struct", Token::KwStruct },
+    { "true", Token::KwTrue },
+    { "union", Token::KwUnion },
+    { "until", Token::KwUntil },
+    { "void", Token::KwVoid },
+    { "bool", Token::KwBool },
+    { "char", Token::KwChar },
+    { "s8", Token::KwS8 },
+    { "s16", Token::KwS16 },
+    { "s32", Token::KwS32 },
+    { "s64", Token::KwS64 },
+    { "u8", Token::KwU8 },
+    { "u16", Token::KwU16 },
+    { "u32", Token::KwU32 },
+    { "u64", Token::KwU64 },
+    { "f32", Token::KwF32 },
+    { "f64", Token::KwF64 },
+};
+
+constexpr uint32_t NumKeywords = std::size(g_keywords);
+
+/// The number of slots in the keyword table. Must be a power of two.
+constexpr uint32_t NumSlots = 128;
+
+constexpr uint8_t EmptySlot = 0xFF;
+
+constexpr uint32_t MinKeywordLength = 2;
+constexpr uint32_t MaxKeywordLength = 7;
+
+/// Hash |ident| into a slot of the keyword table with |seed|.
+///
+/// Only the length and the first, second and last characters are mixed in, 
+/// which is enough to tell every keyword apart. Identifiers that land on the
+/// slot of a keyword are ruled out by comparing them to it in full.
+constexpr uint32_t hash_keyword(std::string_view ident, uint32_t seed) {
+    uint32_t hash = seed ^ static_cast<uint32_t>(ident.size());
+    hash = (hash ^ static_cast<uint8_t>(ident[0])) * 0x01000193;
+    hash = (hash ^ static_cast<uint8_t>(ident[1])) * 0x01000193;
+    hash = (hash ^ static_cast<uint8_t>(ident.back())) * 0x01000193;
+    return (hash ^ (hash >> 15)) & (NumSlots - 1);
+}
+
+/// Returns the first seed for which no two keywords hash to the same slot, or
+/// 0 if there is none below the search limit.
+constexpr uint32_t find_keyword_seed() {
+    for (uint32_t seed = 1; seed < 4096; ++seed) {
+        bool used[NumSlots] = {};
+        bool perfect = true;
+
+        for (const Keyword& kw : g_keywords) {
+            const uint32_t slot = hash_keyword(kw.name, seed);
+            if (used[slot]) {
+                perfect = false;
+                break;
+            }
+
+            used[slot] = true;
+        }
+
+        if (perfect)
+            return seed;
+    }
+
+    return 0;
+}
+
+constexpr uint32_t KeywordSeed = find_keyword_seed();
+static_assert(KeywordSeed != 0, "no perfect hash found for the keywords!");
+
+/// Build the table mapping each slot to the index of the keyword that hashes
+/// to it, if any.
+constexpr std::array<uint8_t, NumSlots> build_keyword_table() {
+    std::array<uint8_t, NumSlots> table = {};
+    for (uint8_t& slot : table)
+        slot = EmptySlot;
+
+    for (uint32_t i = 0; i < NumKeywords; ++i)
+        table[hash_keyword(g_keywords[i].name, KeywordSeed)] = i;
+
+    return table;
+}
+
+constexpr std::array<uint8_t, NumSlots> g_keyword_table = 
+    build_keyword_table();
+
+} // namespace
+
 /// Test if |c| is an octal digit.
 static inline bool is_octal_digit(char c) {
     return '0' <= c && c <= '7';
 }
 
-/// Test if |c| is a space or tab.
-static inline bool is_whitespace(char c) {
-    return c == ' ' || c == '\t';
-}
-
 /// Test if |kind| is for a compound token i.e. a symbolic token containing 
 /// more than one symbol.
 static inline bool is_compound(Token::Kind kind) {
@@ -39,8 +148,28 @@ static inline bool is_compound(Token::Kind kind) {
     }
 }
 
+void Lexer::skip_trivia() {
+    while (true) {
+        move(scan::skip_blanks(ptr()));
+
+        if (curr() == '\n') {
+            ++m_cursor;
+            end_line();
+        } else if (curr() == '/' && peek() == '/') {
+            // The line break is left for the next iteration to count.
+            move(2);
+            move(scan::skip_line(ptr()));
+        } else {
+            return;
+        }
+    }
+}
+
 void Lexer::lex(Token& token) {
-    token.value.clear();
+    token.value = {};
+    skip_trivia();
+
+    token.offset = m_cursor;
 
     if (is_eof()) {
         token.kind = Token::EndOfFile;
@@ -48,17 +177,6 @@ void Lexer::lex(Token& token) {
         return;
     }
 
-    if (curr() == '\n') {
-        ++m_cursor;
-        end_line();
-        return lex(token);
-    } else if (is_whitespace(curr())) {
-        while (is_whitespace(curr()))
-            move();
-
-        return lex(token);
-    }
-
     token.loc = m_loc;
 
     switch (curr()) {
@@ -84,22 +202,9 @@ void Lexer::lex(Token& token) {
             break;
 
         case '/':
-            if (peek() == '/') {
-                move(2);
-                while (curr() != '\n' && curr() != '\0')
-                    move();
-
-                if (curr() == '\n') {
-                    ++m_cursor;
-                    end_line();
-                }
-
-                return lex(token);
-            } else {
-                move();
-                token.kind = Token::Slash;
-            }
-
+            // Comments were skipped over with the rest of the trivia.
+            token.kind = Token::Slash;
+            move();
             break;
 
         case '%':
@@ -247,14 +352,12 @@ void Lexer::lex(Token& token) {
 
         case '.':
             if (std::isdigit(peek())) {
+                const uint32_t start = m_cursor;
                 token.kind = Token::Float;
-                token.value = ".";
                 move();
+                move(scan::skip_digits(ptr()));
 
-                while (std::isdigit(curr())) {
-                    token.value += curr();
-                    move();
-                }
+                token.value = m_source.substr(start, m_cursor - start);
             } else {
                 token.kind = Token::Dot;
                 move();
@@ -266,9 +369,19 @@ void Lexer::lex(Token& token) {
             move(); // '
             token.kind = Token::Character;
 
+            if (curr() == '\0' && is_eof()) {
+                log::fatal("unterminated character literal", 
+                    log::Location(m_filename, token.loc));
+            }
+
             if (curr() == '\\') {
                 move(); // '\'
 
+                if (curr() == '\0' && is_eof()) {
+                    log::fatal("unterminated character literal", 
+                        log::Location(m_filename, token.loc));
+                }
+
                 switch (curr()) {
                     case '0':
                         token.value = "\0"; 
@@ -306,51 +419,70 @@ void Lexer::lex(Token& token) {
                     }
                 }
             } else {
-                token.value = curr();
+                token.value = m_source.substr(m_cursor, 1);
+            }
+
+            move();
+            if (curr() != '\'') {
+                log::fatal("unterminated character literal", 
+                    log::Location(m_filename, token.loc));
             }
 
-            move(2);    
+            move(); // '
             break;
 
-        case '"':
+        case '"': {
             move(); // "
+            std::string value = "";
             token.kind = Token::String;
-            token.value = "";
 
             while (curr() != '"') {
+                // Copy over plain characters up to the next quote, escape or
+                // terminator all at once.
+                if (const uint32_t run = scan::skip_string(ptr())) {
+                    value.append(ptr(), run);
+                    move(run);
+                    continue;
+                }
+
+                if (curr() == '\0' && is_eof()) {
+                    log::fatal("unterminated string literal", 
+                        log::Location(m_filename, token.loc));
+                }
+
                 if (curr() == '\\') {
                     move(); // '\'
 
                     switch (curr()) {
                         case '0': 
-                            token.value += '\0'; 
+                            value += '\0'; 
                             break;
                         case 'n': 
-                            token.value += '\n'; 
+                            value += '\n'; 
                             break;
                         case 't': 
-                            token.value += '\t'; 
+                            value += '\t'; 
                             break;
                         case 'r': 
-                            token.value += '\r'; 
+                            value += '\r'; 
                             break;
                         case 'b': 
-                            token.value += '\b'; 
+                            value += '\b'; 
                             break;
                         case 'f': 
-                            token.value += '\f'; 
+                            value += '\f'; 
                             break;
                         case 'v': 
-                            token.value += '\v'; 
+                            value += '\v'; 
                             break;
                         case '\\': 
-                            token.value += '\\'; 
+                            value += '\\'; 
                             break;
                         case '\'': 
-                            token.value += '\''; 
+                            value += '\''; 
                             break;
                         case '\"': 
-                            token.value += '\"'; 
+                            value += '\"'; 
                             break;
                         default: if (is_octal_digit(curr())) {
                             int32_t oct_val = 0, digits = 0;
@@ -360,7 +492,7 @@ void Lexer::lex(Token& token) {
                                 digits++;
                             }
 
-                            token.value += static_cast<char>(oct_val);
+                            value += static_cast<char>(oct_val);
                             continue;
                         } else {
                             log::fatal("unknown escape sequence: " + 
@@ -368,44 +500,58 @@ void Lexer::lex(Token& token) {
                         }
                     }
                 } else {
-                    token.value += curr();  
+                    value += curr();  
                 }
 
                 move();
             }
 
             move();
+            token.value = value;
             break;
+        }
 
         default: if (std::isdigit(curr()) || curr() == '-') {
+            const uint32_t start = m_cursor;
             token.kind = Token::Integer;
 
-            if (curr() == '-') {
-                token.value += curr();
+            if (curr() == '-')
                 move();
-            }
-
-            while (std::isdigit(curr()) || curr() == '.') {
-                if (curr() == '.') {
-                    if (token.kind == Token::Float)
-                        break;
 
-                    token.kind = Token::Float;
-                }
-                    
-                token.value += curr();
+            move(scan::skip_digits(ptr()));
+            if (curr() == '.') {
+                token.kind = Token::Float;
                 move();
+                move(scan::skip_digits(ptr()));
             }
+
+            token.value = m_source.substr(start, m_cursor - start);
         } else if (std::isalpha(curr()) || curr() == '_') {
-            token.kind = Token::Identifier;
-            
-            while (std::isalnum(curr()) || curr() == '_') {
-                token.value += curr();
-                move();
-            }
+            const uint32_t start = m_cursor;
+            move(scan::skip_ident(ptr()));
+
+            const std::string_view ident = 
+                m_source.substr(start, m_cursor - start);
+
+            // Keywords are recognized without touching the symbol table, and
+            // other identifiers are interned straight out of the buffer.
+            token.kind = get_keyword(ident);
+            if (token.kind == Token::Identifier)
+                token.value = ident;
         } else {
             log::fatal("unrecognized token: " + std::to_string(curr()), 
                 log::Location(m_filename, m_loc));
         }
     }
 }
+
+Token::Kind Lexer::get_keyword(std::string_view ident) {
+    if (ident.size() < MinKeywordLength || ident.size() > MaxKeywordLength)
+        return Token::Identifier;
+
+    const uint8_t index = g_keyword_table[hash_keyword(ident, KeywordSeed)];
+    if (index == EmptySlot || g_keywords[index].name != ident)
+        return Token::Identifier;
+
+    return g_keywords[index].kind;
+}
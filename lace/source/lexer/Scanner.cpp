@@ -0,0 +1,286 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/lexer/Scanner.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define LACE_SCAN_X86 1
+#endif
+
+using namespace lace;
+using namespace lace::scan;
+
+namespace {
+
+/// Each character class below says where a run of its characters stops,
+/// either for a single character or as a bitmask over a vector of them.
+
+/// Spaces and tabs.
+struct Blanks final {
+    static bool stops(char c) { return c != ' ' && c != '\t'; }
+
+#ifdef LACE_SCAN_X86
+    static uint32_t stops_sse2(__m128i v) {
+        const __m128i in = _mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+
+        return ~_mm_movemask_epi8(in) & 0xFFFF;
+    }
+
+    [[gnu::target("avx2")]] static uint32_t stops_avx2(__m256i v) {
+        const __m256i in = _mm256_or_si256(
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+
+        return ~static_cast<uint32_t>(_mm256_movemask_epi8(in));
+    }
+#endif
+};
+
+/// Anything but a line break.
+struct Line final {
+    static bool stops(char c) { return c == '\n' || c == '\0'; }
+
+#ifdef LACE_SCAN_X86
+    static uint32_t stops_sse2(__m128i v) {
+        return _mm_movemask_epi8(_mm_or_si128(
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+            _mm_cmpeq_epi8(v, _mm_setzero_si128())));
+    }
+
+    [[gnu::target("avx2")]] static uint32_t stops_avx2(__m256i v) {
+        return _mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+            _mm256_cmpeq_epi8(v, _mm256_setzero_si256())));
+    }
+#endif
+};
+
+/// Decimal digits.
+struct Digits final {
+    static bool stops(char c) { return c < '0' || '9' < c; }
+
+#ifdef LACE_SCAN_X86
+    static uint32_t stops_sse2(__m128i v) {
+        // Bytes past 0x7F compare as negative, so they are never in range.
+        const __m128i in = _mm_and_si128(
+            _mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+            _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+
+        return ~_mm_movemask_epi8(in) & 0xFFFF;
+    }
+
+    [[gnu::target("avx2")]] static uint32_t stops_avx2(__m256i v) {
+        const __m256i in = _mm256_and_si256(
+            _mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+
+        return ~static_cast<uint32_t>(_mm256_movemask_epi8(in));
+    }
+#endif
+};
+
+/// Letters, digits and underscores.
+struct Ident final {
+    static bool stops(char c) {
+        const char lower = c | 0x20;
+        return !(('a' <= lower && lower <= 'z')
+            || ('0' <= c && c <= '9')
+            || c == '_');
+    }
+
+#ifdef LACE_SCAN_X86
+    static uint32_t stops_sse2(__m128i v) {
+        // Setting bit 5 folds upper case letters onto lower case ones.
+        const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        const __m128i alpha = _mm_and_si128(
+            _mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+            _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+
+        const __m128i digit = _mm_and_si128(
+            _mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+            _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+
+        const __m128i in = _mm_or_si128(
+            _mm_or_si128(alpha, digit),
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+
+        return ~_mm_movemask_epi8(in) & 0xFFFF;
+    }
+
+    [[gnu::target("avx2")]] static uint32_t stops_avx2(__m256i v) {
+        const __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        const __m256i alpha = _mm256_and_si256(
+            _mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), lower));
+
+        const __m256i digit = _mm256_and_si256(
+            _mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v));
+
+        const __m256i in = _mm256_or_si256(
+            _mm256_or_si256(alpha, digit),
+            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')));
+
+        return ~static_cast<uint32_t>(_mm256_movemask_epi8(in));
+    }
+#endif
+};
+
+/// Anything but a quote, backslash or null character.
+struct String final {
+    static bool stops(char c) { return c == '"' || c == '\\' || c == '\0'; }
+
+#ifdef LACE_SCAN_X86
+    static uint32_t stops_sse2(__m128i v) {
+        return _mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(
+                _mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+                _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))),
+            _mm_cmpeq_epi8(v, _mm_setzero_si128())));
+    }
+
+    [[gnu::target("avx2")]] static uint32_t stops_avx2(__m256i v) {
+        return _mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+                _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))),
+            _mm256_cmpeq_epi8(v, _mm256_setzero_si256())));
+    }
+#endif
+};
+
+} // namespace
+
+/// Returns the best instruction set supported by the CPU.
+static Level detect_level() {
+#ifdef LACE_SCAN_X86
+    // SSE2 is part of the x86-64 baseline, so only AVX2 needs checking.
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return Level::AVX2;
+
+    return Level::SSE2;
+#else
+    return Level::Scalar;
+#endif
+}
+
+static const Level g_best = detect_level();
+static std::atomic<Level> g_level = g_best;
+
+template<typename C>
+static uint32_t scan_scalar(const char* ptr) {
+    const char* it = ptr;
+    while (!C::stops(*it))
+        ++it;
+
+    return it - ptr;
+}
+
+#ifdef LACE_SCAN_X86
+
+// The vector routines only ever load whole aligned blocks, so they may read
+// past the terminator but never into the next page. Sanitizers would still
+// flag those bytes, since they lie outside of the buffer.
+
+template<typename C>
+[[gnu::no_sanitize_address]] static uint32_t scan_sse2(const char* ptr) {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    const uint32_t offset = addr & 15;
+    const __m128i* block = reinterpret_cast<const __m128i*>(addr - offset);
+
+    // Drop the bytes of the first block that come before |ptr|.
+    uint32_t mask = C::stops_sse2(_mm_load_si128(block)) >> offset;
+    if (mask != 0)
+        return __builtin_ctz(mask);
+
+    uint32_t len = 16 - offset;
+    while (true) {
+        mask = C::stops_sse2(_mm_load_si128(++block));
+        if (mask != 0)
+            return len + __builtin_ctz(mask);
+
+        len += 16;
+    }
+}
+
+template<typename C>
+[[gnu::target("avx2"), gnu::no_sanitize_address]]
+static uint32_t scan_avx2(const char* ptr) {
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+    const uint32_t offset = addr & 31;
+    const __m256i* block = reinterpret_cast<const __m256i*>(addr - offset);
+
+    uint32_t mask = C::stops_avx2(_mm256_load_si256(block)) >> offset;
+    if (mask != 0)
+        return __builtin_ctz(mask);
+
+    uint32_t len = 32 - offset;
+    while (true) {
+        mask = C::stops_avx2(_mm256_load_si256(++block));
+        if (mask != 0)
+            return len + __builtin_ctz(mask);
+
+        len += 32;
+    }
+}
+
+#endif // LACE_SCAN_X86
+
+template<typename C>
+static inline uint32_t scan_run(const char* ptr) {
+    // Most runs between tokens are a single character or none at all, which
+    // are not worth loading a whole vector for.
+    if (C::stops(ptr[0]))
+        return 0;
+
+    if (C::stops(ptr[1]))
+        return 1;
+
+    switch (g_level.load(std::memory_order_relaxed)) {
+#ifdef LACE_SCAN_X86
+        case Level::AVX2:
+            return 1 + scan_avx2<C>(ptr + 1);
+        case Level::SSE2:
+            return 1 + scan_sse2<C>(ptr + 1);
+#endif
+        default:
+            return 1 + scan_scalar<C>(ptr + 1);
+    }
+}
+
+Level scan::get_level() {
+    return g_level.load(std::memory_order_relaxed);
+}
+
+void scan::set_level(Level level) {
+    g_level.store(level < g_best ? level : g_best, std::memory_order_relaxed);
+}
+
+uint32_t scan::skip_blanks(const char* ptr) {
+    return scan_run<Blanks>(ptr);
+}
+
+uint32_t scan::skip_line(const char* ptr) {
+    return scan_run<Line>(ptr);
+}
+
+uint32_t scan::skip_ident(const char* ptr) {
+    return scan_run<Ident>(ptr);
+}
+
+uint32_t scan::skip_digits(const char* ptr) {
+    return scan_run<Digits>(ptr);
+}
+
+uint32_t scan::skip_string(const char* ptr) {
+    return scan_run<String>(ptr);
+}
@@ -10,18 +10,20 @@
 #include "lace/tree/Type.hpp"
 #include "lace/types/SourceLocation.hpp"
 
+#include <optional>
+
 using namespace lace;
 
 Defn* Parser::parse_initial_definition() {
     Runes runes = {};
     parse_rune_decorators(runes);
 
+    if (match(Token::KwLoad))
+        return parse_load_definition();
+
     if (!match(Token::Identifier))
         log::fatal("expected identifier", log::Location(m_file, loc()));
 
-    if (match("load"))
-        return parse_load_definition();
-
     const Token name = curr();
     next();
 
@@ -46,7 +48,7 @@ Defn* Parser::parse_binding_definition(Runes runes, const Token name) {
                     log::Span(m_file, since(dbg_start)));
 
             const SourceLocation param_start = loc();
-            std::string param_name = curr().value;
+            const Symbol param_name = curr().value;
             next();
 
             if (!expect(Token::Colon)) {
@@ -60,7 +62,7 @@ Defn* Parser::parse_binding_definition(Runes runes, const Token name) {
                 *m_context, since(param_start), param_name, {}, param_type);
 
             if (param_name != "_")
-                m_scope->add(param);
+                declare(param);
             
             params.push_back(param);
 
@@ -81,8 +83,17 @@ Defn* Parser::parse_binding_definition(Runes runes, const Token name) {
         QualType ret_type = parse_type_specifier();
 
         BlockStmt* body = nullptr;
+        std::optional<FunctionDefn::DeferredBody> deferred = std::nullopt;
         SourceLocation end = loc();
-        if (match(Token::OpenBrace)) {
+        if (match(Token::OpenBrace) && m_defer_bodies) {
+            deferred = FunctionDefn::DeferredBody { 
+                curr().offset, 
+                loc(), 
+                static_cast<uint32_t>(m_ast->get_scope()->get_defns().size()) 
+            };
+
+            end = skip_block_statement();
+        } else if (match(Token::OpenBrace)) {
             body = static_cast<BlockStmt*>(parse_block_statement());
             end = body->get_span().end;
         } else if (!expect(Token::Semi)) {
@@ -107,9 +118,12 @@ Defn* Parser::parse_binding_definition(Runes runes, const Token name) {
             params, 
             body);
 
-        m_scope->add(defn);
+        if (deferred)
+            defn->set_deferred_body(*deferred);
+
+        declare(defn);
         return defn;
-    } else if (expect("struct")) {
+    } else if (expect(Token::KwStruct)) {
         if (!expect(Token::OpenBrace))
             log::fatal("expected '{'", log::Span(m_file, since(loc())));
 
@@ -164,11 +178,11 @@ Defn* Parser::parse_binding_definition(Runes runes, const Token name) {
         
         defn->set_type(type);
         defn->set_fields(fields);
-        m_scope->add(defn);
+        declare(defn);
         return defn;
-    } else if (expect("enum")) {
+    } else if (expect(Token::KwEnum)) {
         QualType underlying;
-        if (match(Token::Identifier)) {
+        if (match(Token::Identifier) || curr().is_builtin_type()) {
             underlying = parse_type_specifier();
         } else {
             underlying = BuiltinType::get(*m_context, BuiltinType::Int64);
@@ -211,7 +225,7 @@ Defn* Parser::parse_binding_definition(Runes runes, const Token name) {
                         log::Span(m_file, since(dbg_start)));
                 }
 
-                value = std::stoll(curr().value);
+                value = std::stoll(curr().value.str());
                 if (neg)
                     value = -value;
 
@@ -226,7 +240,7 @@ Defn* Parser::parse_binding_definition(Runes runes, const Token name) {
                 type, 
                 value++);
 
-            m_scope->add(variant);
+            declare(variant);
             variants.push_back(variant);
 
             if (match(Token::CloseBrace)) {
@@ -242,7 +256,7 @@ Defn* Parser::parse_binding_definition(Runes runes, const Token name) {
         variants.shrink_to_fit();
 
         defn->set_variants(variants);
-        m_scope->add(defn);
+        declare(defn);
         return defn;
     } else {
         // Assume global variable definition.
@@ -268,7 +282,7 @@ Defn* Parser::parse_binding_definition(Runes runes, const Token name) {
             init, 
             true);
 
-        m_scope->add(var);
+        declare(var);
         return var;
     }
 
@@ -288,5 +302,5 @@ Defn* Parser::parse_load_definition() {
     while (expect(Token::Semi));
 
     return LoadDefn::create(
-        *m_context, SourceSpan(start, path.loc), path.value);
+        *m_context, SourceSpan(start, path.loc), path.value.str());
 }
@@ -11,6 +11,7 @@
 
 #include <cassert>
 #include <string>
+#include <unordered_map>
 
 using namespace lace;
 
@@ -124,7 +125,15 @@ Expr* Parser::parse_initial_expression() {
 
 Expr* Parser::parse_primary_expression() {
     if (match(Token::Identifier)) {
-        return parse_identifier_expression();
+        return parse_named_reference();
+    } else if (match(Token::KwCast)) {
+        return parse_type_cast();
+    } else if (match(Token::KwNull)) {
+        return parse_null_pointer_literal();
+    } else if (match(Token::KwTrue) || match(Token::KwFalse)) {
+        return parse_boolean_literal();
+    } else if (match(Token::KwSizeof)) {
+        return parse_sizeof_operator();
     } else if (match(Token::OpenParen)) {
         return parse_parentheses();
     } else if (match(Token::Integer)) {
@@ -140,20 +149,6 @@ Expr* Parser::parse_primary_expression() {
     }
 }
 
-Expr* Parser::parse_identifier_expression() {
-    if (match("cast")) {
-        return parse_type_cast();
-    } else if (match("null")) {
-        return parse_null_pointer_literal();
-    } else if (match("true") || match("false")) {
-        return parse_boolean_literal();
-    } else if (match("sizeof")) {
-        return parse_sizeof_operator();
-    } else {
-        return parse_named_reference();
-    }
-}
-
 Expr* Parser::parse_prefix_operator() {
     UnaryOp::Operator op = get_unary_op(curr().kind);
     if (UnaryOp::is_prefix(op)) {
@@ -228,7 +223,7 @@ Expr* Parser::parse_postfix_operator() {
             if (!match(Token::Identifier))
                 log::fatal("expected identifier", log::Span(m_file, since(start)));
         
-            const std::string field = curr().value;
+            const Symbol field = curr().value;
             next();
 
             expr = AccessExpr::create(*m_context, since(start), expr, field);
@@ -278,62 +273,70 @@ Expr* Parser::parse_boolean_literal() {
     const Token lit = curr();
     next();
 
-    return BoolLiteral::create(*m_context, lit.loc, lit.value == "true");
+    return BoolLiteral::create(*m_context, lit.loc, lit.kind == Token::KwTrue);
 }
 
 Expr* Parser::parse_integer_literal() {
+    static const std::unordered_map<Symbol, BuiltinType::Kind> suffixes = {
+        { "b", BuiltinType::Int8 },
+        { "ub", BuiltinType::UInt8 },
+        { "s", BuiltinType::Int16 },
+        { "us", BuiltinType::UInt16 },
+        { "i", BuiltinType::Int32 },
+        { "ui", BuiltinType::UInt32 },
+        { "l", BuiltinType::Int64 },
+        { "ul", BuiltinType::UInt64 },
+    };
+
     const Token lit = curr();
     next();
 
     BuiltinType::Kind kind = BuiltinType::Int64;
-    if (expect("b")) {
-        kind = BuiltinType::Int8;
-    } else if (expect("ub")) {
-        kind = BuiltinType::UInt8;
-    } else if (expect("s")) {
-        kind = BuiltinType::Int16;
-    } else if (expect("us")) {
-        kind = BuiltinType::UInt16;
-    } else if (expect("i")) {
-        kind = BuiltinType::Int32;
-    } else if (expect("ui")) {
-        kind = BuiltinType::UInt32;
-    } else if (expect("l")) {
-        kind = BuiltinType::Int64;
-    } else if (expect("ul")) {
-        kind = BuiltinType::UInt64;
+    if (match(Token::Identifier)) {
+        auto it = suffixes.find(curr().value);
+        if (it != suffixes.end()) {
+            kind = it->second;
+            next();
+        }
     }
 
     return IntegerLiteral::create(
         *m_context, 
         lit.loc, 
         BuiltinType::get(*m_context, kind), 
-        std::stoll(lit.value));
+        std::stoll(lit.value.str()));
 }
 
 Expr* Parser::parse_floating_point_literal() {
+    static const std::unordered_map<Symbol, BuiltinType::Kind> suffixes = {
+        { "f", BuiltinType::Float32 },
+        { "d", BuiltinType::Float64 },
+    };
+
     const Token lit = curr();
     next();
 
     BuiltinType::Kind kind = BuiltinType::Float64;
-    if (expect("f")) {
-        kind = BuiltinType::Float32;
-    } else if (expect("d")) {
-        kind = BuiltinType::Float64;
+    if (match(Token::Identifier)) {
+        auto it = suffixes.find(curr().value);
+        if (it != suffixes.end()) {
+            kind = it->second;
+            next();
+        }
     }
 
     return FloatLiteral::create(
         *m_context, 
         lit.loc, 
         BuiltinType::get(*m_context, kind), 
-        std::stod(lit.value));
+        std::stod(lit.value.str()));
 }
 
 Expr* Parser::parse_character_literal() {
     const Token lit = curr();
     next();
 
-    return CharLiteral::create(*m_context, lit.loc, lit.value[0]);
+    return CharLiteral::create(*m_context, lit.loc, lit.value.str()[0]);
 }
 
 Expr* Parser::parse_null_pointer_literal() {
@@ -350,7 +353,7 @@ Expr* Parser::parse_string_literal() {
     const Token lit = curr();
     next();
 
-    return StringLiteral::create(*m_context, lit.loc, lit.value);
+    return StringLiteral::create(*m_context, lit.loc, lit.value.str());
 }
 
 Expr* Parser::parse_type_cast() {
@@ -12,7 +12,7 @@ void Parser::parse_rune_decorators(Runes& runes) {
     if (!expect(Token::Sign))
         return;
 
-    static std::unordered_map<std::string, Rune::Kind> table = {
+    static const std::unordered_map<Symbol, Rune::Kind> table = {
         { "public", Rune::Public },
         { "private", Rune::Private },
     };
@@ -29,10 +29,10 @@ void Parser::parse_rune_decorators(Runes& runes) {
 
             auto it = table.find(curr().value);
             if (it == table.end())
-                log::error("unknown rune: " + curr().value);
+                log::error("unknown rune: " + curr().value.str());
 
             next();
-            runes.push_back(new Rune(it->second, {}));
+            runes.push_back(new (m_context->get_arena()) Rune(it->second, {}));
 
             if (expect(Token::CloseBrack))
                 break;
@@ -51,9 +51,9 @@ void Parser::parse_rune_decorators(Runes& runes) {
 
         auto it = table.find(curr().value);
         if (it == table.end())
-            log::error("unknown rune: " + curr().value);
+            log::error("unknown rune: " + curr().value.str());
 
         next();
-        runes.push_back(new Rune(it->second, {}));
+        runes.push_back(new (m_context->get_arena()) Rune(it->second, {}));
     }
 }
@@ -19,7 +19,7 @@ Stmt* Parser::parse_initial_statement() {
         return parse_block_statement();
     //} else if (match("asm")) {
     //   return parse_inline_assembly_statement();
-    } else if (match("let")) {
+    } else if (match(Token::KwLet)) {
         return parse_declarative_statement();
     } else {
         return parse_control_statement();
@@ -156,14 +156,36 @@ Stmt* Parser::parse_block_statement() {
     return BlockStmt::create(*m_context, SourceSpan(start, end), scope, stmts);
 }
 
+SourceLocation Parser::skip_block_statement() {
+    const SourceLocation start = loc();
+
+    uint32_t depth = 0;
+    while (true) {
+        if (match(Token::OpenBrace)) {
+            ++depth;
+        } else if (match(Token::CloseBrace)) {
+            if (--depth == 0)
+                break;
+        } else if (curr().is_eof()) {
+            log::fatal("expected '}'", log::Span(m_file, since(start)));
+        }
+
+        next();
+    }
+
+    const SourceLocation end = loc();
+    next(); // '}'
+    return end;
+}
+
 Stmt* Parser::parse_control_statement() {
     const Token ctrl = curr();
     
-    if (expect("stop")) {
+    if (expect(Token::KwStop)) {
         return StopStmt::create(*m_context, since(ctrl.loc));
-    } else if (expect("restart")) {
+    } else if (expect(Token::KwRestart)) {
         return RestartStmt::create(*m_context, since(ctrl.loc));
-    } else if (expect("ret")) {
+    } else if (expect(Token::KwRet)) {
         Expr* expr = nullptr;
         if (!expect(Token::Semi)) {
             expr = parse_initial_expression();
@@ -172,7 +194,7 @@ Stmt* Parser::parse_control_statement() {
         }
 
         return RetStmt::create(*m_context, since(ctrl.loc), expr);
-    } else if (expect("if")) {
+    } else if (expect(Token::KwIf)) {
         Expr* cond = parse_initial_expression();
         assert(cond && "unable to parse 'if' condition!");
 
@@ -180,14 +202,14 @@ Stmt* Parser::parse_control_statement() {
         assert(then_body && "unable to parse 'if' then body!");
 
         Stmt* else_body = nullptr;
-        if (expect("else")) {
+        if (expect(Token::KwElse)) {
             else_body = parse_initial_statement();
             assert(else_body && "unable to parse 'if' else body!");
         }
 
         return IfStmt::create(
             *m_context, since(ctrl.loc), cond, then_body, else_body);
-    } else if (expect("until")) {
+    } else if (expect(Token::KwUntil)) {
         Expr* cond = parse_initial_expression();
         if (!cond)
             log::fatal("expected 'until' condition", log::Span(m_file, since(loc())));
@@ -216,7 +238,7 @@ Stmt* Parser::parse_declarative_statement() {
     if (!match(Token::Identifier))
         log::fatal("expected identifier", log::Span(m_file, since(loc())));
 
-    const std::string name = curr().value;
+    const Symbol name = curr().value;
     next();
 
     if (!expect(Token::Colon))
@@ -245,6 +267,6 @@ Stmt* Parser::parse_declarative_statement() {
         init,
         false);
 
-    m_scope->add(var);
+    declare(var);
     return AdapterStmt::create(*m_context, var);
 }
@@ -4,19 +4,25 @@
 //
 
 #include "lace/core/Diagnostics.hpp"
+#include "lace/core/ThreadPool.hpp"
 #include "lace/lexer/Lexer.hpp"
 #include "lace/parser/Parser.hpp"
 #include "lace/tree/AST.hpp"
 #include "lace/tree/Defn.hpp"
+#include "lace/tree/Stmt.hpp"
 #include "lace/tree/Type.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <string>
-#include <unordered_set>
+#include <vector>
 
 using namespace lace;
 
-Parser::Parser(const std::string& source, const std::string& path)
-  : m_file(path), m_lexer(source, path) {}
+Parser::Parser(std::string_view source, const std::string& path, 
+               bool defer_bodies)
+  : m_file(path), m_lexer(source, path), m_tokens(m_lexer), 
+    m_defer_bodies(defer_bodies) {}
 
 AST* Parser::parse() {
     m_ast = AST::create(m_file);
@@ -25,34 +31,125 @@ AST* Parser::parse() {
 
     next(); // Lex the first token.
 
-    while (!m_lexer.is_eof()) {
+    // The lexer may already be past the current token if it was peeked
+    // beyond, so the end of input is found by the token instead.
+    while (!curr().is_eof()) {
         Defn* defn = parse_initial_definition();
         if (!defn)
             log::fatal("expected definition", log::Location(m_file, loc()));
 
         m_ast->get_defns().push_back(defn);
+
+        // Every top-level definition besides loads is named. Public ones are
+        // gathered here once, rather than by every file that loads this one.
+        if (!defn->is_load()) {
+            NamedDefn* named = static_cast<NamedDefn*>(defn);
+            if (named->has_rune(Rune::Public))
+                m_ast->get_exports().push_back(named);
+        }
     }
 
     return m_ast;
 }
 
-bool Parser::is_reserved(const std::string& ident) const {
-    static std::unordered_set<std::string> keywords = {
-        "void", "bool", "char", 
-        "s8", "s16", "s32", "s64", 
-        "u8", "u16", "u32", "u64",
-        "f32", "f64",
-        "mut", "struct", "enum", "union",
-        "let", "ret", "stop", "until", "if", "restart",
-    };
-
-    return keywords.contains(ident);
+void Parser::parse_body(std::string_view source, AST* ast, 
+                        AST::Context& context, FunctionDefn* function) {
+    assert(function->has_deferred_body() && "function has no deferred body!");
+    const FunctionDefn::DeferredBody deferred = *function->get_deferred_body();
+
+    Parser parser(source, ast->get_file());
+    parser.m_ast = ast;
+    parser.m_context = &context;
+    parser.m_scope = function->get_scope();
+
+    // Only the names that the body could see where it was skipped over are
+    // made visible, so that it resolves the same as if parsed in place.
+    const Scope::Defns& globals = ast->get_scope()->get_defns();
+    for (uint32_t i = 0; i < deferred.visible; ++i)
+        parser.m_symbols.add(globals[i]);
+
+    parser.m_symbols.enter(function->get_scope());
+
+    parser.m_lexer.seek(deferred.offset, deferred.loc);
+    parser.next();
+
+    function->set_body(static_cast<BlockStmt*>(
+        parser.parse_block_statement()));
+    function->clear_deferred_body();
+}
+
+void Parser::parse_bodies(std::string_view source, AST* ast, 
+                          ThreadPool* pool) {
+    std::vector<FunctionDefn*> functions = {};
+    for (Defn* defn : ast->get_defns()) {
+        FunctionDefn* function = dynamic_cast<FunctionDefn*>(defn);
+        if (function && function->has_deferred_body())
+            functions.push_back(function);
+    }
+
+    if (!pool) {
+        for (FunctionDefn* function : functions)
+            parse_body(source, ast, ast->get_context(), function);
+
+        return;
+    }
+
+    // Functions are dealt out to a few jobs per worker, each of which 
+    // allocates in a fork of its own so that none of them have to lock.
+    const uint32_t jobs = std::min<uint32_t>(functions.size(), pool->size() * 4);
+
+    std::vector<AST::Context*> forks(jobs, nullptr);
+    for (AST::Context*& fork : forks)
+        fork = &ast->get_context().fork();
+
+    pool->parallel_for(0, jobs, [&](uint32_t job) {
+        for (uint32_t i = job; i < functions.size(); i += jobs)
+            parse_body(source, ast, *forks[job], functions[i]);
+    });
+}
+
+bool Parser::is_reserved(Symbol ident) const {
+    return Lexer::get_keyword(ident.str()) != Token::Identifier;
+}
+
+BuiltinType::Kind Parser::get_builtin_type(Token::Kind kind) const {
+    switch (kind) {
+        case Token::KwVoid:
+            return BuiltinType::Void;
+        case Token::KwBool:
+            return BuiltinType::Bool;
+        case Token::KwChar:
+            return BuiltinType::Char;
+        case Token::KwS8:
+            return BuiltinType::Int8;
+        case Token::KwS16:
+            return BuiltinType::Int16;
+        case Token::KwS32:
+            return BuiltinType::Int32;
+        case Token::KwS64:
+            return BuiltinType::Int64;
+        case Token::KwU8:
+            return BuiltinType::UInt8;
+        case Token::KwU16:
+            return BuiltinType::UInt16;
+        case Token::KwU32:
+            return BuiltinType::UInt32;
+        case Token::KwU64:
+            return BuiltinType::UInt64;
+        case Token::KwF32:
+            return BuiltinType::Float32;
+        case Token::KwF64:
+            return BuiltinType::Float64;
+        default:
+            assert(false && "token is not a builtin type!");
+            return BuiltinType::Void;
+    }
 }
 
 QualType Parser::parse_type_specifier() {
     QualType type = {};
 
-    while (expect("mut")) {
+    while (expect(Token::KwMut)) {
         if (type.is_mut()) {
             log::warn("duplicate 'mut' keyword", log::Location(m_file, loc()));
         } else {
@@ -67,7 +164,7 @@ QualType Parser::parse_type_specifier() {
         if (!match(Token::Integer))
             log::fatal("expected integer after '['", log::Location(m_file, loc()));
 
-        int32_t size = std::stoi(curr().value);
+        int32_t size = std::stoi(curr().value.str());
         if (size <= 0)
             log::fatal("array size must be greater than 0", log::Location(m_file, loc()));
 
@@ -78,30 +175,13 @@ QualType Parser::parse_type_specifier() {
 
         type.set_type(ArrayType::get(*m_context, parse_type_specifier(), size));
         return type;
+    } else if (curr().is_builtin_type()) {
+        const BuiltinType::Kind kind = get_builtin_type(curr().kind);
+        type.set_type(BuiltinType::get(*m_context, kind));
+        next();
+        return type;
     } else if (match(Token::Identifier)) {
-        std::unordered_map<std::string, const Type*> types = {
-            { "void", BuiltinType::get(*m_context, BuiltinType::Void) },
-            { "bool", BuiltinType::get(*m_context, BuiltinType::Bool) },
-            { "char", BuiltinType::get(*m_context, BuiltinType::Char) },
-            { "s8", BuiltinType::get(*m_context, BuiltinType::Int8) },
-            { "s16", BuiltinType::get(*m_context, BuiltinType::Int16) },
-            { "s32", BuiltinType::get(*m_context, BuiltinType::Int32) },
-            { "s64", BuiltinType::get(*m_context, BuiltinType::Int64) },
-            { "u8", BuiltinType::get(*m_context, BuiltinType::UInt8) },
-            { "u16", BuiltinType::get(*m_context, BuiltinType::UInt16) },
-            { "u32", BuiltinType::get(*m_context, BuiltinType::UInt32) },
-            { "u64", BuiltinType::get(*m_context, BuiltinType::UInt64) },
-            { "f32", BuiltinType::get(*m_context, BuiltinType::Float32) },
-            { "f64", BuiltinType::get(*m_context, BuiltinType::Float64) },
-        };
-
-        auto it = types.find(curr().value);
-        if (it != types.end()) {
-            type.set_type(it->second);
-        } else {
-            type.set_type(DeferredType::get(*m_context, curr().value));
-        }
-
+        type.set_type(DeferredType::get(*m_context, curr().value));
         next();
         return type;
     } else {
@@ -0,0 +1,67 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/tools/Cache.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+#include <unistd.h>
+
+using namespace lace;
+
+std::string Cache::get_path(uint64_t key) const {
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx.o",
+        static_cast<unsigned long long>(key));
+
+    return (std::filesystem::path(m_dir) / name).string();
+}
+
+bool Cache::load(uint64_t key, std::string& object) const {
+    std::ifstream file(get_path(key), std::ios::binary);
+    if (!file || !file.is_open())
+        return false;
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    if (file.bad())
+        return false;
+
+    object = contents.str();
+    return true;
+}
+
+void Cache::store(uint64_t key, const std::string& object) const {
+    std::error_code err;
+    std::filesystem::create_directories(m_dir, err);
+    if (err)
+        return;
+
+    const std::string path = get_path(key);
+    const std::string temp = path + '.' + std::to_string(getpid()) + '.' + 
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    std::ofstream file(temp, std::ios::binary);
+    if (!file || !file.is_open())
+        return;
+
+    file << object;
+    file.close();
+
+    if (!file) {
+        std::filesystem::remove(temp, err);
+        return;
+    }
+
+    std::filesystem::rename(temp, path, err);
+    if (err)
+        std::filesystem::remove(temp, err);
+}
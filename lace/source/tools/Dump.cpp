@@ -0,0 +1,88 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/core/Diagnostics.hpp"
+#include "lace/tools/Dump.hpp"
+
+#include <fstream>
+
+using namespace lace;
+
+DumpBuffer::Buf::int_type DumpBuffer::Buf::overflow(int_type ch) {
+    if (!traits_type::eq_int_type(ch, traits_type::eof()))
+        m_text.push_back(traits_type::to_char_type(ch));
+
+    return traits_type::not_eof(ch);
+}
+
+std::streamsize DumpBuffer::Buf::xsputn(const char* str, std::streamsize n) {
+    m_text.append(str, n);
+    return n;
+}
+
+DumpBuffer::DumpBuffer() : std::ostream(nullptr), m_buf(m_text) {
+    m_text.reserve(InitialCapacity);
+    rdbuf(&m_buf);
+}
+
+std::string DumpBuffer::take() {
+    std::string text = std::move(m_text);
+    m_text.clear();
+    return text;
+}
+
+DumpWriter::DumpWriter() : m_thread([this] { work(); }) {}
+
+DumpWriter::~DumpWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_cond.notify_one();
+    m_thread.join();
+}
+
+void DumpWriter::work() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        m_cond.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty())
+            return;
+
+        Entry entry = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_busy = true;
+        lock.unlock();
+
+        std::ofstream file(entry.first, std::ios::binary);
+        if (!file || !file.is_open()) {
+            log::warn("failed to open: " + entry.first);
+        } else {
+            file.write(entry.second.data(), entry.second.size());
+            file.close();
+        }
+
+        lock.lock();
+        m_busy = false;
+        if (m_queue.empty())
+            m_idle.notify_all();
+    }
+}
+
+void DumpWriter::submit(std::string path, std::string text) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.emplace_back(std::move(path), std::move(text));
+    }
+
+    m_cond.notify_one();
+}
+
+void DumpWriter::finish() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+}
@@ -9,14 +9,66 @@
 #include <cstdint>
 #include <fstream>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 using namespace lace;
 
+MappedFile::MappedFile(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        log::fatal("failed to open file: " + path);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        log::fatal("failed to read file: " + path);
+    }
+
+    m_size = st.st_size;
+    if (m_size == 0) {
+        close(fd);
+        return;
+    }
+
+    // Reserve zeroed pages for one byte more than the file first, and then
+    // map the file over the start of them. The tail of the last file page is
+    // zeroed by the kernel, and if the file fills it, then the terminator 
+    // comes from the reserved page after it.
+    const uint64_t page = sysconf(_SC_PAGESIZE);
+    m_mapped = (m_size + page) / page * page;
+
+    void* base = mmap(nullptr, m_mapped, PROT_READ, 
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        log::fatal("failed to map file: " + path);
+    }
+
+    void* file = mmap(base, m_size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+    close(fd);
+
+    if (file == MAP_FAILED) {
+        munmap(base, m_mapped);
+        log::fatal("failed to map file: " + path);
+    }
+
+    m_data = static_cast<const char*>(base);
+}
+
+MappedFile::~MappedFile() {
+    if (m_mapped != 0)
+        munmap(const_cast<char*>(m_data), m_mapped);
+}
+
 std::string lace::read_file(const std::string& path) {
-    std::ifstream file(path, std::ios::ate);
+    std::ifstream file(path, std::ios::ate | std::ios::binary);
     if (!file || !file.is_open())
         log::fatal("failed to open file: " + path);
 
-    uint32_t size = file.tellg();
+    const std::size_t size = file.tellg();
     std::string contents;
     contents.resize(size);
     file.seekg(std::ios::beg);
@@ -0,0 +1,79 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/tools/SourceManager.hpp"
+
+#include <algorithm>
+
+using namespace lace;
+
+void SourceBuffer::index_lines() const {
+    std::call_once(m_once, [this] {
+        m_lines.push_back(0);
+        for (uint32_t i = 0, e = m_text.size(); i < e; ++i)
+            if (m_text[i] == '\n')
+                m_lines.push_back(i + 1);
+    });
+}
+
+uint32_t SourceBuffer::num_lines() const {
+    index_lines();
+    return m_lines.size();
+}
+
+std::string_view SourceBuffer::get_line(uint32_t line) const {
+    index_lines();
+    if (line == 0 || line > m_lines.size())
+        return {};
+
+    const uint32_t start = m_lines[line - 1];
+    const uint32_t end = line < m_lines.size() 
+        ? m_lines[line] - 1 
+        : m_text.size();
+
+    return m_text.substr(start, end - start);
+}
+
+SourceLocation SourceBuffer::get_location(uint32_t offset) const {
+    index_lines();
+
+    // The line is the last one to start at or before |offset|.
+    auto it = std::upper_bound(m_lines.begin(), m_lines.end(), offset);
+    const uint32_t line = it - m_lines.begin();
+    return SourceLocation(line, offset - m_lines[line - 1] + 1);
+}
+
+const SourceBuffer& SourceManager::add(const std::string& path, 
+                                       std::string text) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_buffers.find(path);
+    if (it == m_buffers.end()) {
+        it = m_buffers.emplace(path, 
+            std::make_unique<SourceBuffer>(path, std::move(text))).first;
+    }
+
+    return *it->second;
+}
+
+const SourceBuffer* SourceManager::get(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_buffers.find(path);
+    return it != m_buffers.end() ? it->second.get() : nullptr;
+}
+
+const SourceBuffer& SourceManager::load(const std::string& path) {
+    if (const SourceBuffer* buffer = get(path))
+        return *buffer;
+
+    // Map outside of the lock, so that other lookups are not held up by the
+    // disk. Should another thread race us here, the first buffer is kept.
+    auto buffer = std::make_unique<SourceBuffer>(path, 
+        std::make_unique<MappedFile>(path));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return *m_buffers.emplace(path, std::move(buffer)).first->second;
+}
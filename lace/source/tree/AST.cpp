@@ -16,57 +16,18 @@ AST::Context::Context() {
          i <= static_cast<uint32_t>(BuiltinType::Float64); 
          ++i) {
         BuiltinType::Kind kind = static_cast<BuiltinType::Kind>(i);
-        m_builtins.push_back(new BuiltinType(kind));
+        m_builtins.push_back(new (m_arena) BuiltinType(*this, kind));
     }
 }
 
-AST::Context::~Context() {
-    for (auto& [name, type] : m_aliases)
-        delete type;
-
-    for (auto& type : m_arrays)
-        delete type;
-
-    for (auto& type : m_builtins)
-        delete type;
-
-    for (auto& type : m_deferred)
-        delete type;
-
-    for (auto& [name, type] : m_enums)
-        delete type;
-
-    for (auto& type : m_functions)
-        delete type;
-
-    for (auto& type : m_pointers)
-        delete type;
-
-    for (auto& [name, type] : m_structs)
-        delete type;
-
-    m_aliases.clear();
-    m_arrays.clear();
-    m_builtins.clear();
-    m_deferred.clear();
-    m_enums.clear();
-    m_functions.clear();
-    m_pointers.clear();
-    m_structs.clear();
+AST::Context& AST::Context::fork() {
+    m_root->m_forked = true;
+    m_forks.emplace_back(new Context(*m_root));
+    return *m_forks.back();
 }
 
 AST::AST(const std::string& file) : m_file(file) {
-    m_scope = new Scope();
-}
-
-AST::~AST() {
-    delete m_scope;
-    m_scope = nullptr;
-
-    for (Defn* defn : m_defns)
-        delete defn;
-
-    m_defns.clear();
+    m_scope = new (m_context.get_arena()) Scope();
 }
 
 AST* AST::create(const std::string& file) {
@@ -13,75 +13,57 @@ using namespace lace;
 
 BoolLiteral* BoolLiteral::create(AST::Context& ctx, SourceSpan span, 
                                  bool value) {
-    return new BoolLiteral(
+    return new (ctx.get_arena()) BoolLiteral(
         span, BuiltinType::get(ctx, BuiltinType::Bool), value);
 }
 
 CharLiteral* CharLiteral::create(AST::Context& ctx, SourceSpan span, char value) {
-    return new CharLiteral(
+    return new (ctx.get_arena()) CharLiteral(
         span, BuiltinType::get(ctx, BuiltinType::Char), value);
 }
 
 IntegerLiteral* IntegerLiteral::create(AST::Context& ctx, SourceSpan span, 
                                        const QualType& type, int64_t value) {
-    return new IntegerLiteral(span, type, value);
+    return new (ctx.get_arena()) IntegerLiteral(span, type, value);
 }
 
 FloatLiteral* FloatLiteral::create(AST::Context& ctx, SourceSpan span, 
                                    const QualType& type, double value) {
-    return new FloatLiteral(span, type, value);
+    return new (ctx.get_arena()) FloatLiteral(span, type, value);
 }
 
 NullLiteral* NullLiteral::create(AST::Context& ctx, SourceSpan span, 
                                  const QualType& type) {
-    return new NullLiteral(span, type);
+    return new (ctx.get_arena()) NullLiteral(span, type);
 }
 
 StringLiteral* StringLiteral::create(AST::Context& ctx, SourceSpan span, 
                                      const std::string& value) {
-    return new StringLiteral(
+    return new (ctx.get_arena()) StringLiteral(
         span, 
         PointerType::get(ctx, BuiltinType::get(ctx, BuiltinType::Char)),
         value);
 }
 
-BinaryOp::~BinaryOp() {
-    delete m_lhs;
-    m_lhs = nullptr;
-
-    delete m_rhs;
-    m_rhs = nullptr;
-}
-
 BinaryOp* BinaryOp::create(AST::Context& ctx, SourceSpan span, Operator op, 
                            Expr* lhs, Expr* rhs) {
     assert(op != Unknown && "invalid operator!");
     assert(lhs && "invalid left operand!");
     assert(rhs && "invalid right operand!");
-    return new BinaryOp(span, lhs->get_type(), op, lhs, rhs);
-}
-
-UnaryOp::~UnaryOp() {
-    delete m_expr;
-    m_expr = nullptr;
+    return new (ctx.get_arena()) BinaryOp(span, lhs->get_type(), op, lhs, rhs);
 }
 
 UnaryOp* UnaryOp::create(AST::Context& ctx, SourceSpan span, Operator op, 
                          bool prefix, Expr* expr) {
     assert(op != Unknown && "invalid operator!");
     assert(expr && "invalid operand!");
-    return new UnaryOp(span, expr->get_type(), op, prefix, expr);
-}
-
-AccessExpr::~AccessExpr() {
-    delete m_base;
-    m_base = nullptr;
+    return new (ctx.get_arena()) UnaryOp(span, expr->get_type(), op, prefix, expr);
 }
 
 AccessExpr* AccessExpr::create(AST::Context& ctx, SourceSpan span, Expr* base, 
-                               const std::string& name) {
+                               Symbol name) {
     assert(base && "invalid access base expression!");
-    return new AccessExpr(
+    return new (ctx.get_arena()) AccessExpr(
         span, 
         {},
         base, 
@@ -89,47 +71,27 @@ AccessExpr* AccessExpr::create(AST::Context& ctx, SourceSpan span, Expr* base,
         nullptr);
 }
 
-CallExpr::~CallExpr() {
-    delete m_callee;
-    m_callee = nullptr;
-    
-    for (Expr* arg : m_args)
-        delete arg;
-
-    m_args.clear();
-}
-
 CallExpr* CallExpr::create(AST::Context& ctx, SourceSpan span, Expr* callee, 
                            const Args& args) {
     assert(callee && "invalid callee expression!");
-    return new CallExpr(
+    return new (ctx.get_arena()) CallExpr(
         span, callee ? callee->get_type() : nullptr, callee, args);
 }
 
-CastExpr::~CastExpr() {
-    delete m_expr;
-    m_expr = nullptr;
-}
-
 CastExpr* CastExpr::create(AST::Context& ctx, SourceSpan span, 
                            const QualType& type, Expr* expr) {
     assert(expr && "invalid cast expression!");
-    return new CastExpr(span, type, expr);
-}
-
-ParenExpr::~ParenExpr() {
-    delete m_expr;
-    m_expr = nullptr;
+    return new (ctx.get_arena()) CastExpr(span, type, expr);
 }
 
 ParenExpr* ParenExpr::create(AST::Context& ctx, SourceSpan span, Expr* expr) {
     assert(expr && "invalid parentheses expression!");
-    return new ParenExpr(span, expr->get_type(), expr);
+    return new (ctx.get_arena()) ParenExpr(span, expr->get_type(), expr);
 }
 
 RefExpr* RefExpr::create(AST::Context& ctx, SourceSpan span, 
-                         const std::string& name, const ValueDefn* defn) {
-    return new RefExpr(span, defn ? defn->get_type() : nullptr, name, defn);
+                         Symbol name, const ValueDefn* defn) {
+    return new (ctx.get_arena()) RefExpr(span, defn ? defn->get_type() : nullptr, name, defn);
 }
 
 bool RefExpr::is_lvalue() const {
@@ -141,21 +103,13 @@ bool RefExpr::is_lvalue() const {
 
 SizeofExpr* SizeofExpr::create(AST::Context& ctx, SourceSpan span, 
                                const QualType& target) {
-    return new SizeofExpr(
+    return new (ctx.get_arena()) SizeofExpr(
         span, BuiltinType::get(ctx, BuiltinType::UInt64), target);
 }
 
-SubscriptExpr::~SubscriptExpr() {
-    delete m_base;
-    m_base = nullptr;
-
-    delete m_index;
-    m_index = nullptr;
-}
-
 SubscriptExpr* SubscriptExpr::create(AST::Context& ctx, SourceSpan span, 
                                      Expr* base, Expr* index) {
     assert(base && "invalid base expression!");
     assert(index && "invalid index expression!");
-    return new SubscriptExpr(span, base->get_type(), base, index);
+    return new (ctx.get_arena()) SubscriptExpr(span, base->get_type(), base, index);
 }
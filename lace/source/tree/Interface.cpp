@@ -0,0 +1,452 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/tree/AST.hpp"
+#include "lace/tree/Defn.hpp"
+#include "lace/tree/Interface.hpp"
+#include "lace/tree/Rune.hpp"
+#include "lace/tree/Scope.hpp"
+#include "lace/tree/Type.hpp"
+
+#include <cstring>
+
+using namespace lace;
+
+//
+//  Interfaces are laid out as a header of a magic number, a format version,
+//  the hash of the source and the stamp of the files it loads, followed by the
+//  number of definitions and then each of them in the order they appear in the
+//  source. Integers are written in host byte order, as interfaces are only read
+//  back by the same machine.
+//
+//  Every definition starts with its kind. A load is followed by its path. A
+//  named definition is followed by its name and rune kinds, and then:
+//
+//    Function: the function type, the parameter count and parameter names.
+//    Variable: the type.
+//    Struct:   the field count, then the name and type of each field.
+//    Enum:     the underlying type, the variant count, then the name and
+//              value of each variant.
+//    Alias:    the underlying type.
+//
+//  Types are written as their class and qualifiers, followed by the kind of
+//  built-in types, the size and element type of arrays, the pointee of
+//  pointers, the return and parameter types of functions, and the name of
+//  every named type.
+//
+
+/// The magic number that starts every interface, "LIF" and a null byte.
+static constexpr uint32_t Magic = 0x0046494c;
+
+/// The version of the interface format, bumped on any change to the layout.
+static constexpr uint32_t Version = 2;
+
+namespace {
+
+/// Serializes the parts of a tree that make up its interface.
+class InterfaceWriter final {
+    std::ostream& m_out;
+
+    template<typename T>
+    void put(T value) {
+        m_out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void put_string(std::string_view str) {
+        put<uint32_t>(str.size());
+        m_out.write(str.data(), str.size());
+    }
+
+    void put_runes(const NamedDefn* defn) {
+        put<uint8_t>(defn->num_runes());
+        for (const Rune* rune : defn->get_runes())
+            put<uint8_t>(rune->get_kind());
+    }
+
+    void put_type(const QualType& type) {
+        put<uint8_t>(type->get_class());
+        put<uint32_t>(type.get_qualifiers());
+
+        switch (type->get_class()) {
+            case Type::Alias:
+                put_string(static_cast<const AliasType*>(type.get_type())
+                    ->get_defn()->get_name());
+                break;
+
+            case Type::Array: {
+                const ArrayType* array = static_cast<const ArrayType*>(
+                    type.get_type());
+
+                put<uint32_t>(array->get_size());
+                put_type(array->get_element_type());
+                break;
+            }
+
+            case Type::Builtin:
+                put<uint8_t>(static_cast<const BuiltinType*>(type.get_type())
+                    ->get_kind());
+                break;
+
+            case Type::Deferred:
+                put_string(static_cast<const DeferredType*>(type.get_type())
+                    ->get_name());
+                break;
+
+            case Type::Enum:
+                put_string(static_cast<const EnumType*>(type.get_type())
+                    ->get_defn()->get_name());
+                break;
+
+            case Type::Function: {
+                const FunctionType* function =
+                    static_cast<const FunctionType*>(type.get_type());
+
+                put_type(function->get_return_type());
+                put<uint32_t>(function->num_params());
+                for (const QualType& param : function->get_params())
+                    put_type(param);
+                break;
+            }
+
+            case Type::Pointer:
+                put_type(static_cast<const PointerType*>(type.get_type())
+                    ->get_pointee());
+                break;
+
+            case Type::Struct:
+                put_string(static_cast<const StructType*>(type.get_type())
+                    ->get_defn()->get_name());
+                break;
+        }
+    }
+
+public:
+    InterfaceWriter(std::ostream& out) : m_out(out) {}
+
+    void run(const AST* ast, uint64_t hash, uint64_t deps) {
+        // Private functions and globals are left out, as nothing outside of
+        // the tree can refer to them. Every type is kept, as even private
+        // ones can reach other files through public signatures.
+        std::vector<const Defn*> defns = {};
+        for (const Defn* defn : ast->get_defns()) {
+            if (const auto* value = dynamic_cast<const ValueDefn*>(defn))
+                if (!value->has_rune(Rune::Public))
+                    continue;
+
+            defns.push_back(defn);
+        }
+
+        put<uint32_t>(Magic);
+        put<uint32_t>(Version);
+        put<uint64_t>(hash);
+        put<uint64_t>(deps);
+        put<uint32_t>(defns.size());
+
+        for (const Defn* defn : defns) {
+            put<uint8_t>(defn->get_kind());
+
+            if (const auto* load = dynamic_cast<const LoadDefn*>(defn)) {
+                put_string(load->get_path());
+                continue;
+            }
+
+            const NamedDefn* named = static_cast<const NamedDefn*>(defn);
+            put_string(named->get_name());
+            put_runes(named);
+
+            if (const auto* function = dynamic_cast<const FunctionDefn*>(defn)) {
+                put_type(function->get_type());
+                put<uint32_t>(function->num_params());
+                for (const ParameterDefn* param : function->get_params())
+                    put_string(param->get_name());
+            } else if (const auto* var = dynamic_cast<const VariableDefn*>(defn)) {
+                put_type(var->get_type());
+            } else if (const auto* structure = dynamic_cast<const StructDefn*>(defn)) {
+                put<uint32_t>(structure->num_fields());
+                for (const FieldDefn* field : structure->get_fields()) {
+                    put_string(field->get_name());
+                    put_type(field->get_type());
+                }
+            } else if (const auto* enumeration = dynamic_cast<const EnumDefn*>(defn)) {
+                put_type(static_cast<const EnumType*>(enumeration->get_type())
+                    ->get_underlying());
+                put<uint32_t>(enumeration->num_variants());
+                for (const VariantDefn* variant : enumeration->get_variants()) {
+                    put_string(variant->get_name());
+                    put<int64_t>(variant->get_value());
+                }
+            } else if (const auto* alias = dynamic_cast<const AliasDefn*>(defn)) {
+                put_type(static_cast<const AliasType*>(alias->get_type())
+                    ->get_underlying());
+            }
+        }
+    }
+};
+
+/// Rebuilds a tree out of a serialized interface.
+///
+/// Any read past the end of the data, or of a value that is out of range,
+/// marks the reader as failed. Reads after that return zeroed values, so the
+/// tree is still built to completion, and is thrown away at the end.
+class InterfaceReader final {
+    std::string_view m_data;
+    uint64_t m_pos = 0;
+    bool m_failed = false;
+
+    AST* m_ast = nullptr;
+    AST::Context* m_context = nullptr;
+
+    template<typename T>
+    T get() {
+        T value = {};
+        if (m_failed || m_data.size() - m_pos < sizeof(T)) {
+            m_failed = true;
+            return value;
+        }
+
+        std::memcpy(&value, m_data.data() + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return value;
+    }
+
+    /// Returns a view of the next string in the data itself, which is only
+    /// valid for as long as the data is.
+    std::string_view get_string() {
+        const uint32_t size = get<uint32_t>();
+        if (m_failed || m_data.size() - m_pos < size) {
+            m_failed = true;
+            return {};
+        }
+
+        std::string_view str = m_data.substr(m_pos, size);
+        m_pos += size;
+        return str;
+    }
+
+    /// Returns a count of things that are each at least one byte, which has
+    /// to fit in what is left of the data.
+    uint32_t get_count() {
+        const uint32_t count = get<uint32_t>();
+        if (count > m_data.size() - m_pos)
+            m_failed = true;
+
+        return m_failed ? 0 : count;
+    }
+
+    Runes get_runes() {
+        Runes runes = {};
+        for (uint32_t i = 0, e = get<uint8_t>(); i < e; ++i) {
+            const uint8_t kind = get<uint8_t>();
+            if (kind > Rune::Private) {
+                m_failed = true;
+                break;
+            }
+
+            runes.push_back(new (m_context->get_arena()) Rune(
+                static_cast<Rune::Kind>(kind), {}));
+        }
+
+        return runes;
+    }
+
+    QualType get_type() {
+        const uint8_t cls = get<uint8_t>();
+        const uint32_t quals = get<uint32_t>();
+
+        switch (cls) {
+            case Type::Alias:
+            case Type::Deferred:
+            case Type::Enum:
+            case Type::Struct:
+                // Named types are resolved by name analysis, the same as they
+                // would be for a parsed tree.
+                return QualType(DeferredType::get(*m_context, get_string()),
+                    quals);
+
+            case Type::Array: {
+                const uint32_t size = get<uint32_t>();
+                return QualType(ArrayType::get(*m_context, get_type(), size),
+                    quals);
+            }
+
+            case Type::Builtin: {
+                const uint8_t kind = get<uint8_t>();
+                if (kind > BuiltinType::Float64)
+                    break;
+
+                return QualType(BuiltinType::get(
+                    *m_context, static_cast<BuiltinType::Kind>(kind)), quals);
+            }
+
+            case Type::Function: {
+                const QualType ret = get_type();
+
+                FunctionType::Params params = {};
+                for (uint32_t i = 0, e = get_count(); i < e && !m_failed; ++i)
+                    params.push_back(get_type());
+
+                return QualType(FunctionType::get(*m_context, ret, params),
+                    quals);
+            }
+
+            case Type::Pointer:
+                return QualType(PointerType::get(*m_context, get_type()), quals);
+        }
+
+        m_failed = true;
+        return QualType(BuiltinType::get(*m_context, BuiltinType::Void));
+    }
+
+    Defn* get_defn() {
+        const uint8_t kind = get<uint8_t>();
+        if (kind == Defn::Load)
+            return LoadDefn::create(*m_context, {}, std::string(get_string()));
+
+        Scope* scope = m_ast->get_scope();
+        const Symbol name = get_string();
+        const Runes runes = get_runes();
+
+        switch (kind) {
+            case Defn::Function: {
+                const QualType type = get_type();
+                if (m_failed || !type->is_function())
+                    break;
+
+                const FunctionType* function = static_cast<const FunctionType*>(
+                    type.get_type());
+
+                if (get<uint32_t>() != function->num_params())
+                    break;
+
+                Scope* params_scope = new (m_context->get_arena()) Scope(scope);
+                FunctionDefn::Params params = {};
+                params.reserve(function->num_params());
+
+                for (uint32_t i = 0, e = function->num_params(); i < e; ++i) {
+                    const Symbol param_name = get_string();
+                    ParameterDefn* param = ParameterDefn::create(
+                        *m_context, {}, param_name, {}, function->get_param(i));
+
+                    if (param_name != "_")
+                        params_scope->add(param);
+
+                    params.push_back(param);
+                }
+
+                return FunctionDefn::create(
+                    *m_context, {}, name, runes, type, params_scope, params);
+            }
+
+            case Defn::Variable:
+                return VariableDefn::create(
+                    *m_context, {}, name, runes, get_type(), nullptr, true);
+
+            case Defn::Struct: {
+                StructDefn* defn = StructDefn::create(
+                    *m_context, {}, name, runes, nullptr);
+                defn->set_type(StructType::create(*m_context, defn));
+
+                StructDefn::Fields fields = {};
+                for (uint32_t i = 0, e = get_count(); i < e && !m_failed; ++i) {
+                    const Symbol field_name = get_string();
+                    fields.push_back(FieldDefn::create(
+                        *m_context, {}, field_name, {}, get_type(), i));
+                }
+
+                defn->set_fields(fields);
+                return defn;
+            }
+
+            case Defn::Enum: {
+                const QualType underlying = get_type();
+                EnumDefn* defn = EnumDefn::create(
+                    *m_context, {}, name, runes, underlying.get_type());
+
+                const EnumType* type = EnumType::create(
+                    *m_context, underlying, defn);
+                defn->set_type(type);
+
+                EnumDefn::Variants variants = {};
+                for (uint32_t i = 0, e = get_count(); i < e && !m_failed; ++i) {
+                    const Symbol variant_name = get_string();
+                    VariantDefn* variant = VariantDefn::create(
+                        *m_context, {}, variant_name, {}, type, get<int64_t>());
+
+                    // Variants are named in the scope of the file, as they are
+                    // by the parser.
+                    scope->add(variant);
+                    variants.push_back(variant);
+                }
+
+                defn->set_variants(variants);
+                return defn;
+            }
+
+            case Defn::Alias: {
+                AliasDefn* defn = AliasDefn::create(
+                    *m_context, {}, name, runes, nullptr);
+                defn->set_type(AliasType::create(*m_context, get_type(), defn));
+                return defn;
+            }
+        }
+
+        m_failed = true;
+        return nullptr;
+    }
+
+public:
+    InterfaceReader(std::string_view data) : m_data(data) {}
+
+    AST* run(const std::string& file, uint64_t hash, uint64_t* deps) {
+        if (get<uint32_t>() != Magic || get<uint32_t>() != Version ||
+          get<uint64_t>() != hash)
+            return nullptr;
+
+        const uint64_t stamp = get<uint64_t>();
+
+        m_ast = AST::create(file);
+        m_context = &m_ast->get_context();
+
+        for (uint32_t i = 0, e = get_count(); i < e && !m_failed; ++i) {
+            Defn* defn = get_defn();
+            if (m_failed)
+                break;
+
+            m_ast->get_defns().push_back(defn);
+            if (defn->is_load())
+                continue;
+
+            NamedDefn* named = static_cast<NamedDefn*>(defn);
+            m_ast->get_scope()->add(named);
+
+            if (named->has_rune(Rune::Public))
+                m_ast->get_exports().push_back(named);
+        }
+
+        if (m_failed || m_pos != m_data.size()) {
+            delete m_ast;
+            return nullptr;
+        }
+
+        if (deps)
+            *deps = stamp;
+
+        return m_ast;
+    }
+};
+
+} // namespace
+
+void lace::write_interface(const AST* ast, uint64_t hash, uint64_t deps,
+                           std::ostream& out) {
+    InterfaceWriter writer(out);
+    writer.run(ast, hash, deps);
+}
+
+AST* lace::read_interface(std::string_view data, const std::string& file,
+                          uint64_t hash, uint64_t* deps) {
+    InterfaceReader reader(data);
+    return reader.run(file, hash, deps);
+}
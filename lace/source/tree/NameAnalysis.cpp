@@ -7,6 +7,7 @@
 #include "lace/tree/Defn.hpp"
 #include "lace/tree/NameAnalysis.hpp"
 #include "lace/tree/Scope.hpp"
+#include "lace/tree/SymbolTable.hpp"
 
 using namespace lace;
 
@@ -14,13 +15,25 @@ NameAnalysis::NameAnalysis(const Options& options) : m_options(options) {}
 
 bool NameAnalysis::resolve_type(const QualType& type) const {
     switch (type->get_class()) {
-        case Type::Array:
-            return resolve_type(
-                static_cast<const ArrayType*>(type.get_type())->get_element_type());
+        case Type::Array: {
+            // Types are uniqued, so the types nested in one are never changed
+            // in place. Instead, |type| is swapped for the type made out of 
+            // the resolved ones.
+            const ArrayType* array_type = static_cast<const ArrayType*>(
+                type.get_type());
+
+            QualType element = array_type->get_element_type();
+            if (!resolve_type(element))
+                return false;
+
+            type.set_type(ArrayType::get(
+                *m_context, element, array_type->get_size()));
+            return true;
+        }
 
         case Type::Deferred: {
-            NamedDefn* named_defn = m_scope->get(static_cast<const DeferredType*>(
-                type.get_type())->get_name());
+            NamedDefn* named_defn = m_symbols.get(static_cast<const DeferredType*>(
+                type.get_type())->get_symbol());
             if (!named_defn)
                 return false;
 
@@ -40,19 +53,28 @@ bool NameAnalysis::resolve_type(const QualType& type) const {
             const FunctionType* func_type = static_cast<const FunctionType*>(
                 type.get_type());
 
-            if (!resolve_type(func_type->get_return_type()))
+            QualType ret = func_type->get_return_type();
+            if (!resolve_type(ret))
                 return false;
 
-            for (auto& param : func_type->get_params())
+            FunctionType::Params params = func_type->get_params();
+            for (auto& param : params)
                 if (!resolve_type(param))
                     return false;
 
+            type.set_type(FunctionType::get(*m_context, ret, params));
             return true;
         }
 
-        case Type::Pointer:
-            return resolve_type(
-                static_cast<const PointerType*>(type.get_type())->get_pointee());
+        case Type::Pointer: {
+            QualType pointee = static_cast<const PointerType*>(
+                type.get_type())->get_pointee();
+            if (!resolve_type(pointee))
+                return false;
+
+            type.set_type(PointerType::get(*m_context, pointee));
+            return true;
+        }
 
         default:
             return true;
@@ -62,10 +84,12 @@ bool NameAnalysis::resolve_type(const QualType& type) const {
 void NameAnalysis::visit(AST& ast) {
     m_ast = &ast;
     m_context = &ast.get_context();
-    m_scope = ast.get_scope();
+    m_symbols.enter(ast.get_scope());
 
     for (Defn* defn : ast.get_defns())
-        defn->accept(*this);
+        dispatch(*defn);
+
+    m_symbols.exit();
 }
 
 void NameAnalysis::visit(VariableDefn& node) {
@@ -100,10 +124,10 @@ void NameAnalysis::visit(VariantDefn& node) {
 
 void NameAnalysis::visit(StructDefn& node) {
     for (FieldDefn* field : node.get_fields())
-        field->accept(*this);
+        visit(*field);
 }
 
 void NameAnalysis::visit(EnumDefn& node) {
     for (VariantDefn* variant : node.get_variants())
-        variant->accept(*this);
+        visit(*variant);
 }
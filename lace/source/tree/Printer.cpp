@@ -21,8 +21,16 @@ void Printer::visit(AST& ast) {
 
     ++m_indent;
 
-    for (Defn* defn : ast.get_defns())
+    for (Defn* defn : ast.get_defns()) {
+        // With -dump-func, only the selected functions are printed.
+        if (!m_options.dump_funcs.empty()) {
+            auto* function = dynamic_cast<FunctionDefn*>(defn);
+            if (!function || !m_options.dumps_function(function->get_name()))
+                continue;
+        }
+
         defn->accept(*this);
+    }
     
     --m_indent;
 }
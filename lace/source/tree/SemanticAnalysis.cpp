@@ -58,13 +58,13 @@ void SemanticAnalysis::visit(AST& ast) {
     m_scope = ast.get_scope();
 
     for (Defn* defn : ast.get_defns())
-        defn->accept(*this);
+        dispatch(*defn);
 }
 
 void SemanticAnalysis::visit(VariableDefn& node) {
     if (node.has_init()) {
         Expr* init = node.get_init();;
-        init->accept(*this);
+        dispatch(*init);
 
         const log::Span span = log::Span(m_ast->get_file(), node.get_span());
         if (node.is_global() && !init->is_constant())
@@ -101,7 +101,7 @@ void SemanticAnalysis::visit(FunctionDefn& node) {
     }
     
     if (node.has_body())
-        node.get_body()->accept(*this);
+        visit(*node.get_body());
 
     m_function = nullptr;
 }
@@ -112,7 +112,7 @@ void SemanticAnalysis::visit(AsmStmt& node) {
 
     for (uint32_t i = 0, e = node.num_args(); i < e; ++i) {
         Expr* arg = node.get_arg(i);
-        arg->accept(*this);
+        dispatch(*arg);
 
         if (i < node.num_output_constraints()) {
             if (!arg->get_type().is_mut())
@@ -164,33 +164,33 @@ void SemanticAnalysis::visit(AsmStmt& node) {
 void SemanticAnalysis::visit(AdapterStmt& node) {
     switch (node.get_flavor()) {
     case AdapterStmt::Definitive:
-        node.get_defn()->accept(*this);
+        dispatch(*node.get_defn());
         break;
 
     case AdapterStmt::Expressive:
-        node.get_expr()->accept(*this);
+        dispatch(*node.get_expr());
         break;
     }
 }
 
 void SemanticAnalysis::visit(BlockStmt& node) {
     for (Stmt* stmt : node.get_stmts())
-        stmt->accept(*this);
+        dispatch(*stmt);
 }
 
 void SemanticAnalysis::visit(IfStmt& node) {
     Expr* cond = node.get_cond();
-    cond->accept(*this);
+    dispatch(*cond);
 
     // Check that the if condition can be evaluated to a boolean.
     if (!is_boolean_evaluable(cond->get_type().get_type()))
         log::fatal("'if' condition must be a boolean", 
             log::Span(m_ast->get_file(), cond->get_span()));
 
-    node.get_then()->accept(*this);
+    dispatch(*node.get_then());
 
     if (node.has_else())
-        node.get_else()->accept(*this);
+        dispatch(*node.get_else());
 }
 
 void SemanticAnalysis::visit(RestartStmt& node) {
@@ -212,7 +212,7 @@ void SemanticAnalysis::visit(RetStmt& node) {
     }
 
     Expr* expr = node.get_expr();
-    expr->accept(*this);
+    dispatch(*expr);
 
     const QualType& val_type = expr->get_type();
     const QualType& ret_type = m_function->get_return_type();
@@ -234,7 +234,7 @@ void SemanticAnalysis::visit(StopStmt& node) {
 
 void SemanticAnalysis::visit(UntilStmt& node) {
     Expr* cond = node.get_cond();
-    cond->accept(*this);
+    dispatch(*cond);
 
     // Check that the while condition can be evaluated to a boolean.
     if (!is_boolean_evaluable(cond->get_type()))
@@ -244,7 +244,7 @@ void SemanticAnalysis::visit(UntilStmt& node) {
     if (node.has_body()) {
         Loop prev_loop = m_loop;
         m_loop = Until;
-        node.get_body()->accept(*this);
+        dispatch(*node.get_body());
 
         m_loop = prev_loop;
     }
@@ -254,8 +254,8 @@ void SemanticAnalysis::visit(BinaryOp& node) {
     Expr* lhs = node.get_lhs();
     Expr* rhs = node.get_rhs();
 
-    lhs->accept(*this);
-    rhs->accept(*this);
+    dispatch(*lhs);
+    dispatch(*rhs);
 
     const log::Span span = log::Span(m_ast->get_file(), node.get_span());
     const QualType& lhs_type = lhs->get_type();
@@ -296,7 +296,7 @@ void SemanticAnalysis::visit(BinaryOp& node) {
 
 void SemanticAnalysis::visit(UnaryOp& node) {
     Expr* expr = node.get_expr();
-    expr->accept(*this);
+    dispatch(*expr);
 
     const log::Span span = log::Span(m_ast->get_file(), node.get_span());
     const QualType& type = expr->get_type();
@@ -383,7 +383,7 @@ void SemanticAnalysis::visit(UnaryOp& node) {
 
 void SemanticAnalysis::visit(CastExpr& node) {
     Expr* expr = node.get_expr();
-    expr->accept(*this);
+    dispatch(*expr);
 
     if (!expr->get_type().can_cast(node.get_type()))
         log::fatal("unsupported cast", 
@@ -392,7 +392,7 @@ void SemanticAnalysis::visit(CastExpr& node) {
 
 void SemanticAnalysis::visit(ParenExpr& node) {
     Expr* expr = node.get_expr();
-    expr->accept(*this);
+    dispatch(*expr);
     
     node.set_type(expr->get_type());
 }
@@ -406,10 +406,10 @@ void SemanticAnalysis::visit(AccessExpr& node) {
 
 void SemanticAnalysis::visit(SubscriptExpr& node) {
     Expr* base = node.get_base();
-    base->accept(*this);
+    dispatch(*base);
 
     Expr* index = node.get_index();
-    index->accept(*this);
+    dispatch(*index);
 
     const Type* base_type = base->get_type().get_type();
     if (auto AT = dynamic_cast<const ArrayType*>(base_type)) {
@@ -433,7 +433,7 @@ void SemanticAnalysis::visit(RefExpr& node) {
 
 void SemanticAnalysis::visit(CallExpr& node) {
     Expr* callee = node.get_callee();
-    callee->accept(*this);
+    dispatch(*callee);
 
     const log::Span span = log::Span(m_ast->get_file(), node.get_span());
     const QualType& callee_type = callee->get_type();
@@ -453,7 +453,7 @@ void SemanticAnalysis::visit(CallExpr& node) {
     // parameter type.
     for (uint32_t i = 0, e = node.num_args(); i < e; ++i) {
         Expr* arg = node.get_arg(i);
-        arg->accept(*this);
+        dispatch(*arg);
 
         const QualType& actual = arg->get_type();
         const QualType& expected = FT->get_param(i);
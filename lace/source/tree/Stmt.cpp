@@ -32,89 +32,36 @@ AsmStmt* AsmStmt::create(
 */
 
 AdapterStmt* AdapterStmt::create(AST::Context& ctx, Defn* defn) {
-    return new AdapterStmt(defn->get_span(), defn);
+    return new (ctx.get_arena()) AdapterStmt(defn->get_span(), defn);
 }
 
 AdapterStmt* AdapterStmt::create(AST::Context& ctx, Expr* expr) {
-    return new AdapterStmt(expr->get_span(), expr);
-}
-
-AdapterStmt::~AdapterStmt() {
-    switch (m_flavor) {
-        case Definitive:
-            delete m_defn;
-            m_defn = nullptr;
-            break;
-        case Expressive:
-            delete m_expr;
-            m_expr = nullptr;
-            break;
-    }
-}
-
-BlockStmt::~BlockStmt() {
-    delete m_scope;
-    m_scope = nullptr;
-
-    for (Stmt* stmt : m_stmts)
-        delete stmt;
-
-    m_stmts.clear();
+    return new (ctx.get_arena()) AdapterStmt(expr->get_span(), expr);
 }
 
 BlockStmt* BlockStmt::create(AST::Context& ctx, SourceSpan span, Scope* scope, 
                              const Stmts& stmts) {
-    return new BlockStmt(span, scope, stmts);
-}
-
-IfStmt::~IfStmt() {
-    delete m_cond;
-    m_cond = nullptr;
-
-    delete m_then;
-    m_then = nullptr;
-
-    if (has_else()) {
-        delete m_else;
-        m_else = nullptr;
-    }
+    return new (ctx.get_arena()) BlockStmt(span, scope, stmts);
 }
 
 IfStmt* IfStmt::create(AST::Context& ctx, SourceSpan span, Expr* cond, 
                        Stmt* then, Stmt* els) {
-    return new IfStmt(span, cond, then, els);
+    return new (ctx.get_arena()) IfStmt(span, cond, then, els);
 }
 
 RestartStmt* RestartStmt::create(AST::Context& ctx, SourceSpan span) {
-    return new RestartStmt(span);
-}
-
-RetStmt::~RetStmt() {
-    if (has_expr()) {
-        delete m_expr;
-        m_expr = nullptr;
-    }
+    return new (ctx.get_arena()) RestartStmt(span);
 }
 
 RetStmt* RetStmt::create(AST::Context& ctx, SourceSpan span, Expr* expr) {
-    return new RetStmt(span, expr);
+    return new (ctx.get_arena()) RetStmt(span, expr);
 }
 
 StopStmt* StopStmt::create(AST::Context& ctx, SourceSpan span) {
-    return new StopStmt(span);
-}
-
-UntilStmt::~UntilStmt() {
-    delete m_cond;
-    m_cond = nullptr;
-
-    if (has_body()) {
-        delete m_body;
-        m_body = nullptr;
-    }
+    return new (ctx.get_arena()) StopStmt(span);
 }
 
 UntilStmt* UntilStmt::create(AST::Context& ctx, SourceSpan span, Expr* cond, 
                              Stmt* body) {
-    return new UntilStmt(span, cond, body);
+    return new (ctx.get_arena()) UntilStmt(span, cond, body);
 }
@@ -8,6 +8,7 @@
 #include "lace/tree/Defn.hpp"
 #include "lace/tree/Expr.hpp"
 #include "lace/tree/Stmt.hpp"
+#include "lace/tree/Scope.hpp"
 #include "lace/tree/SymbolAnalysis.hpp"
 #include "lace/tree/Type.hpp"
 
@@ -17,13 +18,23 @@ SymbolAnalysis::SymbolAnalysis(const Options& options) : m_options(options) {}
 
 bool SymbolAnalysis::resolve_type(const QualType& type) const {
     switch (type->get_class()) {
-        case Type::Array:
-            return resolve_type(
-                static_cast<const ArrayType*>(type.get_type())->get_element_type());
+        case Type::Array: {
+            // Nested types are never resolved in place, as types are uniqued.
+            const ArrayType* array_type = static_cast<const ArrayType*>(
+                type.get_type());
+
+            QualType element = array_type->get_element_type();
+            if (!resolve_type(element))
+                return false;
+
+            type.set_type(ArrayType::get(
+                *m_context, element, array_type->get_size()));
+            return true;
+        }
 
         case Type::Deferred: {
-            NamedDefn* named_defn = m_scope->get(static_cast<const DeferredType*>(
-                type.get_type())->get_name());
+            NamedDefn* named_defn = m_symbols.get(static_cast<const DeferredType*>(
+                type.get_type())->get_symbol());
             if (!named_defn)
                 return false;
 
@@ -43,19 +54,28 @@ bool SymbolAnalysis::resolve_type(const QualType& type) const {
             const FunctionType* func_type = static_cast<const FunctionType*>(
                 type.get_type());
 
-            if (!resolve_type(func_type->get_return_type()))
+            QualType ret = func_type->get_return_type();
+            if (!resolve_type(ret))
                 return false;
 
-            for (auto& param : func_type->get_params())
+            FunctionType::Params params = func_type->get_params();
+            for (auto& param : params)
                 if (!resolve_type(param))
                     return false;
 
+            type.set_type(FunctionType::get(*m_context, ret, params));
             return true;
         }
 
-        case Type::Pointer:
-            return resolve_type(
-                static_cast<const PointerType*>(type.get_type())->get_pointee());
+        case Type::Pointer: {
+            QualType pointee = static_cast<const PointerType*>(
+                type.get_type())->get_pointee();
+            if (!resolve_type(pointee))
+                return false;
+
+            type.set_type(PointerType::get(*m_context, pointee));
+            return true;
+        }
 
         default:
             return true;
@@ -65,10 +85,12 @@ bool SymbolAnalysis::resolve_type(const QualType& type) const {
 void SymbolAnalysis::visit(AST& ast) {
     m_ast = &ast;
     m_context = &ast.get_context();
-    m_scope = ast.get_scope();
+    m_symbols.enter(ast.get_scope());
 
     for (Defn* defn : ast.get_defns())
-        defn->accept(*this);
+        dispatch(*defn);
+
+    m_symbols.exit();
 }
 
 void SymbolAnalysis::visit(VariableDefn& node) {
@@ -77,16 +99,16 @@ void SymbolAnalysis::visit(VariableDefn& node) {
             log::Span(m_ast->get_file(), node.get_span()));
             
     if (node.has_init())
-        node.get_init()->accept(*this);
+        dispatch(*node.get_init());
 }
 
 void SymbolAnalysis::visit(FunctionDefn& node) {
-    m_scope = node.get_scope();
+    m_symbols.enter(node.get_scope());
 
     if (node.has_body())
-        node.get_body()->accept(*this);
+        visit(*node.get_body());
 
-    m_scope = m_scope->get_parent();
+    m_symbols.exit();
 }
 
 void SymbolAnalysis::visit(StructDefn& node) {
@@ -96,65 +118,65 @@ void SymbolAnalysis::visit(StructDefn& node) {
 /*
 void SymbolAnalysis::visit(AsmStmt& node) {
     for (uint32_t i = 0, e = node.num_args(); i < e; ++i)
-        node.get_arg(i)->accept(*this);
+        dispatch(*node.get_arg(i));
 }
 */
 
 void SymbolAnalysis::visit(AdapterStmt& node) {
     switch (node.get_flavor()) {
     case AdapterStmt::Definitive:
-        node.get_defn()->accept(*this);
+        dispatch(*node.get_defn());
         break;
 
     case AdapterStmt::Expressive:
-        node.get_expr()->accept(*this);
+        dispatch(*node.get_expr());
         break;
     }
 }
 
 void SymbolAnalysis::visit(BlockStmt& node) {
-    m_scope = node.get_scope();
+    m_symbols.enter(node.get_scope());
 
     for (Stmt* stmt : node.get_stmts())
-        stmt->accept(*this);
+        dispatch(*stmt);
 
-    m_scope = m_scope->get_parent();
+    m_symbols.exit();
 }
 
 void SymbolAnalysis::visit(IfStmt& node) {
-    node.get_cond()->accept(*this);
-    node.get_then()->accept(*this);
+    dispatch(*node.get_cond());
+    dispatch(*node.get_then());
 
     if (node.has_else())
-        node.get_else()->accept(*this);
+        dispatch(*node.get_else());
 }
 
 void SymbolAnalysis::visit(RetStmt& node) {
     if (node.has_expr())
-        node.get_expr()->accept(*this);
+        dispatch(*node.get_expr());
 }
 
 void SymbolAnalysis::visit(UntilStmt& node) {
-    node.get_cond()->accept(*this);
+    dispatch(*node.get_cond());
 
     if (node.has_body())
-        node.get_body()->accept(*this);
+        dispatch(*node.get_body());
 }
 
 void SymbolAnalysis::visit(BinaryOp& node) {
-    node.get_lhs()->accept(*this);
-    node.get_rhs()->accept(*this);
+    dispatch(*node.get_lhs());
+    dispatch(*node.get_rhs());
 }
 
 void SymbolAnalysis::visit(UnaryOp& node) {
-    node.get_expr()->accept(*this);
+    dispatch(*node.get_expr());
 }
 
 void SymbolAnalysis::visit(AccessExpr& node) {
     const log::Span span = log::Span(m_ast->get_file(), node.get_span());
     const std::string& name = node.get_name();
 
-    node.get_base()->accept(*this);
+    dispatch(*node.get_base());
 
     // Check that the base type is a struct.
     QualType base_type = node.get_base()->get_type();
@@ -169,7 +191,7 @@ void SymbolAnalysis::visit(AccessExpr& node) {
         base_type.get_type())->get_defn();
 
     // Resolve the target field from the struct definition.
-    const FieldDefn* field = struct_defn->get_field(name);
+    const FieldDefn* field = struct_defn->get_field(node.get_symbol());
     if (!field)
         log::fatal("field '" + name + "' does not exist", span);
 
@@ -178,16 +200,16 @@ void SymbolAnalysis::visit(AccessExpr& node) {
 }
 
 void SymbolAnalysis::visit(CallExpr& node) {
-    node.get_callee()->accept(*this);
+    dispatch(*node.get_callee());
 
     for (Expr* arg : node.get_args())
-        arg->accept(*this);
+        dispatch(*arg);
 
     // @Todo: maybe propogate function return type here.
 }
 
 void SymbolAnalysis::visit(CastExpr& node) {
-    node.get_expr()->accept(*this);
+    dispatch(*node.get_expr());
 
     if (!resolve_type(node.get_type()))
         log::fatal("unresolved type: " + node.get_type().to_string(), 
@@ -195,14 +217,14 @@ void SymbolAnalysis::visit(CastExpr& node) {
 }
 
 void SymbolAnalysis::visit(ParenExpr& node) {
-    node.get_expr()->accept(*this);
+    dispatch(*node.get_expr());
 }
 
 void SymbolAnalysis::visit(RefExpr& node) {
     const log::Span span = log::Span(m_ast->get_file(), node.get_span());
     const std::string& name = node.get_name();
 
-    NamedDefn* named_defn = m_scope->get(name);
+    NamedDefn* named_defn = m_symbols.get(node.get_symbol());
     if (!named_defn)
         log::fatal("unresolved reference: " + name, span);
 
@@ -221,6 +243,6 @@ void SymbolAnalysis::visit(SizeofExpr& node) {
 }
 
 void SymbolAnalysis::visit(SubscriptExpr& node) {
-    node.get_base()->accept(*this);
-    node.get_index()->accept(*this);
+    dispatch(*node.get_base());
+    dispatch(*node.get_index());
 }
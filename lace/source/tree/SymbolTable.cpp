@@ -0,0 +1,58 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/tree/Defn.hpp"
+#include "lace/tree/Scope.hpp"
+#include "lace/tree/SymbolTable.hpp"
+
+#include <cassert>
+
+using namespace lace;
+
+void SymbolTable::enter(const Scope* scope) {
+    enter();
+
+    for (NamedDefn* defn : scope->get_defns())
+        add(defn);
+}
+
+void SymbolTable::exit() {
+    assert(!m_marks.empty() && "no scope to exit!");
+
+    for (uint32_t i = m_added.size(); i > m_marks.back(); --i) {
+        // Emptied stacks are left in the table, since the same names tend to
+        // come back in the next scope.
+        Entries& entries = m_table[m_added[i - 1]];
+        assert(!entries.empty() && entries.back().depth == depth() && 
+            "symbol table is out of sync with its scopes!");
+
+        entries.pop_back();
+    }
+
+    m_added.resize(m_marks.back());
+    m_marks.pop_back();
+}
+
+void SymbolTable::add(NamedDefn* defn) {
+    m_table[defn->get_symbol()].push_back({ depth(), defn });
+    m_added.push_back(defn->get_symbol());
+}
+
+NamedDefn* SymbolTable::get(Symbol name) const {
+    auto it = m_table.find(name);
+    if (it == m_table.end() || it->second.empty())
+        return nullptr;
+
+    return it->second.back().defn;
+}
+
+NamedDefn* SymbolTable::get_local(Symbol name) const {
+    auto it = m_table.find(name);
+    if (it == m_table.end() || it->second.empty())
+        return nullptr;
+
+    const Entry& entry = it->second.back();
+    return entry.depth == depth() ? entry.defn : nullptr;
+}
@@ -8,13 +8,43 @@
 #include "lace/tree/Type.hpp"
 
 #include <cassert>
+#include <cstddef>
+#include <functional>
+#include <mutex>
 
 using namespace lace;
 
+//
+//  Types are always made in the root context of a tree, under its lock once it
+//  has been forked, so that forks of the context used from other threads share
+//  the same types.
+//
+
+/// Mix the hash of |type| into |seed|.
+static inline size_t hash_combine(size_t seed, const QualType& type) {
+    return seed ^ (std::hash<QualType>()(type) + 0x9E3779B97F4A7C15ull 
+        + (seed << 6) + (seed >> 2));
+}
+
 bool QualType::compare(const QualType& other) const {
+    // Types of the same context are uniqued, but a type can still be made of
+    // types owned by another context, e.g. a pointer to a field of a structure
+    // loaded from another file. So only equality is decided by the canonical 
+    // types, and the rest are compared by their structure.
+    if (m_type->get_canonical() == other->get_canonical())
+        return true;
+
     return /*m_quals == other.m_quals &&*/ m_type->compare(other.get_type());
 }
 
+QualType QualType::get_canonical() const {
+    return QualType(m_type->get_canonical());
+}
+
+bool QualType::is_canonical() const {
+    return m_quals == 0 && m_type->get_canonical() == m_type;
+}
+
 bool QualType::can_cast(const QualType& other, bool implicitly) const {
     // @Todo: reinvent this, but careful of (mut lval) <- (immut rval) failing.
     // In the above case, the type checker falls back to trying a cast, but 
@@ -39,14 +69,20 @@ AliasType* AliasType::create(AST::Context& ctx, const QualType& underlying,
                              const AliasDefn* defn) {
     assert(defn && "definition cannot be null!");
     
-    AliasType* type = new AliasType(underlying, defn);
-    ctx.m_aliases.emplace(defn->get_name(), type);
+    AST::Context& root = ctx.get_root();
+    auto lock = root.lock_types();
+
+    AliasType* type = new (root.get_arena()) AliasType(root, underlying, defn);
+    root.m_aliases.emplace(defn->get_symbol(), type);
     return type;
 }
 
-AliasType* AliasType::get(AST::Context& ctx, const std::string &name) {
-    auto it = ctx.m_aliases.find(name);
-    if (it != ctx.m_aliases.end())
+AliasType* AliasType::get(AST::Context& ctx, Symbol name) {
+    AST::Context& root = ctx.get_root();
+    auto lock = root.lock_types();
+
+    auto it = root.m_aliases.find(name);
+    if (it != root.m_aliases.end())
         return it->second;
 
     return nullptr;
@@ -64,8 +100,24 @@ bool AliasType::can_cast(const Type* other, bool implicitly) const {
 
 ArrayType* ArrayType::get(AST::Context& ctx, const QualType& element, 
                            uint32_t size) {
-    ArrayType* type = new ArrayType(element, size);
-    ctx.m_arrays.push_back(type);
+    AST::Context& root = ctx.get_root();
+    auto lock = root.lock_types();
+
+    const size_t hash = hash_combine(size, element);
+
+    auto [begin, end] = root.m_arrays.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+        ArrayType* type = it->second;
+        if (type->get_size() == size && type->get_element_type() == element)
+            return type;
+    }
+
+    ArrayType* type = new (root.get_arena()) ArrayType(root, element, size);
+    root.m_arrays.emplace(hash, type);
+
+    if (!element.is_canonical())
+        type->m_canonical = get(root, element.get_canonical(), size);
+
     return type;
 }
 
@@ -91,8 +143,8 @@ bool ArrayType::can_cast(const Type* other, bool implicitly) const {
         static_cast<const PointerType*>(other)->get_pointee());
 }
 
-BuiltinType* BuiltinType::get(AST::Context &ctx, Kind kind) {
-    return ctx.m_builtins[kind];
+BuiltinType* BuiltinType::get(AST::Context& ctx, Kind kind) {
+    return ctx.get_root().m_builtins[kind];
 }
 
 std::string BuiltinType::to_string() const {
@@ -141,9 +193,16 @@ bool BuiltinType::can_cast(const Type* other, bool implicitly) const {
     }
 }
 
-DeferredType* DeferredType::get(AST::Context& ctx, const std::string& name) {
-    DeferredType* type = new DeferredType(name);
-    ctx.m_deferred.push_back(type);
+DeferredType* DeferredType::get(AST::Context& ctx, Symbol name) {
+    AST::Context& root = ctx.get_root();
+    auto lock = root.lock_types();
+
+    auto it = root.m_deferred.find(name);
+    if (it != root.m_deferred.end())
+        return it->second;
+
+    DeferredType* type = new (root.get_arena()) DeferredType(root, name);
+    root.m_deferred.emplace(name, type);
     return type;
 }
 
@@ -151,18 +210,24 @@ EnumType* EnumType::create(AST::Context& ctx, const QualType& underlying,
                            const EnumDefn* defn) {
     assert(defn && "definition cannot be null!");
 
-    auto it = ctx.m_enums.find(defn->get_name());
-    if (it != ctx.m_enums.end())
+    AST::Context& root = ctx.get_root();
+    auto lock = root.lock_types();
+
+    auto it = root.m_enums.find(defn->get_symbol());
+    if (it != root.m_enums.end())
         return nullptr;
 
-    EnumType* type = new EnumType(underlying, defn);
-    ctx.m_enums.emplace(defn->get_name(), type);
+    EnumType* type = new (root.get_arena()) EnumType(root, underlying, defn);
+    root.m_enums.emplace(defn->get_symbol(), type);
     return type;
 }
 
-EnumType* EnumType::get(AST::Context& ctx, const std::string& name) {
-    auto it = ctx.m_enums.find(name);
-    if (it != ctx.m_enums.end())
+EnumType* EnumType::get(AST::Context& ctx, Symbol name) {
+    AST::Context& root = ctx.get_root();
+    auto lock = root.lock_types();
+
+    auto it = root.m_enums.find(name);
+    if (it != root.m_enums.end())
         return it->second;
 
     return nullptr;
@@ -180,8 +245,36 @@ bool EnumType::can_cast(const Type* other, bool implicitly) const {
 
 FunctionType* FunctionType::get(AST::Context& ctx, const QualType& ret, 
                                 const Params& params) {
-    FunctionType* type = new FunctionType(ret, params);
-    ctx.m_functions.push_back(type);
+    AST::Context& root = ctx.get_root();
+    auto lock = root.lock_types();
+
+    size_t hash = hash_combine(params.size(), ret);
+    for (const QualType& param : params)
+        hash = hash_combine(hash, param);
+
+    auto [begin, end] = root.m_functions.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+        FunctionType* type = it->second;
+        if (type->get_return_type() == ret && type->get_params() == params)
+            return type;
+    }
+
+    FunctionType* type = new (root.get_arena()) FunctionType(root, ret, params);
+    root.m_functions.emplace(hash, type);
+
+    bool canonical = ret.is_canonical();
+    for (const QualType& param : params)
+        canonical &= param.is_canonical();
+
+    if (!canonical) {
+        Params canonical_params = {};
+        canonical_params.reserve(params.size());
+        for (const QualType& param : params)
+            canonical_params.push_back(param.get_canonical());
+
+        type->m_canonical = get(root, ret.get_canonical(), canonical_params);
+    }
+
     return type;
 }
 
@@ -197,8 +290,23 @@ std::string FunctionType::to_string() const {
 }
 
 PointerType* PointerType::get(AST::Context& ctx, const QualType& pointee) {
-    PointerType* type = new PointerType(pointee);
-    ctx.m_pointers.push_back(type);
+    AST::Context& root = ctx.get_root();
+    auto lock = root.lock_types();
+
+    const size_t hash = std::hash<QualType>()(pointee);
+
+    auto [begin, end] = root.m_pointers.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+        if (it->second->get_pointee() == pointee)
+            return it->second;
+    }
+
+    PointerType* type = new (root.get_arena()) PointerType(root, pointee);
+    root.m_pointers.emplace(hash, type);
+
+    if (!pointee.is_canonical())
+        type->m_canonical = get(root, pointee.get_canonical());
+
     return type;
 }
 
@@ -235,18 +343,24 @@ bool PointerType::can_cast(const Type* other, bool implicitly) const {
 StructType* StructType::create(AST::Context& ctx, const StructDefn *defn) {
     assert(defn && "definition cannot be null!");
     
-    auto it = ctx.m_structs.find(defn->get_name());
-    if (it != ctx.m_structs.end())
+    AST::Context& root = ctx.get_root();
+    auto lock = root.lock_types();
+
+    auto it = root.m_structs.find(defn->get_symbol());
+    if (it != root.m_structs.end())
         return nullptr;
 
-    StructType* type = new StructType(defn);
-    ctx.m_structs.emplace(defn->get_name(), type);
+    StructType* type = new (root.get_arena()) StructType(root, defn);
+    root.m_structs.emplace(defn->get_symbol(), type);
     return type;
 }
 
-StructType* StructType::get(AST::Context& ctx, const std::string& name) {
-    auto it = ctx.m_structs.find(name);
-    if (it != ctx.m_structs.end())
+StructType* StructType::get(AST::Context& ctx, Symbol name) {
+    AST::Context& root = ctx.get_root();
+    auto lock = root.lock_types();
+
+    auto it = root.m_structs.find(name);
+    if (it != root.m_structs.end())
         return it->second;
 
     return nullptr;
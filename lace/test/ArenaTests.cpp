@@ -0,0 +1,71 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/core/Arena.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace lace::test {
+
+TEST(ArenaTests, Aligned_And_Adjacent) {
+    Arena arena;
+
+    char* a = static_cast<char*>(arena.allocate(1, 1));
+    char* b = static_cast<char*>(arena.allocate(1, 1));
+    EXPECT_EQ(b, a + 1);
+
+    void* c = arena.allocate(8, 8);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % 8, 0);
+
+    void* d = arena.allocate(16, 16);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(d) % 16, 0);
+
+    EXPECT_EQ(arena.bytes_allocated(), 26);
+    EXPECT_EQ(arena.num_slabs(), 1);
+}
+
+TEST(ArenaTests, Large_Allocations) {
+    Arena arena;
+
+    for (uint32_t i = 0; i < 100; ++i)
+        arena.allocate(1024, 8);
+
+    EXPECT_GT(arena.num_slabs(), 1);
+
+    // Allocations bigger than a slab still fit in one.
+    char* big = static_cast<char*>(arena.allocate(Arena::SlabSize * 2, 8));
+    big[0] = 'a';
+    big[Arena::SlabSize * 2 - 1] = 'z';
+}
+
+TEST(ArenaTests, Destructors_In_Reverse) {
+    std::vector<int> order = {};
+
+    struct Tracked final {
+        std::vector<int>& order;
+        int id;
+
+        ~Tracked() { order.push_back(id); }
+    };
+
+    {
+        Arena arena;
+        for (int i = 0; i < 3; ++i) {
+            void* mem = arena.allocate(sizeof(Tracked), alignof(Tracked), 
+                Arena::destructor<Tracked>());
+            new (mem) Tracked{ order, i };
+        }
+
+        EXPECT_TRUE(order.empty());
+    }
+
+    EXPECT_EQ(order, std::vector<int>({ 2, 1, 0 }));
+}
+
+} // namespace lace::test
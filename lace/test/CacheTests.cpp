@@ -0,0 +1,71 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/tools/Cache.hpp"
+
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <string>
+
+namespace lace::test {
+
+class CacheTests : public ::testing::Test {
+protected:
+    std::string dir;
+
+    void SetUp() override {
+        dir = (std::filesystem::temp_directory_path() /
+            ("lace-cache-test-" + std::to_string(::testing::UnitTest
+                ::GetInstance()->random_seed()))).string();
+
+        std::filesystem::remove_all(dir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+};
+
+TEST_F(CacheTests, Hasher_Deterministic) {
+    Hasher a, b;
+    a.add(std::string("foo"));
+    a.add(42);
+    b.add(std::string("foo"));
+    b.add(42);
+
+    EXPECT_EQ(a.get(), b.get());
+}
+
+TEST_F(CacheTests, Hasher_NoAliasing) {
+    Hasher a, b;
+    a.add(std::string("ab"));
+    a.add(std::string("c"));
+    b.add(std::string("a"));
+    b.add(std::string("bc"));
+
+    EXPECT_NE(a.get(), b.get());
+}
+
+TEST_F(CacheTests, Load_Missing) {
+    Cache cache(dir);
+    std::string object = "unchanged";
+
+    EXPECT_FALSE(cache.load(1, object));
+    EXPECT_EQ(object, "unchanged");
+}
+
+TEST_F(CacheTests, Store_Then_Load) {
+    Cache cache(dir);
+    const std::string stored("\x7f" "ELF\0\x01\x02", 7);
+    cache.store(0xdeadbeef, stored);
+
+    std::string loaded;
+    ASSERT_TRUE(cache.load(0xdeadbeef, loaded));
+    EXPECT_EQ(loaded, stored);
+    EXPECT_FALSE(cache.load(0xdeadbeee, loaded));
+}
+
+} // namespace lace::test
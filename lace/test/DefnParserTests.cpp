@@ -3,6 +3,7 @@
 //  All rights reserved.
 //
 
+#include "lace/core/ThreadPool.hpp"
 #include "lace/parser/Parser.hpp"
 #include "lace/tree/AST.hpp"
 #include "lace/tree/Defn.hpp"
@@ -12,6 +13,8 @@
 
 #include "gtest/gtest.h"
 
+#include <string>
+
 namespace lace::test {
 
 class DefnParserTests : public ::testing::Test {
@@ -208,4 +211,76 @@ TEST_F(DefnParserTests, EnumCustomType) {
     EXPECT_EQ(underlying.to_string(), "u16");
 }
 
+TEST_F(DefnParserTests, PublicExports) {
+    Parser parser(
+        "load \"other.lace\";\n"
+        "$public\n"
+        "foo :: () -> s64;\n"
+        "bar :: () -> s64;\n"
+        "$[public]\n"
+        "Point :: struct { x: s64 }\n");
+    EXPECT_NO_FATAL_FAILURE(ast = parser.parse());
+
+    EXPECT_EQ(ast->num_defns(), 4);
+    EXPECT_EQ(ast->num_exports(), 2);
+    EXPECT_EQ(ast->get_exports()[0]->get_name(), "foo");
+    EXPECT_EQ(ast->get_exports()[1]->get_name(), "Point");
+}
+
+TEST_F(DefnParserTests, DeferredBodies) {
+    const std::string source = 
+        "foo :: () -> s64 { let x: s64 = 1; { ret x; } }\n"
+        "x :: s64 = 2\n"
+        "bar :: () -> void;\n";
+
+    Parser parser(source, "", true);
+    EXPECT_NO_FATAL_FAILURE(ast = parser.parse());
+
+    EXPECT_EQ(ast->num_defns(), 3);
+
+    FunctionDefn* foo = static_cast<FunctionDefn*>(ast->get_defn(0));
+    EXPECT_FALSE(foo->has_body());
+    EXPECT_TRUE(foo->has_deferred_body());
+    EXPECT_EQ(foo->get_span().end.col, 47);
+
+    const FunctionDefn* bar = static_cast<const FunctionDefn*>(ast->get_defn(2));
+    EXPECT_FALSE(bar->has_deferred_body());
+
+    Parser::parse_bodies(source, ast);
+    EXPECT_FALSE(foo->has_deferred_body());
+    ASSERT_TRUE(foo->has_body());
+    EXPECT_EQ(foo->get_body()->num_stmts(), 2);
+    EXPECT_EQ(foo->get_body()->get_span().start.col, 18);
+
+    // The global is declared after the function, so the local is still 
+    // declared in the scope of the body, as it would be if parsed in place.
+    EXPECT_EQ(foo->get_body()->get_scope()->get_defns().size(), 1);
+}
+
+TEST_F(DefnParserTests, DeferredBodies_Parallel) {
+    std::string source = "";
+    for (uint32_t i = 0; i < 256; ++i) {
+        source += "fn_" + std::to_string(i) + " :: (a: s64) -> s64 {\n"
+            "    let b: *s64 = &a;\n"
+            "    ret *b + " + std::to_string(i) + ";\n"
+            "}\n";
+    }
+
+    Parser parser(source, "", true);
+    EXPECT_NO_FATAL_FAILURE(ast = parser.parse());
+
+    ThreadPool pool(4);
+    Parser::parse_bodies(source, ast, &pool);
+
+    ASSERT_EQ(ast->num_defns(), 256);
+    for (uint32_t i = 0; i < 256; ++i) {
+        const FunctionDefn* function = 
+            static_cast<const FunctionDefn*>(ast->get_defn(i));
+
+        ASSERT_TRUE(function->has_body());
+        EXPECT_EQ(function->get_body()->num_stmts(), 2);
+        EXPECT_EQ(function->get_body()->get_span().start.line, i * 4 + 1);
+    }
+}
+
 } // namespace lace::test
@@ -0,0 +1,181 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/core/Diagnostics.hpp"
+#include "lace/tools/Files.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace lace::test {
+
+class DiagnosticsTests : public ::testing::Test {
+protected:
+    std::string path;
+
+    void SetUp() override {
+        path = (std::filesystem::temp_directory_path() /
+            ("lace-diagnostics-test-" + std::to_string(::testing::UnitTest
+                ::GetInstance()->random_seed()) + ".txt")).string();
+
+        std::filesystem::remove(path);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path);
+    }
+
+    /// Run |body| in a separate process, and return everything it logged.
+    ///
+    /// Errors are sticky for the whole process, and other tests may have 
+    /// logged some, so |body| is run on its own and stopped with a fatal 
+    /// error rather than a flush, as that writes everything out regardless.
+    std::string run(const std::function<void()>& body) {
+        EXPECT_EXIT({
+            std::ofstream out(path);
+            log::init(out);
+            body();
+            log::fatal("done");
+        }, ::testing::ExitedWithCode(1), "");
+
+        return read_file(path);
+    }
+};
+
+TEST_F(DiagnosticsTests, Order_Across_Threads) {
+    struct Note final {
+        std::string path;
+        uint16_t line, col;
+        std::string msg;
+    };
+
+    // Every thread logs to the same files, in the reverse of the order that
+    // they are expected to be written out in.
+    std::vector<Note> notes = {};
+    std::vector<std::thread> threads = {};
+
+    for (uint32_t t = 0; t < 4; ++t) {
+        for (uint32_t i = 10; i-- > 0; ) {
+            notes.push_back({ "f" + std::to_string(i % 3) + ".lace",
+                static_cast<uint16_t>(i + 1), static_cast<uint16_t>(t + 1),
+                "t" + std::to_string(t) + "_" + std::to_string(i) });
+        }
+    }
+
+    const std::string output = run([&] {
+        for (uint32_t t = 0; t < 4; ++t) {
+            threads.emplace_back([&notes, t] {
+                for (uint32_t i = 0; i < 10; ++i) {
+                    const Note& note = notes[t * 10 + i];
+                    log::note(note.msg, log::Location(note.path,
+                        { note.line, note.col }));
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+    });
+
+    std::sort(notes.begin(), notes.end(), [](const Note& a, const Note& b) {
+        return std::tie(a.path, a.line, a.col) <
+            std::tie(b.path, b.line, b.col);
+    });
+
+    std::string expected = {};
+    for (const Note& note : notes) {
+        expected += note.path + ":" + std::to_string(note.line) + ":" +
+            std::to_string(note.col) + ": note: " + note.msg + "\n";
+    }
+
+    EXPECT_EQ(output, expected + "fatal: done\n");
+}
+
+TEST_F(DiagnosticsTests, Order_Same_Location) {
+    // Diagnostics at the same position keep the order they were logged in.
+    const std::string output = run([] {
+        std::thread first([] {
+            log::note("first", log::Location("a.lace", { 1, 1 }));
+        });
+        first.join();
+
+        log::note("second", log::Location("a.lace", { 1, 1 }));
+
+        std::thread third([] {
+            log::note("third", log::Location("a.lace", { 1, 1 }));
+        });
+        third.join();
+    });
+
+    EXPECT_EQ(output,
+        "a.lace:1:1: note: first\n"
+        "a.lace:1:1: note: second\n"
+        "a.lace:1:1: note: third\n"
+        "fatal: done\n");
+}
+
+TEST_F(DiagnosticsTests, Context_Attribution) {
+    const std::string output = run([] {
+        log::note("c", log::Location("c.lace", { 1, 1 }));
+
+        std::thread worker([] {
+            log::Context context("b.lace");
+            log::note("in b");
+
+            {
+                // Contexts nest, and restore the outer one once they end.
+                log::Context inner("d.lace");
+                log::note("in d");
+            }
+
+            log::note("in b again");
+        });
+        worker.join();
+
+        log::note("a", log::Location("a.lace", { 1, 1 }));
+        log::note("no file");
+    });
+
+    // Diagnostics without a file come first, and those attributed to a file
+    // sort before any with a position in it. The fatal error comes last.
+    EXPECT_EQ(output,
+        "note: no file\n"
+        "a.lace:1:1: note: a\n"
+        "note: in b\n"
+        "note: in b again\n"
+        "c.lace:1:1: note: c\n"
+        "note: in d\n"
+        "fatal: done\n");
+}
+
+TEST_F(DiagnosticsTests, Fatal_Drains_First) {
+    // The fatal error is written out after everything logged before it on
+    // other threads, even though none of it was ever flushed.
+    const std::string output = run([] {
+        std::thread worker([] {
+            log::note("from worker", log::Location("b.lace", { 2, 1 }));
+            log::warn("unplaced worker");
+        });
+        worker.join();
+
+        log::note("from main", log::Location("a.lace", { 1, 1 }));
+    });
+
+    EXPECT_EQ(output,
+        "warning: unplaced worker\n"
+        "a.lace:1:1: note: from main\n"
+        "b.lace:2:1: note: from worker\n"
+        "fatal: done\n");
+}
+
+} // namespace lace::test
@@ -0,0 +1,114 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/core/Diagnostics.hpp"
+#include "lace/tools/Dump.hpp"
+#include "lace/tools/Files.hpp"
+
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace lace::test {
+
+class DumpTests : public ::testing::Test {
+protected:
+    std::string dir;
+
+    void SetUp() override {
+        dir = (std::filesystem::temp_directory_path() /
+            ("lace-dump-test-" + std::to_string(::testing::UnitTest
+                ::GetInstance()->random_seed()))).string();
+
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+};
+
+TEST_F(DumpTests, Buffer_Take) {
+    DumpBuffer out;
+    out << "foo " << 42 << '\n';
+    out.write("bar", 3);
+
+    EXPECT_EQ(out.take(), "foo 42\nbar");
+    EXPECT_EQ(out.take(), "");
+
+    out << "baz";
+    EXPECT_EQ(out.take(), "baz");
+}
+
+TEST_F(DumpTests, Writer_Finish) {
+    DumpWriter writer;
+    for (uint32_t i = 0; i < 16; ++i) {
+        writer.submit(dir + "/" + std::to_string(i) + ".txt", 
+            std::string(i * 1024, 'a' + i));
+    }
+
+    writer.finish();
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        EXPECT_EQ(read_file(dir + "/" + std::to_string(i) + ".txt"), 
+            std::string(i * 1024, 'a' + i));
+    }
+}
+
+TEST_F(DumpTests, Writer_Drains_On_Destruction) {
+    {
+        DumpWriter writer;
+        writer.submit(dir + "/a.txt", "first");
+        writer.submit(dir + "/a.txt", "second");
+    }
+
+    EXPECT_EQ(read_file(dir + "/a.txt"), "second");
+}
+
+TEST_F(DumpTests, Writer_Drains_On_Fatal) {
+    // A fatal error exits the process without returning to the owner of the
+    // writer, so the dumps only make it to disk through the fatal hook.
+    EXPECT_EXIT({
+        DumpWriter* writer = new DumpWriter();
+        log::set_fatal_hook([writer] { writer->finish(); });
+
+        for (uint32_t i = 0; i < 16; ++i) {
+            writer->submit(dir + "/" + std::to_string(i) + ".txt", 
+                std::string(i * 1024, 'a' + i));
+        }
+
+        log::fatal("stopping");
+    }, ::testing::ExitedWithCode(1), "");
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        const std::string path = dir + "/" + std::to_string(i) + ".txt";
+        ASSERT_TRUE(std::filesystem::exists(path));
+        EXPECT_EQ(read_file(path), std::string(i * 1024, 'a' + i));
+    }
+}
+
+TEST_F(DumpTests, Writer_Open_Failure) {
+    // Errors are sticky for the whole process, so the writer is run on its 
+    // own and what it logged is checked instead.
+    const std::string path = dir + "/log.txt";
+    EXPECT_EXIT({
+        std::ofstream out(path);
+        log::init(out);
+
+        DumpWriter writer;
+        writer.submit(dir + "/missing/a.txt", "lost");
+        writer.finish();
+        log::fatal("done");
+    }, ::testing::ExitedWithCode(1), "");
+
+    const std::string out = read_file(path);
+    EXPECT_NE(out.find("warning: failed to open"), std::string::npos);
+    EXPECT_EQ(out.find("error: failed to open"), std::string::npos);
+}
+
+} // namespace lace::test
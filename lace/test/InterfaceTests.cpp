@@ -0,0 +1,168 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/parser/Parser.hpp"
+#include "lace/tools/Cache.hpp"
+#include "lace/tree/AST.hpp"
+#include "lace/tree/Defn.hpp"
+#include "lace/tree/Interface.hpp"
+#include "lace/tree/NameAnalysis.hpp"
+#include "lace/tree/Type.hpp"
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+
+namespace lace::test {
+
+class InterfaceTests : public ::testing::Test {
+protected:
+    Options opts;
+    AST* ast;
+    AST* stub;
+
+    void SetUp() override {
+        opts = {};
+        ast = nullptr;
+        stub = nullptr;
+    }
+
+    void TearDown() override {
+        delete ast;
+        delete stub;
+        ast = stub = nullptr;
+    }
+
+    /// Parse |source| into |ast|, and returns its interface.
+    std::string write(const char* source, uint64_t hash = 1, 
+                      uint64_t deps = 0) {
+        Parser parser(source);
+        ast = parser.parse();
+
+        std::ostringstream out;
+        write_interface(ast, hash, deps, out);
+        return out.str();
+    }
+};
+
+TEST_F(InterfaceTests, Round_Trip) {
+    const std::string data = write(
+        "$public\n"
+        "add :: (a: s64, b: *Point) -> s64 { ret a; }\n"
+        "helper :: () -> void {}\n"
+        "$public\n"
+        "Point :: struct { x: s64, y: [4]f32 }\n"
+        "Colors :: enum u16 { Red, Blue = 4 }\n"
+        "$public\n"
+        "origin :: Point\n");
+
+    stub = read_interface(data, "test.lace", 1);
+    ASSERT_NE(stub, nullptr);
+
+    // The private function is left out, along with every body.
+    EXPECT_EQ(stub->get_file(), "test.lace");
+    ASSERT_EQ(stub->num_defns(), 4);
+    EXPECT_EQ(stub->num_exports(), 3);
+
+    const auto* add = dynamic_cast<const FunctionDefn*>(stub->get_defn(0));
+    ASSERT_NE(add, nullptr);
+    EXPECT_EQ(add->get_name(), "add");
+    EXPECT_TRUE(add->has_rune(Rune::Public));
+    EXPECT_FALSE(add->has_body());
+    ASSERT_EQ(add->num_params(), 2);
+    EXPECT_EQ(add->get_param(1)->get_name(), "b");
+
+    const auto* point = dynamic_cast<const StructDefn*>(stub->get_defn(1));
+    ASSERT_NE(point, nullptr);
+    ASSERT_EQ(point->num_fields(), 2);
+    EXPECT_EQ(point->get_field(1)->get_name(), "y");
+    EXPECT_EQ(point->get_field(1)->get_type().to_string(), "[4]f32");
+
+    const auto* colors = dynamic_cast<const EnumDefn*>(stub->get_defn(2));
+    ASSERT_NE(colors, nullptr);
+    EXPECT_FALSE(colors->has_rune(Rune::Public));
+    ASSERT_EQ(colors->num_variants(), 2);
+    EXPECT_EQ(colors->get_variant(1)->get_value(), 4);
+    EXPECT_EQ(static_cast<const EnumType*>(colors->get_type())
+        ->get_underlying().to_string(), "u16");
+
+    const auto* origin = dynamic_cast<const VariableDefn*>(stub->get_defn(3));
+    ASSERT_NE(origin, nullptr);
+    EXPECT_TRUE(origin->is_global());
+    EXPECT_FALSE(origin->has_init());
+}
+
+TEST_F(InterfaceTests, Resolve_Named_Types) {
+    const std::string data = write(
+        "$public\n"
+        "make :: () -> *Point;\n"
+        "Point :: struct { x: s64 }\n");
+
+    stub = read_interface(data, "test.lace", 1);
+    ASSERT_NE(stub, nullptr);
+
+    NameAnalysis name_analysis(opts);
+    EXPECT_NO_FATAL_FAILURE(stub->accept(name_analysis));
+
+    const auto* make = static_cast<const FunctionDefn*>(stub->get_defn(0));
+    const QualType& ret = make->get_return_type();
+    ASSERT_TRUE(ret->is_pointer());
+
+    const QualType& pointee = static_cast<const PointerType*>(
+        ret.get_type())->get_pointee();
+    ASSERT_TRUE(pointee->is_struct());
+    EXPECT_EQ(static_cast<const StructType*>(pointee.get_type())->get_defn(),
+        stub->get_defn(1));
+}
+
+TEST_F(InterfaceTests, Stale_Hash) {
+    const std::string data = write("$public\nfoo :: () -> void;\n", 1);
+    EXPECT_EQ(read_interface(data, "test.lace", 2), nullptr);
+}
+
+TEST_F(InterfaceTests, Dependency_Stamp) {
+    const std::string data = write("$public\nfoo :: () -> void;\n", 1, 7);
+
+    uint64_t deps = 0;
+    stub = read_interface(data, "test.lace", 1, &deps);
+    ASSERT_NE(stub, nullptr);
+    EXPECT_EQ(deps, 7);
+}
+
+TEST_F(InterfaceTests, Stale_Dependency) {
+    // The interface of a file is written against the contents of the file it
+    // loads, which is then edited without the first being compiled again.
+    Hasher before;
+    before.add("$public\nbar :: () -> s64 { ret 1; }\n");
+
+    const std::string data = write(
+        "load \"bar.lace\";\n$public\nfoo :: () -> void;\n", 1, 
+        before.get());
+
+    Hasher after;
+    after.add("$public\nbar :: () -> s64 { ret 2; }\n");
+
+    // The source of the file itself is unchanged, so its interface is still
+    // read, but the stamp it was written with no longer matches the loaded 
+    // file and so the interface has to be rejected.
+    uint64_t deps = 0;
+    stub = read_interface(data, "test.lace", 1, &deps);
+    ASSERT_NE(stub, nullptr);
+    EXPECT_EQ(deps, before.get());
+    EXPECT_NE(deps, after.get());
+}
+
+TEST_F(InterfaceTests, Truncated) {
+    const std::string data = write(
+        "$public\nfoo :: (a: s64) -> void;\nBar :: struct { x: s64 }\n");
+
+    for (uint32_t size = 0; size < data.size(); ++size) {
+        EXPECT_EQ(read_interface(
+            std::string_view(data).substr(0, size), "test.lace", 1), nullptr);
+    }
+}
+
+} // namespace lace::test
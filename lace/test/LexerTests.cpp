@@ -3,11 +3,21 @@
 //  All rights reserved.
 //
 
+#include "lace/core/Diagnostics.hpp"
 #include "lace/lexer/Lexer.hpp"
 #include "lace/lexer/Token.hpp"
+#include "lace/lexer/TokenWindow.hpp"
+#include "lace/tools/Files.hpp"
 
 #include "gtest/gtest.h"
 
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
 namespace lace::test {
 
 class LexerTests : public ::testing::Test {};
@@ -159,6 +169,85 @@ TEST_F(LexerTests, StringEscapeSequences) {
     EXPECT_EQ(token.value, "hello,\tworld!\n");
 }
 
+TEST_F(LexerTests, StringLiteral_Embedded_Null) {
+    // A null character only ends the source when it is past the end of it.
+    Lexer lexer(std::string_view("\"a\0b\"", 5));
+    Token token;
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::String);
+    EXPECT_EQ(token.value, std::string("a\0b", 3));
+}
+
+TEST_F(LexerTests, StringLiteral_Unterminated) {
+    Lexer lexer("foo \"hello, world!");
+    Token token;
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::Identifier);
+
+    EXPECT_DEATH({
+        log::init(std::cerr);
+        lexer.lex(token);
+    }, "unterminated string literal");
+}
+
+TEST_F(LexerTests, StringLiteral_Unterminated_Page_Boundary) {
+    // A file that fills its last page exactly is followed by the extra zeroed
+    // page of the mapping, which is where the lexer finds the terminator.
+    const std::string path = (std::filesystem::temp_directory_path() /
+        ("lace-lexer-test-" + std::to_string(::testing::UnitTest
+            ::GetInstance()->random_seed()) + ".lace")).string();
+
+    const uint64_t page = sysconf(_SC_PAGESIZE);
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << '"' << std::string(page - 1, 'a');
+    }
+
+    ASSERT_EQ(std::filesystem::file_size(path), page);
+
+    {
+        MappedFile file(path);
+        Lexer lexer(file.get_text(), path);
+        Token token;
+
+        EXPECT_DEATH({
+            log::init(std::cerr);
+            lexer.lex(token);
+        }, "unterminated string literal");
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_F(LexerTests, CharacterLiteral_Unterminated) {
+    // Each of these ends before the closing quote, and must stop the lexer
+    // rather than move it past the terminator.
+    for (const char* source : { "foo '", "foo 'a", "foo '\\", "foo '\\n" }) {
+        Lexer lexer(source);
+        Token token;
+
+        lexer.lex(token);
+        EXPECT_EQ(token.kind, Token::Identifier);
+
+        EXPECT_DEATH({
+            log::init(std::cerr);
+            lexer.lex(token);
+        }, "unterminated character literal") << source;
+    }
+}
+
+TEST_F(LexerTests, CharacterLiteral_Missing_Quote) {
+    Lexer lexer("'ab'");
+    Token token;
+
+    EXPECT_DEATH({
+        log::init(std::cerr);
+        lexer.lex(token);
+    }, "unterminated character literal");
+}
+
 TEST_F(LexerTests, IsolatedToken) {
     Lexer lexer(".");
     Token token;
@@ -175,6 +264,75 @@ TEST_F(LexerTests, CompoundToken) {
     EXPECT_EQ(token.kind, Token::Arrow);
 }
 
+TEST_F(LexerTests, Keywords) {
+    Lexer lexer("ret s32 mut until u64 sizeof");
+    Token token;
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::KwRet);
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::KwS32);
+    EXPECT_TRUE(token.is_builtin_type());
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::KwMut);
+    EXPECT_FALSE(token.is_builtin_type());
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::KwUntil);
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::KwU64);
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::KwSizeof);
+}
+
+TEST_F(LexerTests, Keyword_Prefix) {
+    // Identifiers that only share a prefix or hash with a keyword are not 
+    // keywords themselves.
+    Lexer lexer("return s320 u1 iff");
+    Token token;
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::Identifier);
+    EXPECT_EQ(token.value, "return");
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::Identifier);
+    EXPECT_EQ(token.value, "s320");
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::Identifier);
+    EXPECT_EQ(token.value, "u1");
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::Identifier);
+    EXPECT_EQ(token.value, "iff");
+}
+
+TEST_F(LexerTests, Trivia_Locations) {
+    Lexer lexer("  // comment\n\t\tfoo  // another\n\n" 
+        "                                          bar //");
+    Token token;
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::Identifier);
+    EXPECT_EQ(token.value, "foo");
+    EXPECT_EQ(token.loc.line, 2);
+    EXPECT_EQ(token.loc.col, 3);
+
+    lexer.lex(token);
+    EXPECT_EQ(token.kind, Token::Identifier);
+    EXPECT_EQ(token.value, "bar");
+    EXPECT_EQ(token.loc.line, 4);
+    EXPECT_EQ(token.loc.col, 43);
+
+    lexer.lex(token);
+    EXPECT_TRUE(token.is_eof());
+}
+
 TEST_F(LexerTests, Complete) {
     Lexer lexer("main :: (argc: s32, argv: **char) { ret argc * 3; }");
     Token token;
@@ -197,8 +355,7 @@ TEST_F(LexerTests, Complete) {
     EXPECT_EQ(token.kind, Token::Colon);
 
     lexer.lex(token);
-    EXPECT_EQ(token.kind, Token::Identifier);
-    EXPECT_EQ(token.value, "s32");
+    EXPECT_EQ(token.kind, Token::KwS32);
 
     lexer.lex(token);
     EXPECT_EQ(token.kind, Token::Comma);
@@ -217,8 +374,7 @@ TEST_F(LexerTests, Complete) {
     EXPECT_EQ(token.kind, Token::Star);
 
     lexer.lex(token);
-    EXPECT_EQ(token.kind, Token::Identifier);
-    EXPECT_EQ(token.value, "char");
+    EXPECT_EQ(token.kind, Token::KwChar);
 
     lexer.lex(token);
     EXPECT_EQ(token.kind, Token::CloseParen);
@@ -227,8 +383,7 @@ TEST_F(LexerTests, Complete) {
     EXPECT_EQ(token.kind, Token::OpenBrace);
 
     lexer.lex(token);
-    EXPECT_EQ(token.kind, Token::Identifier);
-    EXPECT_EQ(token.value, "ret");
+    EXPECT_EQ(token.kind, Token::KwRet);
 
     lexer.lex(token);
     EXPECT_EQ(token.kind, Token::Identifier);
@@ -248,4 +403,51 @@ TEST_F(LexerTests, Complete) {
     EXPECT_EQ(token.kind, Token::CloseBrace);
 }
 
+TEST_F(LexerTests, Window_Lookahead) {
+    Lexer lexer("a b c d e f g");
+    TokenWindow window(lexer);
+
+    window.next();
+    EXPECT_EQ(window.curr().value, "a");
+    EXPECT_EQ(window.peek().value, "b");
+    EXPECT_EQ(window.peek(TokenWindow::max_lookahead).value, "d");
+
+    // Moving through the window should not lex the peeked tokens again.
+    window.next();
+    EXPECT_EQ(window.curr().value, "b");
+    window.next();
+    EXPECT_EQ(window.curr().value, "c");
+    EXPECT_EQ(window.peek(3).value, "f");
+
+    for (const char* expected : { "d", "e", "f", "g" }) {
+        window.next();
+        EXPECT_EQ(window.curr().value, expected);
+    }
+
+    EXPECT_TRUE(window.peek().is_eof());
+    window.next();
+    EXPECT_TRUE(window.curr().is_eof());
+    EXPECT_TRUE(window.peek(2).is_eof());
+}
+
+TEST_F(LexerTests, Window_Wraps) {
+    std::string source = "";
+    for (uint32_t i = 0; i < 100; ++i)
+        source += std::to_string(i) + " ";
+
+    Lexer lexer(source);
+    TokenWindow window(lexer);
+
+    window.next();
+    for (uint32_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(window.curr().value, std::to_string(i));
+        if (i + 2 < 100)
+            EXPECT_EQ(window.peek(i % 3).value, std::to_string(i + i % 3));
+
+        window.next();
+    }
+
+    EXPECT_TRUE(window.curr().is_eof());
+}
+
 } // namespace lace::test
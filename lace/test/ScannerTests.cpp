@@ -0,0 +1,108 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/lexer/Scanner.hpp"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace lace::test {
+
+class ScannerTests : public ::testing::Test {
+protected:
+    scan::Level m_level;
+
+    void SetUp() override { m_level = scan::get_level(); }
+
+    void TearDown() override { scan::set_level(m_level); }
+
+    /// Returns the levels supported on this machine, from worst to best.
+    std::vector<scan::Level> levels() const {
+        std::vector<scan::Level> result = { scan::Level::Scalar };
+        if (m_level >= scan::Level::SSE2)
+            result.push_back(scan::Level::SSE2);
+        if (m_level >= scan::Level::AVX2)
+            result.push_back(scan::Level::AVX2);
+
+        return result;
+    }
+};
+
+TEST_F(ScannerTests, Short_Runs) {
+    EXPECT_EQ(scan::skip_blanks("x"), 0);
+    EXPECT_EQ(scan::skip_blanks(" x"), 1);
+    EXPECT_EQ(scan::skip_blanks(" \t x"), 3);
+    EXPECT_EQ(scan::skip_line("abc\ndef"), 3);
+    EXPECT_EQ(scan::skip_line("abc"), 3);
+    EXPECT_EQ(scan::skip_ident("foo_Bar9 = 1"), 8);
+    EXPECT_EQ(scan::skip_ident("a@"), 1);
+    EXPECT_EQ(scan::skip_ident("a["), 1);
+    EXPECT_EQ(scan::skip_digits("1337."), 4);
+    EXPECT_EQ(scan::skip_string("hello\\n\""), 5);
+    EXPECT_EQ(scan::skip_string("hello\""), 5);
+}
+
+TEST_F(ScannerTests, Levels_Agree) {
+    // Runs of every length up to a few vectors wide, starting at every 
+    // alignment, so that each routine crosses block boundaries both within
+    // the run and at its end.
+    const std::string fills[] = { " \t", "abcXYZ_019", "0123456789", "x;{}()" };
+    const char stops[] = { '\n', '\0', '"', '\\', '@', '`', '[', '{', '/', 
+        ':', static_cast<char>(0xC3) };
+
+    for (scan::Level level : levels()) {
+        scan::set_level(level);
+
+        for (const std::string& fill : fills) {
+            for (uint32_t len = 0; len < 100; ++len) {
+                for (char stop : stops) {
+                    std::string run = "";
+                    for (uint32_t i = 0; i < len; ++i)
+                        run += fill[i % fill.size()];
+
+                    run += stop;
+                    run += "after";
+
+                    for (uint32_t offset = 0; offset < 32; ++offset) {
+                        const std::string text = std::string(offset, '#') + run;
+                        const char* ptr = text.c_str() + offset;
+
+                        scan::set_level(scan::Level::Scalar);
+                        const uint32_t blanks = scan::skip_blanks(ptr);
+                        const uint32_t line = scan::skip_line(ptr);
+                        const uint32_t ident = scan::skip_ident(ptr);
+                        const uint32_t digits = scan::skip_digits(ptr);
+                        const uint32_t string = scan::skip_string(ptr);
+
+                        scan::set_level(level);
+                        EXPECT_EQ(scan::skip_blanks(ptr), blanks);
+                        EXPECT_EQ(scan::skip_line(ptr), line);
+                        EXPECT_EQ(scan::skip_ident(ptr), ident);
+                        EXPECT_EQ(scan::skip_digits(ptr), digits);
+                        EXPECT_EQ(scan::skip_string(ptr), string);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(ScannerTests, Stops_At_Terminator) {
+    for (scan::Level level : levels()) {
+        scan::set_level(level);
+
+        const std::string text(200, 'a');
+        EXPECT_EQ(scan::skip_ident(text.c_str()), 200);
+        EXPECT_EQ(scan::skip_line(text.c_str()), 200);
+        EXPECT_EQ(scan::skip_string(text.c_str()), 200);
+
+        const std::string blanks(77, ' ');
+        EXPECT_EQ(scan::skip_blanks(blanks.c_str()), 77);
+    }
+}
+
+} // namespace lace::test
@@ -0,0 +1,80 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/tools/SourceManager.hpp"
+
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <unistd.h>
+
+namespace lace::test {
+
+TEST(SourceManagerTests, Lines) {
+    SourceBuffer buffer("test.lace", "foo\nbar baz\n\nqux");
+
+    EXPECT_EQ(buffer.num_lines(), 4);
+    EXPECT_EQ(buffer.get_line(1), "foo");
+    EXPECT_EQ(buffer.get_line(2), "bar baz");
+    EXPECT_EQ(buffer.get_line(3), "");
+    EXPECT_EQ(buffer.get_line(4), "qux");
+    EXPECT_EQ(buffer.get_line(0), "");
+    EXPECT_EQ(buffer.get_line(5), "");
+}
+
+TEST(SourceManagerTests, Trailing_Newline) {
+    SourceBuffer buffer("test.lace", "foo\n");
+
+    EXPECT_EQ(buffer.num_lines(), 2);
+    EXPECT_EQ(buffer.get_line(1), "foo");
+    EXPECT_EQ(buffer.get_line(2), "");
+}
+
+TEST(SourceManagerTests, Locations) {
+    SourceBuffer buffer("test.lace", "foo\nbar baz\n\nqux");
+
+    EXPECT_EQ(buffer.get_location(0), SourceLocation(1, 1));
+    EXPECT_EQ(buffer.get_location(2), SourceLocation(1, 3));
+    EXPECT_EQ(buffer.get_location(3), SourceLocation(1, 4));
+    EXPECT_EQ(buffer.get_location(4), SourceLocation(2, 1));
+    EXPECT_EQ(buffer.get_location(8), SourceLocation(2, 5));
+    EXPECT_EQ(buffer.get_location(12), SourceLocation(3, 1));
+    EXPECT_EQ(buffer.get_location(13), SourceLocation(4, 1));
+}
+
+TEST(SourceManagerTests, Add_Keeps_First) {
+    SourceManager sources;
+    const SourceBuffer& first = sources.add("a.lace", "first");
+    const SourceBuffer& second = sources.add("a.lace", "second");
+
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(first.get_text(), "first");
+    EXPECT_EQ(sources.get("a.lace"), &first);
+    EXPECT_EQ(sources.get("b.lace"), nullptr);
+}
+
+TEST(SourceManagerTests, Map_Page_Sized_File) {
+    // A file that exactly fills its pages has no zeroed tail to serve as the
+    // terminator, so it must come from the extra page reserved after it.
+    const std::string path = (std::filesystem::temp_directory_path() / 
+        ("lace-map-test-" + std::to_string(getpid()) + ".lace")).string();
+
+    const std::string text(sysconf(_SC_PAGESIZE), 'x');
+    std::ofstream(path, std::ios::binary) << text;
+
+    SourceManager sources;
+    const SourceBuffer& buffer = sources.load(path);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(buffer.get_text().size(), text.size());
+    EXPECT_EQ(buffer.get_text(), text);
+    EXPECT_EQ(buffer.get_text().data()[text.size()], '\0');
+    EXPECT_EQ(sources.get(path), &buffer);
+}
+
+} // namespace lace::test
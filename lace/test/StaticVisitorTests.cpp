@@ -0,0 +1,92 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/parser/Parser.hpp"
+#include "lace/tree/AST.hpp"
+#include "lace/tree/StaticVisitor.hpp"
+
+#include "gtest/gtest.h"
+
+namespace lace::test {
+
+/// Counts the nodes of a few kinds, and walks only through what it counts.
+class Counter final : public StaticVisitor<Counter> {
+public:
+    uint32_t functions = 0;
+    uint32_t structs = 0;
+    uint32_t rets = 0;
+    uint32_t binaries = 0;
+    uint32_t integers = 0;
+
+    using StaticVisitor::visit;
+
+    void visit(AST& ast) {
+        for (Defn* defn : ast.get_defns())
+            dispatch(*defn);
+    }
+
+    void visit(FunctionDefn& node) {
+        ++functions;
+        if (node.has_body())
+            visit(*node.get_body());
+    }
+
+    void visit(StructDefn& node) { ++structs; }
+
+    void visit(BlockStmt& node) {
+        for (Stmt* stmt : node.get_stmts())
+            dispatch(*stmt);
+    }
+
+    void visit(RetStmt& node) {
+        ++rets;
+        if (node.has_expr())
+            dispatch(*node.get_expr());
+    }
+
+    void visit(BinaryOp& node) {
+        ++binaries;
+        dispatch(*node.get_lhs());
+        dispatch(*node.get_rhs());
+    }
+
+    void visit(IntegerLiteral& node) { ++integers; }
+};
+
+class StaticVisitorTests : public ::testing::Test {
+protected:
+    AST* ast;
+
+    void SetUp() override {
+        ast = nullptr;
+    }
+
+    void TearDown() override {
+        if (ast) {
+            delete ast;
+            ast = nullptr;
+        }
+    }
+};
+
+TEST_F(StaticVisitorTests, Dispatch_By_Kind) {
+    Parser parser(
+        "Box :: struct { x: s64 }\n"
+        "foo :: () -> s64 { ret 1 + 2 * 3; }\n"
+        "bar :: () -> void { ret; }\n"
+        "baz :: () -> void;\n");
+    EXPECT_NO_FATAL_FAILURE(ast = parser.parse());
+
+    Counter counter;
+    ast->accept(counter);
+
+    EXPECT_EQ(counter.functions, 3);
+    EXPECT_EQ(counter.structs, 1);
+    EXPECT_EQ(counter.rets, 2);
+    EXPECT_EQ(counter.binaries, 2);
+    EXPECT_EQ(counter.integers, 3);
+}
+
+} // namespace lace::test
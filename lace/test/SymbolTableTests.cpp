@@ -0,0 +1,93 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/tree/AST.hpp"
+#include "lace/tree/Defn.hpp"
+#include "lace/tree/Scope.hpp"
+#include "lace/tree/SymbolTable.hpp"
+#include "lace/tree/Type.hpp"
+
+#include "gtest/gtest.h"
+
+namespace lace::test {
+
+class SymbolTableTests : public ::testing::Test {
+protected:
+    AST* ast;
+
+    void SetUp() override {
+        ast = AST::create("test");
+    }
+
+    void TearDown() override {
+        delete ast;
+        ast = nullptr;
+    }
+
+    VariableDefn* var(Symbol name) {
+        AST::Context& ctx = ast->get_context();
+        return VariableDefn::create(ctx, {}, name, {}, 
+            BuiltinType::get(ctx, BuiltinType::Int64), nullptr, false);
+    }
+};
+
+TEST_F(SymbolTableTests, Shadow_And_Restore) {
+    SymbolTable table;
+    VariableDefn* outer = var("x");
+    VariableDefn* inner = var("x");
+    VariableDefn* other = var("y");
+
+    table.add(outer);
+    EXPECT_EQ(table.get("x"), outer);
+    EXPECT_EQ(table.get("y"), nullptr);
+
+    table.enter();
+    EXPECT_EQ(table.depth(), 1);
+    EXPECT_EQ(table.get("x"), outer);
+    EXPECT_EQ(table.get_local("x"), nullptr);
+
+    table.add(inner);
+    table.add(other);
+    EXPECT_EQ(table.get("x"), inner);
+    EXPECT_EQ(table.get_local("x"), inner);
+    EXPECT_EQ(table.get("y"), other);
+
+    table.exit();
+    EXPECT_EQ(table.depth(), 0);
+    EXPECT_EQ(table.get("x"), outer);
+    EXPECT_EQ(table.get_local("x"), outer);
+    EXPECT_EQ(table.get("y"), nullptr);
+}
+
+TEST_F(SymbolTableTests, Enter_Scope) {
+    Scope* global = ast->get_scope();
+    VariableDefn* a = var("a");
+    VariableDefn* b = var("b");
+    global->add(a);
+    global->add(b);
+
+    Scope* local = new (ast->get_context().get_arena()) Scope(global);
+    VariableDefn* c = var("a");
+    local->add(c);
+
+    SymbolTable table;
+    table.enter(global);
+    EXPECT_EQ(table.get("a"), a);
+    EXPECT_EQ(table.get("b"), b);
+
+    table.enter(local);
+    EXPECT_EQ(table.depth(), 2);
+    EXPECT_EQ(table.get("a"), c);
+    EXPECT_EQ(table.get("b"), b);
+
+    table.exit();
+    EXPECT_EQ(table.get("a"), a);
+
+    table.exit();
+    EXPECT_EQ(table.get("a"), nullptr);
+    EXPECT_EQ(table.get("b"), nullptr);
+}
+
+} // namespace lace::test
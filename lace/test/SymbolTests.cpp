@@ -0,0 +1,58 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/core/Symbol.hpp"
+#include "lace/core/ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+namespace lace::test {
+
+TEST(SymbolTests, Same_String_Same_Symbol) {
+    const Symbol a = "foo";
+    const Symbol b = std::string("foo");
+    const Symbol c = "bar";
+
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.get_id(), b.get_id());
+    EXPECT_NE(a, c);
+    EXPECT_EQ(a.str(), "foo");
+    EXPECT_EQ(c.str(), "bar");
+}
+
+TEST(SymbolTests, Empty) {
+    EXPECT_TRUE(Symbol().empty());
+    EXPECT_EQ(Symbol(""), Symbol());
+    EXPECT_EQ(Symbol().str(), "");
+    EXPECT_FALSE(Symbol("x").empty());
+}
+
+TEST(SymbolTests, Embedded_Null) {
+    const Symbol a = std::string("a\0b", 3);
+    EXPECT_EQ(a.str().size(), 3);
+    EXPECT_NE(a, Symbol("a"));
+}
+
+TEST(SymbolTests, Concurrent_Interning) {
+    // Every thread interns the same names, so they must all agree on the ids.
+    ThreadPool pool(4);
+    std::vector<std::vector<Symbol>> symbols(8);
+
+    pool.parallel_for(0, symbols.size(), [&symbols](uint32_t i) {
+        for (uint32_t j = 0; j < 5000; ++j)
+            symbols[i].push_back("concurrent_" + std::to_string(j));
+    });
+
+    for (uint32_t i = 1; i < symbols.size(); ++i)
+        EXPECT_EQ(symbols[i], symbols[0]);
+
+    for (uint32_t j = 0; j < 5000; ++j)
+        EXPECT_EQ(symbols[0][j].str(), "concurrent_" + std::to_string(j));
+}
+
+} // namespace lace::test
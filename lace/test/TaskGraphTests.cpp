@@ -0,0 +1,90 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/core/TaskGraph.hpp"
+#include "lace/core/ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+#include <mutex>
+#include <vector>
+
+namespace lace::test {
+
+class TaskGraphTests : public ::testing::Test {
+protected:
+    std::mutex mutex;
+    std::vector<uint32_t> order;
+
+    void SetUp() override {
+        order.clear();
+    }
+
+    /// Returns a job that records |id| to the shared order when run.
+    Job record(uint32_t id) {
+        return [this, id] {
+            std::lock_guard lock(mutex);
+            order.push_back(id);
+        };
+    }
+
+    /// Returns the position of |id| in the recorded order.
+    uint32_t position(uint32_t id) const {
+        for (uint32_t i = 0, e = order.size(); i != e; ++i)
+            if (order[i] == id)
+                return i;
+
+        return order.size();
+    }
+};
+
+TEST_F(TaskGraphTests, Serial_Chain) {
+    TaskGraph graph;
+    TaskGraph::Task c = graph.add(record(2));
+    TaskGraph::Task b = graph.add(record(1));
+    TaskGraph::Task a = graph.add(record(0));
+    graph.depend(b, a);
+    graph.depend(c, b);
+
+    graph.run();
+
+    EXPECT_EQ(order, (std::vector<uint32_t>{ 0, 1, 2 }));
+}
+
+TEST_F(TaskGraphTests, Pool_Diamond) {
+    ThreadPool pool(4);
+
+    TaskGraph graph;
+    TaskGraph::Task a = graph.add(record(0));
+    TaskGraph::Task b = graph.add(record(1));
+    TaskGraph::Task c = graph.add(record(2));
+    TaskGraph::Task d = graph.add(record(3));
+    graph.depend(b, a);
+    graph.depend(c, a);
+    graph.depend(d, b);
+    graph.depend(d, c);
+
+    graph.run(&pool);
+
+    ASSERT_EQ(order.size(), 4);
+    EXPECT_LT(position(0), position(1));
+    EXPECT_LT(position(0), position(2));
+    EXPECT_LT(position(1), position(3));
+    EXPECT_LT(position(2), position(3));
+}
+
+TEST_F(TaskGraphTests, Pool_Independent) {
+    ThreadPool pool(4);
+
+    TaskGraph graph;
+    for (uint32_t i = 0; i < 64; ++i)
+        graph.add(record(i));
+
+    graph.run(&pool);
+
+    EXPECT_EQ(order.size(), 64);
+}
+
+} // namespace lace::test
@@ -0,0 +1,100 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/core/ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace lace::test {
+
+TEST(ThreadPoolTests, Push_Wait) {
+    ThreadPool pool(4);
+    std::atomic<uint32_t> count = 0;
+
+    for (uint32_t i = 0; i < 100; ++i)
+        pool.push([&count] { ++count; });
+
+    pool.wait();
+    EXPECT_EQ(count.load(), 100);
+    EXPECT_EQ(pool.get_pending(), 0);
+}
+
+TEST(ThreadPoolTests, Dependencies) {
+    ThreadPool pool(4);
+    std::mutex mutex;
+    std::vector<uint32_t> order = {};
+
+    auto record = [&](uint32_t id) {
+        return [&, id] {
+            std::lock_guard lock(mutex);
+            order.push_back(id);
+        };
+    };
+
+    // 0 -> { 1, 2 } -> 3
+    ThreadPool::Task a = pool.push(record(0));
+    ThreadPool::Task b = pool.push(record(1), { a });
+    ThreadPool::Task c = pool.push(record(2), { a });
+    ThreadPool::Task d = pool.push(record(3), { b, c });
+
+    pool.wait(d);
+    EXPECT_TRUE(a.done() && b.done() && c.done() && d.done());
+
+    ASSERT_EQ(order.size(), 4);
+    EXPECT_EQ(order.front(), 0);
+    EXPECT_EQ(order.back(), 3);
+}
+
+TEST(ThreadPoolTests, Dependency_On_Finished_Task) {
+    ThreadPool pool(2);
+    ThreadPool::Task a = pool.push([] {});
+    pool.wait(a);
+
+    bool ran = false;
+    ThreadPool::Task b = pool.push([&ran] { ran = true; }, { a });
+    pool.wait(b);
+
+    EXPECT_TRUE(ran);
+}
+
+TEST(ThreadPoolTests, Async) {
+    ThreadPool pool(2);
+    std::future<uint32_t> a = pool.async([] { return 20u; });
+    std::future<uint32_t> b = pool.async([] { return 22u; });
+
+    EXPECT_EQ(a.get() + b.get(), 42);
+}
+
+TEST(ThreadPoolTests, ParallelFor) {
+    ThreadPool pool(4);
+    std::vector<uint32_t> values(1000, 0);
+
+    pool.parallel_for(0, values.size(), [&values](uint32_t i) {
+        values[i] = i * 2;
+    });
+
+    for (uint32_t i = 0, e = values.size(); i != e; ++i)
+        EXPECT_EQ(values[i], i * 2);
+}
+
+TEST(ThreadPoolTests, Nested_Wait_Single_Worker) {
+    // The only worker must run the inner jobs itself while it waits on them,
+    // or else it would deadlock.
+    ThreadPool pool(1);
+    std::atomic<uint32_t> sum = 0;
+
+    ThreadPool::Task outer = pool.push([&] {
+        pool.parallel_for(0, 16, [&sum](uint32_t i) { sum += i; });
+    });
+
+    pool.wait(outer);
+    EXPECT_EQ(sum.load(), 120);
+}
+
+} // namespace lace::test
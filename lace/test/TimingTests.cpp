@@ -0,0 +1,176 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/core/ThreadPool.hpp"
+#include "lace/core/Timing.hpp"
+
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+
+namespace lace::test {
+
+class TimingTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        timing::enable();
+    }
+
+    /// Returns the timing tree as JSON.
+    std::string json() const {
+        std::ostringstream os;
+        timing::write_json(os);
+        return os.str();
+    }
+
+    /// Returns the number of times the node named |name| was entered, as
+    /// reported in the timing tree.
+    uint32_t count(const std::string& name) const {
+        const std::string out = json();
+        const std::size_t node = out.find("\"" + name + "\"");
+        if (node == std::string::npos)
+            return 0;
+
+        const std::string key = "\"count\":";
+        return std::stoul(out.substr(out.find(key, node) + key.size()));
+    }
+};
+
+TEST_F(TimingTests, Nested_Regions) {
+    {
+        timing::Region outer("TimingTests.outer");
+        timing::Region inner("TimingTests.inner", "detail");
+    }
+
+    const std::string out = json();
+    const std::size_t outer = out.find("\"TimingTests.outer\"");
+    const std::size_t inner = out.find("\"TimingTests.inner\"");
+    const std::size_t detail = out.find("\"detail\"");
+
+    ASSERT_NE(outer, std::string::npos);
+    ASSERT_NE(inner, std::string::npos);
+    ASSERT_NE(detail, std::string::npos);
+    EXPECT_LT(outer, inner);
+    EXPECT_LT(inner, detail);
+}
+
+TEST_F(TimingTests, Restores_Current) {
+    const timing::Node before = timing::current();
+    {
+        timing::Region region("TimingTests.restore");
+        EXPECT_NE(timing::current(), before);
+    }
+
+    EXPECT_EQ(timing::current(), before);
+}
+
+TEST_F(TimingTests, Explicit_Parent) {
+    ThreadPool pool(2);
+    {
+        timing::Region region("TimingTests.parent");
+        const timing::Node parent = timing::current();
+
+        for (uint32_t i = 0; i < 4; ++i) {
+            pool.push([parent] {
+                timing::Region region(parent, "TimingTests.job");
+            });
+        }
+
+        pool.wait();
+    }
+
+    const std::string out = json();
+    const std::size_t parent = out.find("\"TimingTests.parent\"");
+    const std::size_t job = out.find("\"TimingTests.job\"");
+
+    ASSERT_NE(parent, std::string::npos);
+    ASSERT_NE(job, std::string::npos);
+    EXPECT_LT(parent, job);
+    EXPECT_NE(out.find("\"count\":4"), std::string::npos);
+}
+
+TEST_F(TimingTests, Merge_Exited_Threads) {
+    {
+        // The workers are gone by the time the tree is reported, but what 
+        // they recorded is not.
+        ThreadPool pool(2);
+        for (uint32_t i = 0; i < 6; ++i) {
+            pool.push([] {
+                timing::Region region(timing::Root, "TimingTests.exited");
+            });
+        }
+
+        pool.wait();
+    }
+
+    EXPECT_EQ(count("TimingTests.exited"), 6);
+
+    // Reporting again does not count anything twice.
+    EXPECT_EQ(count("TimingTests.exited"), 6);
+}
+
+TEST_F(TimingTests, Folded_Breakdown) {
+    {
+        timing::Region region(timing::Root, "TimingTests.folded", "fn", 
+            timing::Breakdown::Folded);
+    }
+
+    std::ostringstream os;
+    timing::print(os);
+    const std::string out = os.str();
+
+    // The breakdown is left out of the printed tree, but not the JSON.
+    EXPECT_NE(out.find("TimingTests.folded"), std::string::npos);
+    EXPECT_EQ(out.find("fn\n"), std::string::npos);
+    EXPECT_NE(json().find("\"fn\""), std::string::npos);
+}
+
+TEST_F(TimingTests, Trace_Events) {
+    timing::enable_trace();
+    {
+        timing::Region region("TimingTests.trace", "detail");
+    }
+
+    std::ostringstream os;
+    timing::write_trace(os);
+    const std::string out = os.str();
+
+    EXPECT_EQ(out.find("{\"traceEvents\":["), 0);
+    EXPECT_NE(out.find("\"name\":\"TimingTests.trace\""), std::string::npos);
+    EXPECT_NE(out.find("\"args\":{\"detail\":\"detail\"}"), std::string::npos);
+    EXPECT_NE(out.find("\"args\":{\"name\":\"main\"}"), std::string::npos);
+}
+
+TEST_F(TimingTests, Trace_Worker_Events) {
+    timing::enable_trace();
+    {
+        ThreadPool pool(2);
+        for (uint32_t i = 0; i < 4; ++i) {
+            pool.push([] {
+                timing::Region region(timing::Root, "TimingTests.traced");
+            });
+        }
+
+        pool.wait();
+    }
+
+    std::ostringstream os;
+    timing::write_trace(os);
+    const std::string out = os.str();
+
+    // Every event of the workers is written out, each on its own line.
+    uint32_t events = 0;
+    for (std::size_t pos = out.find("\"name\":\"TimingTests.traced\""); 
+      pos != std::string::npos; 
+      pos = out.find("\"name\":\"TimingTests.traced\"", pos + 1)) {
+        ++events;
+    }
+
+    EXPECT_EQ(events, 4);
+    EXPECT_NE(out.find("\"args\":{\"name\":\"worker "), std::string::npos);
+}
+
+} // namespace lace::test
@@ -0,0 +1,106 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lace/tree/AST.hpp"
+#include "lace/tree/Type.hpp"
+
+#include "gtest/gtest.h"
+
+namespace lace::test {
+
+class TypeTests : public ::testing::Test {
+protected:
+    AST* ast;
+
+    void SetUp() override {
+        ast = AST::create("test");
+    }
+
+    void TearDown() override {
+        delete ast;
+        ast = nullptr;
+    }
+
+    AST::Context& ctx() { return ast->get_context(); }
+
+    QualType s32() { return BuiltinType::get(ctx(), BuiltinType::Int32); }
+    QualType s64() { return BuiltinType::get(ctx(), BuiltinType::Int64); }
+};
+
+TEST_F(TypeTests, Structural_Types_Uniqued) {
+    EXPECT_EQ(PointerType::get(ctx(), s32()), PointerType::get(ctx(), s32()));
+    EXPECT_NE(PointerType::get(ctx(), s32()), PointerType::get(ctx(), s64()));
+
+    EXPECT_EQ(ArrayType::get(ctx(), s32(), 4), ArrayType::get(ctx(), s32(), 4));
+    EXPECT_NE(ArrayType::get(ctx(), s32(), 4), ArrayType::get(ctx(), s32(), 5));
+
+    const QualType ptr = PointerType::get(ctx(), s32());
+    EXPECT_EQ(FunctionType::get(ctx(), s64(), { ptr, s32() }),
+              FunctionType::get(ctx(), s64(), { ptr, s32() }));
+    EXPECT_NE(FunctionType::get(ctx(), s64(), { ptr, s32() }),
+              FunctionType::get(ctx(), s64(), { s32(), ptr }));
+    EXPECT_NE(FunctionType::get(ctx(), s64(), {}),
+              FunctionType::get(ctx(), s32(), {}));
+
+    EXPECT_EQ(DeferredType::get(ctx(), "foo"), DeferredType::get(ctx(), "foo"));
+}
+
+TEST_F(TypeTests, Qualifiers_Canonical) {
+    const QualType mut_s32 = QualType(s32().get_type(), QualType::Mut);
+
+    const PointerType* ptr = PointerType::get(ctx(), s32());
+    const PointerType* mut_ptr = PointerType::get(ctx(), mut_s32);
+
+    // The qualifiers of nested types are kept, but do not count for equality.
+    EXPECT_NE(ptr, mut_ptr);
+    EXPECT_EQ(mut_ptr->to_string(), "*mut s32");
+    EXPECT_EQ(mut_ptr->get_canonical(), ptr);
+    EXPECT_TRUE(QualType(ptr).compare(mut_ptr));
+    EXPECT_TRUE(QualType(ptr).is_canonical());
+    EXPECT_FALSE(QualType(mut_ptr).is_canonical());
+
+    const Type* nested = PointerType::get(ctx(), mut_ptr);
+    EXPECT_EQ(nested->get_canonical(), PointerType::get(ctx(), ptr));
+    EXPECT_FALSE(QualType(nested).compare(ptr));
+}
+
+TEST_F(TypeTests, Compare_Across_Contexts) {
+    AST* other = AST::create("other");
+    AST::Context& octx = other->get_context();
+
+    const QualType here = PointerType::get(ctx(), s32());
+    const QualType there = PointerType::get(
+        octx, BuiltinType::get(octx, BuiltinType::Int32));
+    const QualType wrong = PointerType::get(
+        octx, BuiltinType::get(octx, BuiltinType::Int64));
+
+    EXPECT_NE(here.get_type(), there.get_type());
+    EXPECT_TRUE(here.compare(there));
+    EXPECT_TRUE(there.compare(here));
+    EXPECT_FALSE(here.compare(wrong));
+
+    delete other;
+}
+
+TEST_F(TypeTests, Compare_Foreign_Components) {
+    AST* other = AST::create("other");
+    AST::Context& octx = other->get_context();
+
+    // A pointer made here to a type owned by another context, e.g. to a field
+    // of a structure loaded from another file, is not uniqued with one made 
+    // here to the same type of this context, but is still equal to it.
+    const QualType foreign = PointerType::get(
+        ctx(), BuiltinType::get(octx, BuiltinType::Int64));
+    const QualType local = PointerType::get(ctx(), s64());
+
+    EXPECT_NE(foreign->get_canonical(), local->get_canonical());
+    EXPECT_TRUE(foreign.compare(local));
+    EXPECT_TRUE(local.compare(foreign));
+    EXPECT_FALSE(foreign.compare(PointerType::get(ctx(), s32())));
+
+    delete other;
+}
+
+} // namespace lace::test
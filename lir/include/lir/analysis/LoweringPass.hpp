@@ -7,15 +7,18 @@
 #define LOVELACE_IR_LOWERING_PASS_H_
 
 #include "lir/analysis/Pass.hpp"
+#include "lir/analysis/PassInstrumentation.hpp"
 #include "lir/machine/Segment.hpp"
 
 namespace lir {
 
 class LoweringPass final : public Pass {
     Segment& m_seg;
+    PassInstrumentation* m_instr;
 
 public:
-    LoweringPass(CFG& cfg, Segment& seg) : Pass(cfg), m_seg(seg) {}
+    LoweringPass(CFG& cfg, Segment& seg, PassInstrumentation* instr = nullptr) 
+      : Pass(cfg), m_seg(seg), m_instr(instr) {}
 
     void run() override;
 };
@@ -0,0 +1,37 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_IR_PASS_INSTRUMENTATION_H_
+#define LOVELACE_IR_PASS_INSTRUMENTATION_H_
+
+//
+//  This header file declares the PassInstrumentation class, an interface for
+//  observing the per-function work done by backend passes, e.g. to time it.
+//
+
+#include <string>
+
+namespace lir {
+
+/// Callbacks made around the work a pass does on each function.
+///
+/// For a given pass, callbacks are made from the thread that runs it, and a
+/// call to before is always matched by a call to after.
+class PassInstrumentation {
+public:
+    virtual ~PassInstrumentation() = default;
+
+    /// Called before a pass starts working on a function, with the name of the
+    /// pass and then the name of the function.
+    virtual void before(const char*, const std::string&) {}
+
+    /// Called after a pass finishes working on a function, with the name of the
+    /// pass and then the name of the function.
+    virtual void after(const char*, const std::string&) {}
+};
+
+} // namespace lir
+
+#endif // LOVELACE_IR_PASS_INSTRUMENTATION_H_
@@ -11,6 +11,7 @@
 //  representation (IR).
 //
 
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <string>
@@ -38,13 +39,16 @@ public:
     };
 
 private:
-    static uint32_t s_id;
+    /// Global type id counter. This is atomic since graphs for different 
+    /// translation units may be built concurrently by the backend.
+    static std::atomic<uint32_t> s_id;
 
 protected:
     const uint32_t m_id;
     const Class m_cls;
 
-    Type(Class cls) : m_id(s_id++), m_cls(cls) {}
+    Type(Class cls) 
+      : m_id(s_id.fetch_add(1, std::memory_order_relaxed)), m_cls(cls) {}
 
 public:
     virtual ~Type() = default;
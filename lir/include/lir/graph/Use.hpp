@@ -18,13 +18,22 @@ namespace lir {
 class User;
 
 /// Represents a use; the edge between a value and a user of it.
+///
+/// Each use is also a link in the list of uses of its value, so that uses can
+/// be added to and removed from a value in constant time.
 class Use final {
+    friend class Value;
+
     /// The value being used.
     Value* m_value;
 
     /// The value/user that is using the value in the edge.
     User* m_user;
 
+    /// The uses of the same value before and after this one.
+    Use* m_prev = nullptr;
+    Use* m_next = nullptr;
+
 public:
     Use(Value* value, User* user) : m_value(value), m_user(user) { 
         value->add_use(this); 
@@ -64,6 +73,14 @@ public:
 
     const User* get_user() const { return m_user; }
     User* get_user() { return m_user; }
+
+    /// Returns the use of the same value before this one, if it exists.
+    const Use* get_prev() const { return m_prev; }
+    Use* get_prev() { return m_prev; }
+
+    /// Returns the use of the same value after this one, if it exists.
+    const Use* get_next() const { return m_next; }
+    Use* get_next() { return m_next; }
 };
 
 } // namespace lir
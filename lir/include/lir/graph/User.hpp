@@ -21,9 +21,12 @@ namespace lir {
 
 /// A special kind of value that uses other values.
 class User : public Value {
+public:
+    using Operands = std::vector<Use*>;
+
 protected:
     /// The operands of this user, or "use" edges, that model a use-def chain.
-    Uses m_operands = {};
+    Operands m_operands = {};
 
     User(Type* type, const std::vector<Value*>& ops = {}) : Value(type) {
         for (Value* const& v : ops)
@@ -40,8 +43,8 @@ public:
         m_operands.clear();
     }
 
-    const Uses& get_operand_list() const { return m_operands; }
-    Uses& get_operand_list() { return m_operands; }
+    const Operands& get_operand_list() const { return m_operands; }
+    Operands& get_operand_list() { return m_operands; }
 
     const Use* get_operand(uint32_t i) const {
         assert(i < num_operands() && "index out of bounds!");
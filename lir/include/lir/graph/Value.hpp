@@ -13,9 +13,9 @@
 
 #include "lir/graph/Type.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <ostream>
-#include <vector>
 
 namespace lir {
 
@@ -28,16 +28,56 @@ enum class PrintPolicy {
     Use,
 };
 
-/// A typed value in the IR.
-class Value {
+/// An iterator over the uses of a value, which follows the links between the
+/// uses themselves. |U| is either Use or const Use.
+template<typename U>
+class UseIterator final {
+    U* m_use;
+
+public:
+    using value_type = U*;
+    using difference_type = std::ptrdiff_t;
+
+    UseIterator(U* use = nullptr) : m_use(use) {}
+
+    U* operator*() const { return m_use; }
+
+    UseIterator& operator++() {
+        m_use = m_use->get_next();
+        return *this;
+    }
+
+    UseIterator operator++(int) {
+        UseIterator prev = *this;
+        ++*this;
+        return prev;
+    }
+
+    bool operator==(const UseIterator& other) const = default;
+};
+
+/// A range over the uses of a value.
+template<typename U>
+class UseRange final {
+    U* m_head;
+
 public:
-    using Uses = std::vector<Use*>;
+    UseRange(U* head) : m_head(head) {}
 
+    UseIterator<U> begin() const { return UseIterator<U>(m_head); }
+    UseIterator<U> end() const { return UseIterator<U>(); }
+};
+
+/// A typed value in the IR.
+class Value {
 protected:
     Type* m_type;
 
-    /// The borrowed uses of this value. 
-    Uses m_uses = {};
+    /// The borrowed uses of this value, as an intrusive list threaded through
+    /// the uses themselves, in the order they were added.
+    Use* m_use_head = nullptr;
+    Use* m_use_tail = nullptr;
+    uint32_t m_num_uses = 0;
     
     Value(Type* type) : m_type(type) {}
 
@@ -47,30 +87,31 @@ public:
     void set_type(Type* type) { m_type = type; }
     Type* get_type() const { return m_type; }
 
-    const Uses& uses() const { return m_uses; }
-    Uses& uses() { return m_uses; }
+    UseRange<const Use> uses() const { return m_use_head; }
+    UseRange<Use> uses() { return m_use_head; }
 
     /// Returns the first use of this value, if it exists.
-    const Use* use_front() const { return m_uses.front(); }
-    Use* use_front() { return m_uses.front(); }
+    const Use* use_front() const { return m_use_head; }
+    Use* use_front() { return m_use_head; }
 
     /// Returns the latest use of this value, if it exists.
-    const Use* use_back() const { return m_uses.back(); }
-    Use* use_back() { return m_uses.back(); }
+    const Use* use_back() const { return m_use_tail; }
+    Use* use_back() { return m_use_tail; }
 
     /// Returns the number of times this value is used.
-    uint32_t num_uses() const { return m_uses.size(); }
+    uint32_t num_uses() const { return m_num_uses; }
 
     /// Returns true if this value has atleast one use.
-    bool used() const { return !m_uses.empty(); }
+    bool used() const { return m_use_head != nullptr; }
 
     /// Returns true if this value has exactly one use.
-    bool has_one_use() const { return m_uses.size() == 1; }
+    bool has_one_use() const { return m_num_uses == 1; }
 
-    /// Add |use| to the uses of this value.
-    void add_use(Use* use) { m_uses.push_back(use); }
+    /// Add |use| to the back of the uses of this value.
+    void add_use(Use* use);
 
-    /// Removes the edge |use| from this value, if it exists.
+    /// Removes the edge |use| from this value. |use| must be a use of this 
+    /// value.
     void del_use(Use* use);
 
     /// Replace all uses of this value with the given |value|.
@@ -0,0 +1,172 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_IR_INST_ENCODER_H_
+#define LOVELACE_IR_INST_ENCODER_H_
+
+//
+//  This header file declares the InstEncoder class, which encodes the
+//  instructions of a machine function directly into X64 machine code, as well
+//  as the Relocation type used to describe references that can only be
+//  resolved once the code is placed into an object file.
+//
+
+#include "lir/machine/MachFunction.hpp"
+#include "lir/machine/MachInst.hpp"
+#include "lir/machine/MachOperand.hpp"
+#include "lir/machine/Register.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lir {
+
+/// A reference from encoded code to a location that is not known until the
+/// code is laid out in an object file.
+struct Relocation final {
+    /// The recognized kinds of relocations.
+    enum Kind : uint8_t {
+        /// 32-bit, PC-relative displacement.
+        PC32,
+        /// 32-bit, PC-relative call target.
+        PLT32,
+        /// 32-bit, sign-extended absolute address.
+        Abs32S,
+    };
+
+    Kind kind;
+
+    /// The offset of the 4-byte field to patch, relative to the start of the
+    /// code buffer.
+    uint32_t offset;
+
+    /// The addend of this relocation, already adjusted for PC-relative kinds.
+    int64_t addend;
+
+    /// The target symbol of this relocation. If empty, then the target is the
+    /// entry |constant| in the constant pool of the function.
+    std::string symbol;
+    uint32_t constant = 0;
+};
+
+/// Encodes the instructions of a single machine function into X64 machine
+/// code, including the prologue and epilogue also emitted by the AsmWriter.
+///
+/// References to labels within the function are resolved by the encoder
+/// itself, whereas references to constants and symbols are left as
+/// relocations.
+class InstEncoder final {
+    /// A reference to a label in the function being encoded.
+    struct LabelFixup final {
+        /// The offset of the 4-byte field to patch.
+        uint32_t offset;
+
+        /// The offset of the end of the referencing instruction.
+        uint32_t end;
+
+        const MachLabel* label;
+    };
+
+    const MachFunction& m_func;
+    std::vector<uint8_t>& m_code;
+    std::vector<Relocation>& m_relocs;
+
+    /// The offsets of each label in the function, relative to |m_code|.
+    std::unordered_map<const MachLabel*, uint32_t> m_labels = {};
+
+    /// The pending label references in the function.
+    std::vector<LabelFixup> m_fixups = {};
+
+    /// The first relocation and label fixup of the instruction currently
+    /// being encoded, used to adjust PC-relative fields once its length is
+    /// known.
+    uint32_t m_inst_relocs = 0;
+    uint32_t m_inst_fixups = 0;
+
+    /// Returns the allocated physical register for the given |reg|.
+    X64_Register map_register(Register reg) const;
+
+    /// Test if the given |inst| is a redundant move instruction, i.e. a move
+    /// between the same physical register.
+    bool is_redundant_move(const MachInst& inst) const;
+
+    void emit_byte(uint8_t byte) { m_code.push_back(byte); }
+
+    /// Emit the |bytes| low-order bytes of |value| in little-endian order.
+    void emit_value(uint64_t value, uint32_t bytes);
+
+    /// Emit a REX prefix if one is needed. |w| is REX.W, while |reg| and 
+    /// |base| are the full hardware numbers of the registers encoded in the 
+    /// ModR/M byte. If |force| is set, then an empty prefix is emitted even 
+    /// if no bits are needed, as is required to address %spl, %bpl, %sil and 
+    /// %dil.
+    void emit_rex(bool w, uint8_t reg, uint8_t base, bool force = false);
+
+    /// Emit the ModR/M byte, and any SIB and displacement bytes, to address
+    /// the register or memory operand |rm| with |reg| in the reg field.
+    void emit_modrm(uint8_t reg, const MachOperand& rm);
+
+    /// Emit an instruction comprised of the optional mandatory |prefix|,
+    /// the opcode |op| of |op_len| bytes, and a ModR/M for |reg| and |rm|.
+    /// The operand size is |size| bytes, which decides the operand size
+    /// prefix and REX.W. |force_rex| is forwarded to emit_rex.
+    void emit_op(uint8_t prefix, uint32_t op, uint32_t op_len, uint32_t size,
+                 uint8_t reg, const MachOperand& rm, bool force_rex = false);
+
+    /// Returns the hardware number for the given register |op|.
+    uint8_t hw_reg(const MachOperand& op) const;
+
+    /// Returns the size in bytes of the register |op|.
+    uint32_t reg_size(const MachOperand& op) const;
+
+    /// Test if the given |op| is an SSE register.
+    bool is_xmm(const MachOperand& op) const;
+
+    /// Test if the given |op| is one of the byte registers that can only be
+    /// addressed with a REX prefix.
+    bool needs_rex(const MachOperand& op) const;
+
+    /// Returns the operand size of |inst| in bytes, using the register
+    /// operands in |inst| when the instruction has no explicit size.
+    uint32_t op_size(const MachInst& inst) const;
+
+    void encode_alu(const MachInst& inst, uint8_t ext);
+    void encode_mov(const MachInst& inst);
+    void encode_unary(const MachInst& inst, uint8_t ext);
+    void encode_shift(const MachInst& inst, uint8_t ext);
+    void encode_imul(const MachInst& inst);
+    void encode_extend(const MachInst& inst);
+    void encode_sse(const MachInst& inst, uint8_t prefix, uint8_t op);
+    void encode_convert(const MachInst& inst, uint8_t prefix, uint8_t op);
+    void encode_branch(const MachInst& inst);
+    void encode_epilogue();
+
+    /// Adjust the PC-relative references of the instruction just encoded, now
+    /// that its length is known.
+    void finish_inst();
+
+    /// Encode the given |inst| to the code buffer.
+    void encode(const MachInst& inst);
+
+public:
+    InstEncoder(const MachFunction& func, std::vector<uint8_t>& code,
+                std::vector<Relocation>& relocs);
+
+    InstEncoder(const InstEncoder&) = delete;
+    void operator=(const InstEncoder&) = delete;
+
+    InstEncoder(InstEncoder&&) noexcept = delete;
+    void operator=(InstEncoder&&) noexcept = delete;
+
+    /// Encode the function, appending its code to the code buffer and any
+    /// unresolved references to the list of relocations.
+    void run();
+};
+
+} // namespace lir
+
+#endif // LOVELACE_IR_INST_ENCODER_H_
@@ -0,0 +1,140 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_IR_LINKER_H_
+#define LOVELACE_IR_LINKER_H_
+
+//
+//  This header file declares the Linker class, which links a set of ELF64
+//  relocatable objects, such as those made by the ObjectWriter, into a static
+//  executable.
+//
+
+#include <elf.h>
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lir {
+
+/// A minimal static linker for X64 Linux.
+///
+/// Objects are laid out in the order they are added, with all read-only data
+/// in the first segment, code in the second, and writable data in the third.
+/// Only the relocation kinds produced by the ObjectWriter and typical
+/// assemblers for non-PIC code are supported.
+class Linker final {
+    /// The segments of an executable, in the order they are laid out.
+    enum SegmentKind : uint32_t {
+        SegmentRodata = 0,
+        SegmentText,
+        SegmentData,
+        NumSegments,
+    };
+
+    /// An allocated section of an input object.
+    struct InputSection final {
+        SegmentKind segment;
+
+        /// The offset of this section in the output file.
+        uint64_t offset;
+
+        /// The virtual address of this section in the executable.
+        uint64_t address;
+    };
+
+    /// A relocatable object to be linked.
+    struct InputObject final {
+        std::string name;
+        std::string image;
+
+        std::vector<Elf64_Shdr> sections = {};
+        std::vector<Elf64_Sym> symbols = {};
+
+        /// The string table of the symbol table.
+        const char* strtab = nullptr;
+        uint64_t strtab_size = 0;
+
+        /// The layout of each section, by section index. Sections which are
+        /// not allocated in the executable have no layout.
+        std::unordered_map<uint16_t, InputSection> layout = {};
+    };
+
+    /// A global symbol defined in one of the input objects.
+    struct Definition final {
+        uint64_t address;
+        bool weak;
+        const InputObject* object;
+    };
+
+    /// Information about a segment of the executable.
+    struct Segment final {
+        uint64_t offset = 0;
+        uint64_t address = 0;
+        uint64_t file_size = 0;
+        uint64_t mem_size = 0;
+    };
+
+    std::vector<InputObject> m_objects = {};
+    std::unordered_map<std::string, Definition> m_globals = {};
+    std::vector<std::string> m_errors = {};
+
+    Segment m_segments[NumSegments] = {};
+
+    /// The contents of the executable file.
+    std::vector<uint8_t> m_image = {};
+
+    /// Returns the name of |sym| in |obj|.
+    const char* get_name(const InputObject& obj, const Elf64_Sym& sym) const;
+
+    /// Parse the section headers and symbol table of |obj|.
+    bool parse(InputObject& obj);
+
+    /// Assign an output segment and address to every allocated section.
+    void layout();
+
+    /// Add the global symbols defined in each object to the global table.
+    void define_globals();
+
+    /// Resolve the symbol |index| in |obj| to an address, returning false if
+    /// it could not be resolved.
+    bool resolve(const InputObject& obj, uint32_t index, uint64_t& address);
+
+    /// Copy the contents of each section into the executable, and apply the
+    /// relocations against them.
+    void relocate(const InputObject& obj);
+
+public:
+    Linker() = default;
+
+    Linker(const Linker&) = delete;
+    void operator=(const Linker&) = delete;
+
+    Linker(Linker&&) noexcept = delete;
+    void operator=(Linker&&) noexcept = delete;
+
+    /// Add a relocatable object named |name| with the contents |image| to be
+    /// linked.
+    void add_object(const std::string& name, std::string image) {
+        m_objects.push_back({ name, std::move(image) });
+    }
+
+    /// Returns the errors that occured during linking, if any.
+    const std::vector<std::string>& get_errors() const { return m_errors; }
+
+    /// Link the objects and write the executable to |os|. The program entry
+    /// point is the global symbol `_start`.
+    ///
+    /// Returns false if the objects could not be linked, in which case
+    /// nothing is written and the reasons why can be found with get_errors.
+    bool run(std::ostream& os);
+};
+
+} // namespace lir
+
+#endif // LOVELACE_IR_LINKER_H_
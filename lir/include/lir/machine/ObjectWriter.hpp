@@ -0,0 +1,85 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#ifndef LOVELACE_IR_OBJECT_WRITER_H_
+#define LOVELACE_IR_OBJECT_WRITER_H_
+
+//
+//  This header file declares the ObjectWriter class, which writes a segment
+//  of machine functions and its globals out as an ELF64 relocatable object
+//  file, without going through an external assembler.
+//
+
+#include "lir/graph/Constant.hpp"
+#include "lir/graph/Global.hpp"
+#include "lir/machine/InstEncoder.hpp"
+#include "lir/machine/MachFunction.hpp"
+#include "lir/machine/Segment.hpp"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace lir {
+
+class ObjectWriter final {
+    /// A symbol to be placed in the object symbol table.
+    struct Symbol final {
+        std::string name;
+
+        /// The index of the section this symbol is defined in, or 0 if the
+        /// symbol is undefined.
+        uint16_t section;
+
+        uint8_t type;
+        uint8_t bind;
+        uint64_t value;
+        uint64_t size;
+    };
+
+    const Segment& m_seg;
+
+    std::vector<uint8_t> m_text = {};
+    std::vector<uint8_t> m_rodata = {};
+    std::vector<uint8_t> m_data = {};
+
+    /// Relocations against the text section. Relocations to constants have
+    /// already been rewritten to be relative to the start of the read-only
+    /// data section.
+    std::vector<Relocation> m_relocs = {};
+
+    std::vector<Symbol> m_locals = {};
+    std::vector<Symbol> m_globals = {};
+
+    /// Append zero bytes to |section| until its size is aligned to |align|.
+    static void align_to(std::vector<uint8_t>& section, uint32_t align);
+
+    /// Emit |constant| to the end of |section|, padded to the size of its
+    /// type.
+    void emit_constant(std::vector<uint8_t>& section, const Constant& constant);
+
+    /// Emit |global| to the relevant data section and add its symbol.
+    void emit_global(const Global& global);
+
+    /// Emit the constant pool and code of |func|, and add its symbol.
+    void emit_function(const MachFunction& func);
+
+public:
+    ObjectWriter(const Segment& seg) : m_seg(seg) {}
+
+    ObjectWriter(const ObjectWriter&) = delete;
+    void operator=(const ObjectWriter&) = delete;
+
+    ObjectWriter(ObjectWriter&&) noexcept = delete;
+    void operator=(ObjectWriter&&) noexcept = delete;
+
+    /// Write the segment as a relocatable object file to |os|.
+    void run(std::ostream& os);
+};
+
+} // namespace lir
+
+#endif // LOVELACE_IR_OBJECT_WRITER_H_
@@ -6,15 +6,18 @@
 #ifndef LOVELACE_IR_REGISTER_ANALYSIS_H_
 #define LOVELACE_IR_REGISTER_ANALYSIS_H_
 
+#include "lir/analysis/PassInstrumentation.hpp"
 #include "lir/machine/Segment.hpp"
 
 namespace lir {
 
 class RegisterAnalysis {
     Segment& m_seg;
+    PassInstrumentation* m_instr;
 
 public:
-    RegisterAnalysis(Segment& seg) : m_seg(seg) {}
+    RegisterAnalysis(Segment& seg, PassInstrumentation* instr = nullptr) 
+      : m_seg(seg), m_instr(instr) {}
 
     void run();
 };
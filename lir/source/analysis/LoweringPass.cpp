@@ -26,7 +26,13 @@ void LoweringPass::run() {
             curr = curr->get_next();
         }
 
+        if (m_instr)
+            m_instr->before("isel", function->get_name());
+
         InstSelector isel(*mach_function);
         isel.run();
+
+        if (m_instr)
+            m_instr->after("isel", function->get_name());
     }
 }
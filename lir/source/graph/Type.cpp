@@ -8,7 +8,7 @@
 
 using namespace lir;
 
-uint32_t Type::s_id = 0;
+std::atomic<uint32_t> Type::s_id = 0;
 
 VoidType* Type::get_void_type(CFG& cfg) {
     return cfg.m_types.void_type;
@@ -6,18 +6,70 @@
 #include "lir/graph/Use.hpp"
 #include "lir/graph/Value.hpp"
 
-#include <algorithm>
+#include <cassert>
 
 using namespace lir;
 
+void Value::add_use(Use* use) {
+    assert(use && "use cannot be null!");
+
+    use->m_prev = m_use_tail;
+    use->m_next = nullptr;
+
+    if (m_use_tail) {
+        m_use_tail->m_next = use;
+    } else {
+        m_use_head = use;
+    }
+
+    m_use_tail = use;
+    ++m_num_uses;
+}
+
 void Value::del_use(Use* use) {
-    auto it = std::find(m_uses.begin(), m_uses.end(), use);
-    if (it != m_uses.end())
-        m_uses.erase(it);
+    assert(use && "use cannot be null!");
+    assert(use->m_value == this && "use is not of this value!");
+
+    if (use->m_prev) {
+        use->m_prev->m_next = use->m_next;
+    } else {
+        m_use_head = use->m_next;
+    }
+
+    if (use->m_next) {
+        use->m_next->m_prev = use->m_prev;
+    } else {
+        m_use_tail = use->m_prev;
+    }
+
+    use->m_prev = use->m_next = nullptr;
+    --m_num_uses;
 }
 
 void Value::replace_all_uses_with(Value* value) {
-    std::vector<Use*> uses_copy = m_uses;
-    for (Use* use : uses_copy)
-        use->set_value(value);
+    assert(value && "replacement value cannot be null!");
+    
+    if (value == this)
+        return;
+
+    // Every use is retargeted as it is moved, and then the whole list is 
+    // spliced onto the back of the uses of |value| at once.
+    for (Use* use = m_use_head; use; use = use->m_next)
+        use->m_value = value;
+
+    if (!m_use_head)
+        return;
+
+    m_use_head->m_prev = value->m_use_tail;
+    if (value->m_use_tail) {
+        value->m_use_tail->m_next = m_use_head;
+    } else {
+        value->m_use_head = m_use_head;
+    }
+
+    value->m_use_tail = m_use_tail;
+    value->m_num_uses += m_num_uses;
+
+    m_use_head = m_use_tail = nullptr;
+    m_num_uses = 0;
 }
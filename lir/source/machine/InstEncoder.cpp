@@ -0,0 +1,844 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lir/machine/InstEncoder.hpp"
+#include "lir/machine/MachFunction.hpp"
+#include "lir/machine/MachInst.hpp"
+#include "lir/machine/MachLabel.hpp"
+#include "lir/machine/MachOperand.hpp"
+#include "lir/machine/Register.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+using namespace lir;
+
+/// Test if the given |value| fits in a signed 8-bit immediate.
+static bool is_int8(int64_t value) {
+    return std::numeric_limits<int8_t>::min() <= value &&
+        value <= std::numeric_limits<int8_t>::max();
+}
+
+/// Test if the given |value| fits in a signed 32-bit immediate.
+static bool is_int32(int64_t value) {
+    return std::numeric_limits<int32_t>::min() <= value &&
+        value <= std::numeric_limits<int32_t>::max();
+}
+
+/// Test if the given |op| addresses memory in some way.
+static bool is_memory(const MachOperand& op) {
+    return op.is_mem() || op.is_stack() || op.is_constant() || op.is_symbol();
+}
+
+/// Returns the condition code encoded in the JCC and SETCC opcodes for the
+/// given |op|.
+static uint8_t to_condition(X64_Mnemonic op) {
+    switch (op) {
+        case X64_Mnemonic::JB:
+        case X64_Mnemonic::SETB:
+            return 0x2;
+        case X64_Mnemonic::JAE:
+        case X64_Mnemonic::SETAE:
+            return 0x3;
+        case X64_Mnemonic::JE:
+        case X64_Mnemonic::JZ:
+        case X64_Mnemonic::SETE:
+        case X64_Mnemonic::SETZ:
+            return 0x4;
+        case X64_Mnemonic::JNE:
+        case X64_Mnemonic::JNZ:
+        case X64_Mnemonic::SETNE:
+        case X64_Mnemonic::SETNZ:
+            return 0x5;
+        case X64_Mnemonic::JBE:
+        case X64_Mnemonic::SETBE:
+            return 0x6;
+        case X64_Mnemonic::JA:
+        case X64_Mnemonic::SETA:
+            return 0x7;
+        case X64_Mnemonic::JL:
+        case X64_Mnemonic::SETL:
+            return 0xC;
+        case X64_Mnemonic::JGE:
+        case X64_Mnemonic::SETGE:
+            return 0xD;
+        case X64_Mnemonic::JLE:
+        case X64_Mnemonic::SETLE:
+            return 0xE;
+        case X64_Mnemonic::JG:
+        case X64_Mnemonic::SETG:
+            return 0xF;
+        default:
+            assert(false && "mnemonic has no condition code!");
+    }
+}
+
+/// Returns the hardware encoding of the given physical |reg|.
+static uint8_t to_hardware(X64_Register reg) {
+    switch (reg) {
+        case RAX:   return 0;
+        case RCX:   return 1;
+        case RDX:   return 2;
+        case RBX:   return 3;
+        case RSP:   return 4;
+        case RBP:   return 5;
+        case RSI:   return 6;
+        case RDI:   return 7;
+        case R8:    return 8;
+        case R9:    return 9;
+        case R10:   return 10;
+        case R11:   return 11;
+        case R12:   return 12;
+        case R13:   return 13;
+        case R14:   return 14;
+        case R15:   return 15;
+        default:
+            if (XMM0 <= reg && reg <= XMM15)
+                return reg - XMM0;
+
+            assert(false && "register has no hardware encoding!");
+    }
+}
+
+InstEncoder::InstEncoder(const MachFunction& func, std::vector<uint8_t>& code,
+                         std::vector<Relocation>& relocs)
+  : m_func(func), m_code(code), m_relocs(relocs) {}
+
+X64_Register InstEncoder::map_register(Register reg) const {
+    if (reg.is_virtual())
+        reg = m_func.get_register_table().at(reg.id()).alloc;
+
+    return static_cast<X64_Register>(reg.id());
+}
+
+bool InstEncoder::is_redundant_move(const MachInst& inst) const {
+    if (inst.op() != X64_Mnemonic::MOV || inst.num_operands() != 2)
+        return false;
+
+    const MachOperand& left = inst.get_operand(0);
+    const MachOperand& right = inst.get_operand(1);
+
+    if (!left.is_reg() || !right.is_reg())
+        return false;
+
+    return map_register(left.get_reg()) == map_register(right.get_reg()) &&
+        left.get_subreg() == right.get_subreg();
+}
+
+uint8_t InstEncoder::hw_reg(const MachOperand& op) const {
+    return to_hardware(map_register(op.get_reg()));
+}
+
+uint32_t InstEncoder::reg_size(const MachOperand& op) const {
+    return op.get_subreg() == 0 ? 8 : op.get_subreg();
+}
+
+bool InstEncoder::is_xmm(const MachOperand& op) const {
+    if (!op.is_reg())
+        return false;
+
+    const X64_Register reg = map_register(op.get_reg());
+    return XMM0 <= reg && reg <= XMM15;
+}
+
+bool InstEncoder::needs_rex(const MachOperand& op) const {
+    if (!op.is_reg() || is_xmm(op) || reg_size(op) != 1)
+        return false;
+
+    const uint8_t hw = hw_reg(op);
+    return 4 <= hw && hw <= 7;
+}
+
+uint32_t InstEncoder::op_size(const MachInst& inst) const {
+    switch (inst.size()) {
+        case X64_Size::Byte:
+            return 1;
+        case X64_Size::Word:
+            return 2;
+        case X64_Size::Long:
+        case X64_Size::Single:
+            return 4;
+        case X64_Size::Quad:
+        case X64_Size::Double:
+            return 8;
+        case X64_Size::None:
+            break;
+    }
+
+    // Without an explicit size, the destination register decides it, just as
+    // it would for the assembler.
+    for (uint32_t i = inst.num_explicit_operands(); i-- > 0; ) {
+        const MachOperand& op = inst.get_operand(i);
+        if (op.is_reg() && !is_xmm(op))
+            return reg_size(op);
+    }
+
+    return 8;
+}
+
+void InstEncoder::emit_value(uint64_t value, uint32_t bytes) {
+    for (uint32_t i = 0; i < bytes; ++i)
+        emit_byte(static_cast<uint8_t>(value >> (i * 8)));
+}
+
+void InstEncoder::emit_rex(bool w, uint8_t reg, uint8_t base, bool force) {
+    const uint8_t rex = 0x40 | (w << 3) | ((reg >> 3) << 2) | (base >> 3);
+    if (rex != 0x40 || force)
+        emit_byte(rex);
+}
+
+void InstEncoder::emit_modrm(uint8_t reg, const MachOperand& rm) {
+    reg &= 7;
+
+    switch (rm.kind()) {
+        case MachOperand::Reg:
+            emit_byte(0xC0 | (reg << 3) | (hw_reg(rm) & 7));
+            return;
+
+        case MachOperand::Constant:
+            // RIP-relative reference to the constant pool.
+            emit_byte(0x05 | (reg << 3));
+            m_relocs.push_back({
+                Relocation::PC32,
+                static_cast<uint32_t>(m_code.size()),
+                0,
+                "",
+                rm.get_constant()
+            });
+            emit_value(0, 4);
+            return;
+
+        case MachOperand::Symbol:
+            // Absolute reference to a symbol, through a SIB byte without base
+            // or index.
+            emit_byte(0x04 | (reg << 3));
+            emit_byte(0x25);
+            m_relocs.push_back({
+                Relocation::Abs32S,
+                static_cast<uint32_t>(m_code.size()),
+                0,
+                rm.get_symbol()
+            });
+            emit_value(0, 4);
+            return;
+
+        default:
+            break;
+    }
+
+    uint8_t base;
+    int32_t disp;
+    if (rm.is_mem()) {
+        base = to_hardware(map_register(rm.get_mem_base()));
+        disp = static_cast<int32_t>(rm.get_mem_disp());
+    } else {
+        assert(rm.is_stack() && "invalid r/m operand!");
+
+        // Stack is accessed on negative offsets from %rbp, same as the
+        // AsmWriter.
+        const StackEntry& entry =
+            m_func.get_stack_frame().entries.at(rm.get_stack());
+
+        base = to_hardware(RBP);
+        disp = -entry.offset - static_cast<int32_t>(entry.size);
+    }
+
+    // %rbp and %r13 have no displacement-free form, since that encoding
+    // means RIP-relative addressing.
+    uint8_t mod;
+    if (disp == 0 && (base & 7) != 5) {
+        mod = 0x00;
+    } else if (is_int8(disp)) {
+        mod = 0x40;
+    } else {
+        mod = 0x80;
+    }
+
+    emit_byte(mod | (reg << 3) | (base & 7));
+
+    // %rsp and %r12 as a base require a SIB byte.
+    if ((base & 7) == 4)
+        emit_byte(0x24);
+
+    if (mod == 0x40) {
+        emit_value(disp, 1);
+    } else if (mod == 0x80) {
+        emit_value(disp, 4);
+    }
+}
+
+void InstEncoder::emit_op(uint8_t prefix, uint32_t op, uint32_t op_len,
+                          uint32_t size, uint8_t reg, const MachOperand& rm,
+                          bool force_rex) {
+    if (size == 2)
+        emit_byte(0x66);
+
+    if (prefix)
+        emit_byte(prefix);
+
+    uint8_t base = 0;
+    if (rm.is_reg()) {
+        base = hw_reg(rm);
+    } else if (rm.is_mem()) {
+        base = to_hardware(map_register(rm.get_mem_base()));
+    }
+
+    emit_rex(size == 8, reg, base, force_rex);
+
+    for (uint32_t i = op_len; i-- > 0; )
+        emit_byte(static_cast<uint8_t>(op >> (i * 8)));
+
+    emit_modrm(reg, rm);
+}
+
+void InstEncoder::finish_inst() {
+    const uint32_t end = m_code.size();
+
+    for (uint32_t i = m_inst_relocs, e = m_relocs.size(); i < e; ++i) {
+        Relocation& reloc = m_relocs[i];
+        if (reloc.kind != Relocation::Abs32S)
+            reloc.addend -= end - reloc.offset;
+    }
+
+    for (uint32_t i = m_inst_fixups, e = m_fixups.size(); i < e; ++i)
+        m_fixups[i].end = end;
+
+    m_inst_relocs = m_relocs.size();
+    m_inst_fixups = m_fixups.size();
+}
+
+void InstEncoder::encode_alu(const MachInst& inst, uint8_t ext) {
+    const MachOperand& src = inst.get_operand(0);
+    const MachOperand& dst = inst.get_operand(1);
+    const uint32_t size = op_size(inst);
+    const bool rex = needs_rex(src) || needs_rex(dst);
+
+    if (src.is_imm()) {
+        const int64_t imm = src.get_imm();
+        assert(is_int32(imm) && "immediate does not fit in 32 bits!");
+
+        if (size == 1) {
+            emit_op(0, 0x80, 1, size, ext, dst, rex);
+            emit_value(imm, 1);
+        } else if (is_int8(imm)) {
+            emit_op(0, 0x83, 1, size, ext, dst, rex);
+            emit_value(imm, 1);
+        } else {
+            emit_op(0, 0x81, 1, size, ext, dst, rex);
+            emit_value(imm, size == 2 ? 2 : 4);
+        }
+    } else if (src.is_reg()) {
+        emit_op(0, (ext << 3) | (size == 1 ? 0x00 : 0x01), 1, size,
+            hw_reg(src), dst, rex);
+    } else {
+        assert(is_memory(src) && dst.is_reg() && "invalid operands!");
+        emit_op(0, (ext << 3) | (size == 1 ? 0x02 : 0x03), 1, size,
+            hw_reg(dst), src, rex);
+    }
+}
+
+void InstEncoder::encode_mov(const MachInst& inst) {
+    const MachOperand& src = inst.get_operand(0);
+    const MachOperand& dst = inst.get_operand(1);
+    const uint32_t size = op_size(inst);
+    const bool rex = needs_rex(src) || needs_rex(dst);
+
+    if (inst.size() == X64_Size::Single || inst.size() == X64_Size::Double) {
+        // Moves of floating point values are always scalar SSE moves.
+        return encode_sse(inst,
+            inst.size() == X64_Size::Single ? 0xF3 : 0xF2, 0x10);
+    }
+
+    if (is_xmm(src) || is_xmm(dst)) {
+        if (is_xmm(src) && is_xmm(dst)) {
+            // movq %xmm, %xmm
+            emit_op(0xF3, 0x0F7E, 2, 4, hw_reg(dst), src);
+        } else if (is_xmm(dst)) {
+            // movq r/m, %xmm
+            emit_op(0x66, 0x0F6E, 2, size, hw_reg(dst), src);
+        } else {
+            // movq %xmm, r/m
+            emit_op(0x66, 0x0F7E, 2, size, hw_reg(src), dst);
+        }
+
+        return;
+    }
+
+    if (src.is_imm()) {
+        const int64_t imm = src.get_imm();
+
+        if (dst.is_reg()) {
+            const uint8_t reg = hw_reg(dst);
+
+            if (size == 8 && is_int32(imm)) {
+                emit_op(0, 0xC7, 1, size, 0, dst);
+                emit_value(imm, 4);
+            } else if (size == 8 && 0 <= imm && imm <= UINT32_MAX) {
+                // Moves to a 32-bit register zero the upper half.
+                emit_rex(false, 0, reg);
+                emit_byte(0xB8 | (reg & 7));
+                emit_value(imm, 4);
+            } else if (size == 1) {
+                emit_rex(false, 0, reg, rex);
+                emit_byte(0xB0 | (reg & 7));
+                emit_value(imm, 1);
+            } else {
+                if (size == 2)
+                    emit_byte(0x66);
+
+                emit_rex(size == 8, 0, reg);
+                emit_byte(0xB8 | (reg & 7));
+                emit_value(imm, size);
+            }
+        } else {
+            assert(is_int32(imm) && "immediate does not fit in 32 bits!");
+
+            emit_op(0, size == 1 ? 0xC6 : 0xC7, 1, size, 0, dst);
+            emit_value(imm, size == 8 ? 4 : size);
+        }
+    } else if (src.is_reg()) {
+        emit_op(0, size == 1 ? 0x88 : 0x89, 1, size, hw_reg(src), dst, rex);
+    } else {
+        assert(is_memory(src) && dst.is_reg() && "invalid operands!");
+        emit_op(0, size == 1 ? 0x8A : 0x8B, 1, size, hw_reg(dst), src, rex);
+    }
+}
+
+void InstEncoder::encode_unary(const MachInst& inst, uint8_t ext) {
+    const MachOperand& op = inst.get_operand(0);
+    const uint32_t size = op_size(inst);
+
+    emit_op(0, size == 1 ? 0xF6 : 0xF7, 1, size, ext, op, needs_rex(op));
+}
+
+void InstEncoder::encode_shift(const MachInst& inst, uint8_t ext) {
+    const MachOperand& count = inst.get_operand(0);
+    const MachOperand& dst = inst.get_operand(1);
+
+    // The shifted operand decides the width, not the shift count.
+    const uint32_t size = dst.is_reg() ? reg_size(dst) : op_size(inst);
+    const bool rex = needs_rex(dst);
+
+    if (count.is_imm()) {
+        if (count.get_imm() == 1) {
+            emit_op(0, size == 1 ? 0xD0 : 0xD1, 1, size, ext, dst, rex);
+        } else {
+            emit_op(0, size == 1 ? 0xC0 : 0xC1, 1, size, ext, dst, rex);
+            emit_value(count.get_imm(), 1);
+        }
+    } else {
+        assert(count.is_reg() && map_register(count.get_reg()) == RCX &&
+            "variable shift count must be in %cl!");
+
+        emit_op(0, size == 1 ? 0xD2 : 0xD3, 1, size, ext, dst, rex);
+    }
+}
+
+void InstEncoder::encode_imul(const MachInst& inst) {
+    if (inst.num_explicit_operands() == 1)
+        return encode_unary(inst, 5);
+
+    const MachOperand& src = inst.get_operand(0);
+    const MachOperand& dst = inst.get_operand(1);
+    const uint32_t size = op_size(inst);
+    assert(dst.is_reg() && size != 1 && "invalid imul destination!");
+
+    if (src.is_imm()) {
+        const int64_t imm = src.get_imm();
+        assert(is_int32(imm) && "immediate does not fit in 32 bits!");
+
+        // imul $imm, %reg is shorthand for imul $imm, %reg, %reg.
+        if (is_int8(imm)) {
+            emit_op(0, 0x6B, 1, size, hw_reg(dst), dst);
+            emit_value(imm, 1);
+        } else {
+            emit_op(0, 0x69, 1, size, hw_reg(dst), dst);
+            emit_value(imm, size == 2 ? 2 : 4);
+        }
+    } else {
+        emit_op(0, 0x0FAF, 2, size, hw_reg(dst), src);
+    }
+}
+
+void InstEncoder::encode_extend(const MachInst& inst) {
+    const MachOperand& src = inst.get_operand(0);
+    const MachOperand& dst = inst.get_operand(1);
+    assert(dst.is_reg() && "extension destination must be a register!");
+
+    const uint32_t dst_size = reg_size(dst);
+    uint32_t src_size = 0;
+    if (src.is_reg()) {
+        src_size = reg_size(src);
+    } else if (inst.size() == X64_Size::Byte) {
+        src_size = 1;
+    } else if (inst.size() == X64_Size::Word) {
+        src_size = 2;
+    } else {
+        src_size = 4;
+    }
+
+    const bool rex = needs_rex(src);
+
+    if (inst.op() == X64_Mnemonic::MOVSXD ||
+      (inst.op() == X64_Mnemonic::MOVSX && src_size == 4)) {
+        emit_op(0, 0x63, 1, dst_size, hw_reg(dst), src);
+    } else if (inst.op() == X64_Mnemonic::MOVZX && src_size == 4) {
+        // There is no zero-extending move from 32-bit, since a 32-bit move
+        // zeroes the upper half of the register anyways.
+        emit_op(0, 0x8B, 1, 4, hw_reg(dst), src);
+    } else {
+        uint32_t op = inst.op() == X64_Mnemonic::MOVSX ? 0x0FBE : 0x0FB6;
+        if (src_size == 2)
+            op |= 1;
+
+        emit_op(0, op, 2, dst_size, hw_reg(dst), src, rex);
+    }
+}
+
+void InstEncoder::encode_sse(const MachInst& inst, uint8_t prefix,
+                             uint8_t op) {
+    const MachOperand& src = inst.get_operand(0);
+    const MachOperand& dst = inst.get_operand(1);
+
+    if (is_xmm(dst)) {
+        emit_op(prefix, 0x0F00 | op, 2, 4, hw_reg(dst), src);
+    } else {
+        // Stores use the opcode following the load form, which swaps the
+        // direction of the operands.
+        assert(is_xmm(src) && "invalid operands!");
+        emit_op(prefix, 0x0F00 | (op + 1), 2, 4, hw_reg(src), dst);
+    }
+}
+
+void InstEncoder::encode_convert(const MachInst& inst, uint8_t prefix,
+                                 uint8_t op) {
+    const MachOperand& src = inst.get_operand(0);
+    const MachOperand& dst = inst.get_operand(1);
+
+    // The general purpose operand, if any, decides REX.W.
+    uint32_t size = 4;
+    if (src.is_reg() && !is_xmm(src)) {
+        size = reg_size(src);
+    } else if (dst.is_reg() && !is_xmm(dst)) {
+        size = reg_size(dst);
+    } else if (inst.size() == X64_Size::Quad) {
+        size = 8;
+    }
+
+    emit_op(prefix, 0x0F00 | op, 2, size == 8 ? 8 : 4, hw_reg(dst), src);
+}
+
+void InstEncoder::encode_branch(const MachInst& inst) {
+    const MachOperand& target = inst.get_operand(0);
+
+    if (inst.op() == X64_Mnemonic::JMP) {
+        if (target.is_reg() || target.is_mem()) {
+            emit_op(0, 0xFF, 1, 4, 4, target);
+            return;
+        }
+
+        emit_byte(0xE9);
+    } else {
+        emit_byte(0x0F);
+        emit_byte(0x80 | to_condition(inst.op()));
+    }
+
+    if (target.is_label()) {
+        m_fixups.push_back({
+            static_cast<uint32_t>(m_code.size()), 0, target.get_label()
+        });
+    } else {
+        assert(target.is_symbol() && "invalid branch target!");
+        m_relocs.push_back({
+            Relocation::PC32,
+            static_cast<uint32_t>(m_code.size()),
+            0,
+            target.get_symbol()
+        });
+    }
+
+    emit_value(0, 4);
+}
+
+void InstEncoder::encode_epilogue() {
+    const MachOperand rsp = MachOperand::create_reg(RSP, 8, true);
+    const MachOperand rbp = MachOperand::create_reg(RBP, 8, true);
+    const int64_t align = m_func.get_stack_frame().alignment();
+
+    encode(MachInst(X64_Mnemonic::ADD, X64_Size::Quad, {
+        MachOperand::create_imm(align), rsp }));
+    encode(MachInst(X64_Mnemonic::POP, X64_Size::Quad, { rbp }));
+    emit_byte(0xC3);
+}
+
+void InstEncoder::encode(const MachInst& inst) {
+    if (is_redundant_move(inst))
+        return;
+
+    switch (inst.op()) {
+        case X64_Mnemonic::None:
+            break;
+
+        case X64_Mnemonic::NOP:
+            emit_byte(0x90);
+            break;
+
+        case X64_Mnemonic::UD2:
+            emit_byte(0x0F);
+            emit_byte(0x0B);
+            break;
+
+        case X64_Mnemonic::CQO:
+            emit_byte(0x48);
+            emit_byte(0x99);
+            break;
+
+        case X64_Mnemonic::SYSCALL:
+            emit_byte(0x0F);
+            emit_byte(0x05);
+            break;
+
+        case X64_Mnemonic::RET:
+            encode_epilogue();
+            break;
+
+        case X64_Mnemonic::CALL: {
+            const MachOperand& target = inst.get_operand(0);
+            if (!target.is_symbol()) {
+                emit_op(0, 0xFF, 1, 4, 2, target);
+                break;
+            }
+
+            emit_byte(0xE8);
+            m_relocs.push_back({
+                Relocation::PLT32,
+                static_cast<uint32_t>(m_code.size()),
+                0,
+                target.get_symbol()
+            });
+            emit_value(0, 4);
+            break;
+        }
+
+        case X64_Mnemonic::LEA: {
+            const MachOperand& dst = inst.get_operand(1);
+            emit_op(0, 0x8D, 1, reg_size(dst), hw_reg(dst),
+                inst.get_operand(0));
+            break;
+        }
+
+        case X64_Mnemonic::PUSH:
+        case X64_Mnemonic::POP: {
+            const MachOperand& op = inst.get_operand(0);
+            assert(op.is_reg() && "can only push or pop registers!");
+
+            const uint8_t reg = hw_reg(op);
+            emit_rex(false, 0, reg);
+            emit_byte((inst.op() == X64_Mnemonic::PUSH ? 0x50 : 0x58) |
+                (reg & 7));
+            break;
+        }
+
+        case X64_Mnemonic::MOV:
+            encode_mov(inst);
+            break;
+
+        case X64_Mnemonic::MOVABS: {
+            const MachOperand& src = inst.get_operand(0);
+            const MachOperand& dst = inst.get_operand(1);
+            if (!src.is_imm() || !dst.is_reg()) {
+                encode_mov(inst);
+                break;
+            }
+
+            const uint8_t reg = hw_reg(dst);
+            emit_rex(true, 0, reg);
+            emit_byte(0xB8 | (reg & 7));
+            emit_value(src.get_imm(), 8);
+            break;
+        }
+
+        case X64_Mnemonic::ADD:
+            encode_alu(inst, 0);
+            break;
+        case X64_Mnemonic::OR:
+            encode_alu(inst, 1);
+            break;
+        case X64_Mnemonic::AND:
+            encode_alu(inst, 4);
+            break;
+        case X64_Mnemonic::SUB:
+            encode_alu(inst, 5);
+            break;
+        case X64_Mnemonic::XOR:
+            encode_alu(inst, 6);
+            break;
+        case X64_Mnemonic::CMP:
+            encode_alu(inst, 7);
+            break;
+
+        case X64_Mnemonic::NOT:
+            encode_unary(inst, 2);
+            break;
+        case X64_Mnemonic::NEG:
+            encode_unary(inst, 3);
+            break;
+        case X64_Mnemonic::MUL:
+            encode_unary(inst, 4);
+            break;
+        case X64_Mnemonic::IMUL:
+            encode_imul(inst);
+            break;
+        case X64_Mnemonic::DIV:
+            encode_unary(inst, 6);
+            break;
+        case X64_Mnemonic::IDIV:
+            encode_unary(inst, 7);
+            break;
+
+        case X64_Mnemonic::SHL:
+            encode_shift(inst, 4);
+            break;
+        case X64_Mnemonic::SHR:
+            encode_shift(inst, 5);
+            break;
+        case X64_Mnemonic::SAR:
+            encode_shift(inst, 7);
+            break;
+
+        case X64_Mnemonic::MOVSX:
+        case X64_Mnemonic::MOVSXD:
+        case X64_Mnemonic::MOVZX:
+            encode_extend(inst);
+            break;
+
+        case X64_Mnemonic::JMP:
+        case X64_Mnemonic::JE:
+        case X64_Mnemonic::JNE:
+        case X64_Mnemonic::JZ:
+        case X64_Mnemonic::JNZ:
+        case X64_Mnemonic::JL:
+        case X64_Mnemonic::JLE:
+        case X64_Mnemonic::JG:
+        case X64_Mnemonic::JGE:
+        case X64_Mnemonic::JA:
+        case X64_Mnemonic::JAE:
+        case X64_Mnemonic::JB:
+        case X64_Mnemonic::JBE:
+            encode_branch(inst);
+            break;
+
+        case X64_Mnemonic::SETE:
+        case X64_Mnemonic::SETNE:
+        case X64_Mnemonic::SETZ:
+        case X64_Mnemonic::SETNZ:
+        case X64_Mnemonic::SETL:
+        case X64_Mnemonic::SETLE:
+        case X64_Mnemonic::SETG:
+        case X64_Mnemonic::SETGE:
+        case X64_Mnemonic::SETA:
+        case X64_Mnemonic::SETAE:
+        case X64_Mnemonic::SETB:
+        case X64_Mnemonic::SETBE: {
+            const MachOperand& op = inst.get_operand(0);
+            emit_op(0, 0x0F90 | to_condition(inst.op()), 2, 1, 0, op,
+                needs_rex(op));
+            break;
+        }
+
+        case X64_Mnemonic::MOVS:
+            encode_sse(inst, inst.size() == X64_Size::Single ? 0xF3 : 0xF2,
+                0x10);
+            break;
+        case X64_Mnemonic::MOVAP:
+            encode_sse(inst, inst.size() == X64_Size::Single ? 0x00 : 0x66,
+                0x28);
+            break;
+        case X64_Mnemonic::UCOMIS:
+            encode_convert(inst,
+                inst.size() == X64_Size::Single ? 0x00 : 0x66, 0x2E);
+            break;
+        case X64_Mnemonic::ADDS:
+            encode_convert(inst,
+                inst.size() == X64_Size::Single ? 0xF3 : 0xF2, 0x58);
+            break;
+        case X64_Mnemonic::MULS:
+            encode_convert(inst,
+                inst.size() == X64_Size::Single ? 0xF3 : 0xF2, 0x59);
+            break;
+        case X64_Mnemonic::SUBS:
+            encode_convert(inst,
+                inst.size() == X64_Size::Single ? 0xF3 : 0xF2, 0x5C);
+            break;
+        case X64_Mnemonic::DIVS:
+            encode_convert(inst,
+                inst.size() == X64_Size::Single ? 0xF3 : 0xF2, 0x5E);
+            break;
+        case X64_Mnemonic::ANDP:
+            encode_convert(inst,
+                inst.size() == X64_Size::Single ? 0x00 : 0x66, 0x54);
+            break;
+        case X64_Mnemonic::ORP:
+            encode_convert(inst,
+                inst.size() == X64_Size::Single ? 0x00 : 0x66, 0x56);
+            break;
+        case X64_Mnemonic::XORP:
+            encode_convert(inst,
+                inst.size() == X64_Size::Single ? 0x00 : 0x66, 0x57);
+            break;
+        case X64_Mnemonic::CVTSS2SD:
+            encode_convert(inst, 0xF3, 0x5A);
+            break;
+        case X64_Mnemonic::CVTSD2SS:
+            encode_convert(inst, 0xF2, 0x5A);
+            break;
+        case X64_Mnemonic::CVTSI2SS:
+            encode_convert(inst, 0xF3, 0x2A);
+            break;
+        case X64_Mnemonic::CVTSI2SD:
+            encode_convert(inst, 0xF2, 0x2A);
+            break;
+        case X64_Mnemonic::CVTTSS2SI:
+            encode_convert(inst, 0xF3, 0x2C);
+            break;
+        case X64_Mnemonic::CVTTSD2SI:
+            encode_convert(inst, 0xF2, 0x2C);
+            break;
+    }
+
+    finish_inst();
+}
+
+void InstEncoder::run() {
+    m_inst_relocs = m_relocs.size();
+    m_inst_fixups = m_fixups.size();
+
+    const MachOperand rsp = MachOperand::create_reg(RSP, 8, true);
+    const MachOperand rbp = MachOperand::create_reg(RBP, 8, true);
+    const int64_t align = m_func.get_stack_frame().alignment();
+
+    // Same prologue as the one emitted by the AsmWriter.
+    encode(MachInst(X64_Mnemonic::PUSH, X64_Size::Quad, { rbp }));
+    encode(MachInst(X64_Mnemonic::MOV, X64_Size::Quad, { rsp, rbp }));
+    encode(MachInst(X64_Mnemonic::SUB, X64_Size::Quad, {
+        MachOperand::create_imm(align), rsp }));
+
+    for (const MachLabel* label = m_func.get_head(); label;
+      label = label->get_next()) {
+        m_labels.emplace(label, m_code.size());
+
+        for (const MachInst& inst : label->insts())
+            encode(inst);
+    }
+
+    for (const LabelFixup& fixup : m_fixups) {
+        const int64_t rel =
+            static_cast<int64_t>(m_labels.at(fixup.label)) - fixup.end;
+
+        for (uint32_t i = 0; i < 4; ++i)
+            m_code[fixup.offset + i] = static_cast<uint8_t>(rel >> (i * 8));
+    }
+}
@@ -0,0 +1,415 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lir/machine/Linker.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace lir;
+
+/// The virtual address that the executable is loaded at.
+static constexpr uint64_t BaseAddress = 0x400000;
+
+/// The alignment of each segment, in both the file and in memory.
+static constexpr uint64_t PageSize = 0x1000;
+
+/// The maximum number of program headers in an executable: one for each
+/// loadable segment, and one to mark the stack as non-executable.
+static constexpr uint32_t MaxProgramHeaders = 4;
+
+/// The size of the ELF header and program headers at the start of the file.
+static constexpr uint64_t HeaderSize =
+    sizeof(Elf64_Ehdr) + MaxProgramHeaders * sizeof(Elf64_Phdr);
+
+static uint64_t align_up(uint64_t value, uint64_t align) {
+    if (align <= 1)
+        return value;
+
+    return (value + align - 1) / align * align;
+}
+
+const char* Linker::get_name(const InputObject& obj,
+                             const Elf64_Sym& sym) const {
+    if (sym.st_name >= obj.strtab_size)
+        return "";
+
+    return obj.strtab + sym.st_name;
+}
+
+bool Linker::parse(InputObject& obj) {
+    const std::string& image = obj.image;
+
+    Elf64_Ehdr ehdr = {};
+    if (image.size() < sizeof(ehdr)) {
+        m_errors.push_back("not an ELF object: " + obj.name);
+        return false;
+    }
+
+    std::memcpy(&ehdr, image.data(), sizeof(ehdr));
+
+    if (std::memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0
+      || ehdr.e_ident[EI_CLASS] != ELFCLASS64
+      || ehdr.e_ident[EI_DATA] != ELFDATA2LSB
+      || ehdr.e_type != ET_REL
+      || ehdr.e_machine != EM_X86_64) {
+        m_errors.push_back("not a relocatable X64 ELF object: " + obj.name);
+        return false;
+    }
+
+    if (ehdr.e_shentsize != sizeof(Elf64_Shdr)
+      || ehdr.e_shoff + ehdr.e_shnum * sizeof(Elf64_Shdr) > image.size()) {
+        m_errors.push_back("malformed section headers in: " + obj.name);
+        return false;
+    }
+
+    obj.sections.resize(ehdr.e_shnum);
+    std::memcpy(obj.sections.data(), image.data() + ehdr.e_shoff,
+        ehdr.e_shnum * sizeof(Elf64_Shdr));
+
+    for (const Elf64_Shdr& section : obj.sections) {
+        if (section.sh_type != SHT_NOBITS
+          && section.sh_offset + section.sh_size > image.size()) {
+            m_errors.push_back("malformed section in: " + obj.name);
+            return false;
+        }
+
+        if (section.sh_type == SHT_REL) {
+            m_errors.push_back("unsupported REL relocations in: " + obj.name);
+            return false;
+        }
+
+        if (section.sh_type != SHT_SYMTAB)
+            continue;
+
+        if (!obj.symbols.empty() || section.sh_link >= obj.sections.size()) {
+            m_errors.push_back("malformed symbol table in: " + obj.name);
+            return false;
+        }
+
+        obj.symbols.resize(section.sh_size / sizeof(Elf64_Sym));
+        std::memcpy(obj.symbols.data(), image.data() + section.sh_offset,
+            obj.symbols.size() * sizeof(Elf64_Sym));
+
+        const Elf64_Shdr& strtab = obj.sections[section.sh_link];
+        if (strtab.sh_offset + strtab.sh_size > image.size()) {
+            m_errors.push_back("malformed string table in: " + obj.name);
+            return false;
+        }
+
+        obj.strtab = image.data() + strtab.sh_offset;
+        obj.strtab_size = strtab.sh_size;
+    }
+
+    return true;
+}
+
+void Linker::layout() {
+    // The first segment also holds the file and program headers.
+    uint64_t offset = HeaderSize;
+
+    for (uint32_t kind = SegmentRodata; kind != NumSegments; ++kind) {
+        Segment& segment = m_segments[kind];
+        segment.offset = kind == SegmentRodata ? 0 : align_up(offset, PageSize);
+        segment.address = BaseAddress + segment.offset;
+        offset = std::max(offset, segment.offset);
+
+        // Sections without contents only take up space in memory, so they
+        // are placed after every section with contents.
+        for (bool nobits : { false, true }) {
+            for (InputObject& obj : m_objects) {
+                for (uint16_t i = 0, e = obj.sections.size(); i != e; ++i) {
+                    const Elf64_Shdr& section = obj.sections[i];
+                    if (!(section.sh_flags & SHF_ALLOC))
+                        continue;
+
+                    if ((section.sh_type == SHT_NOBITS) != nobits)
+                        continue;
+
+                    SegmentKind segment_kind = SegmentRodata;
+                    if (section.sh_flags & SHF_EXECINSTR) {
+                        segment_kind = SegmentText;
+                    } else if (section.sh_flags & SHF_WRITE) {
+                        segment_kind = SegmentData;
+                    }
+
+                    if (segment_kind != kind)
+                        continue;
+
+                    offset = align_up(offset, section.sh_addralign);
+                    obj.layout.emplace(i, InputSection {
+                        segment_kind,
+                        offset,
+                        BaseAddress + offset,
+                    });
+
+                    offset += section.sh_size;
+                }
+            }
+
+            if (!nobits)
+                segment.file_size = offset - segment.offset;
+        }
+
+        segment.mem_size = offset - segment.offset;
+    }
+
+    m_image.resize(m_segments[SegmentData].offset
+        + m_segments[SegmentData].file_size, 0);
+}
+
+void Linker::define_globals() {
+    for (const InputObject& obj : m_objects) {
+        for (const Elf64_Sym& sym : obj.symbols) {
+            const uint8_t bind = ELF64_ST_BIND(sym.st_info);
+            if (bind != STB_GLOBAL && bind != STB_WEAK)
+                continue;
+
+            if (sym.st_shndx == SHN_UNDEF)
+                continue;
+
+            const std::string name = get_name(obj, sym);
+            if (sym.st_shndx == SHN_COMMON) {
+                m_errors.push_back("unsupported common symbol: " + name +
+                    " in " + obj.name);
+                continue;
+            }
+
+            uint64_t address = sym.st_value;
+            if (sym.st_shndx != SHN_ABS) {
+                auto it = obj.layout.find(sym.st_shndx);
+                if (it != obj.layout.end())
+                    address += it->second.address;
+            }
+
+            Definition def = { address, bind == STB_WEAK, &obj };
+
+            auto [it, inserted] = m_globals.emplace(name, def);
+            if (inserted || def.weak)
+                continue;
+
+            if (it->second.weak) {
+                it->second = def;
+            } else {
+                m_errors.push_back("duplicate symbol: " + name +
+                    " in " + it->second.object->name + " and " + obj.name);
+            }
+        }
+    }
+}
+
+bool Linker::resolve(const InputObject& obj, uint32_t index,
+                     uint64_t& address) {
+    if (index >= obj.symbols.size()) {
+        m_errors.push_back("bad symbol index in: " + obj.name);
+        return false;
+    }
+
+    const Elf64_Sym& sym = obj.symbols[index];
+    const uint8_t bind = ELF64_ST_BIND(sym.st_info);
+
+    if (bind == STB_GLOBAL || bind == STB_WEAK) {
+        const std::string name = get_name(obj, sym);
+
+        auto it = m_globals.find(name);
+        if (it != m_globals.end()) {
+            address = it->second.address;
+            return true;
+        }
+
+        // Undefined weak symbols resolve to null.
+        if (bind == STB_WEAK) {
+            address = 0;
+            return true;
+        }
+
+        m_errors.push_back("undefined symbol: " + name +
+            ", referenced in " + obj.name);
+        return false;
+    }
+
+    address = sym.st_value;
+    if (sym.st_shndx != SHN_ABS) {
+        auto it = obj.layout.find(sym.st_shndx);
+        if (it != obj.layout.end())
+            address += it->second.address;
+    }
+
+    return true;
+}
+
+void Linker::relocate(const InputObject& obj) {
+    for (const auto& [index, section] : obj.layout) {
+        const Elf64_Shdr& header = obj.sections[index];
+        if (header.sh_type != SHT_NOBITS) {
+            std::memcpy(m_image.data() + section.offset,
+                obj.image.data() + header.sh_offset, header.sh_size);
+        }
+    }
+
+    for (const Elf64_Shdr& rela : obj.sections) {
+        if (rela.sh_type != SHT_RELA)
+            continue;
+
+        auto target = obj.layout.find(rela.sh_info);
+        if (target == obj.layout.end())
+            continue;
+
+        const Elf64_Shdr& header = obj.sections[rela.sh_info];
+        const InputSection& section = target->second;
+
+        for (uint64_t i = 0, e = rela.sh_size / sizeof(Elf64_Rela); i != e; ++i) {
+            Elf64_Rela reloc = {};
+            std::memcpy(&reloc, obj.image.data() + rela.sh_offset
+                + i * sizeof(Elf64_Rela), sizeof(reloc));
+
+            const uint32_t type = ELF64_R_TYPE(reloc.r_info);
+            if (type == R_X86_64_NONE)
+                continue;
+
+            uint64_t S = 0;
+            if (!resolve(obj, ELF64_R_SYM(reloc.r_info), S))
+                continue;
+
+            const int64_t A = reloc.r_addend;
+            const uint64_t P = section.address + reloc.r_offset;
+
+            uint64_t value = 0;
+            uint32_t width = 4;
+            bool fits = true;
+
+            switch (type) {
+                case R_X86_64_64:
+                    value = S + A;
+                    width = 8;
+                    break;
+                case R_X86_64_PC64:
+                    value = S + A - P;
+                    width = 8;
+                    break;
+                case R_X86_64_PC32:
+                case R_X86_64_PLT32: {
+                    // Everything is linked statically, so calls through the
+                    // PLT are resolved directly to their targets.
+                    const int64_t disp = S + A - P;
+                    fits = disp >= std::numeric_limits<int32_t>::min()
+                        && disp <= std::numeric_limits<int32_t>::max();
+                    value = disp;
+                    break;
+                }
+                case R_X86_64_32:
+                    value = S + A;
+                    fits = value <= std::numeric_limits<uint32_t>::max();
+                    break;
+                case R_X86_64_32S: {
+                    const int64_t abs = S + A;
+                    fits = abs >= std::numeric_limits<int32_t>::min()
+                        && abs <= std::numeric_limits<int32_t>::max();
+                    value = abs;
+                    break;
+                }
+                default:
+                    m_errors.push_back("unsupported relocation type " +
+                        std::to_string(type) + " in " + obj.name);
+                    continue;
+            }
+
+            if (!fits) {
+                m_errors.push_back("relocation out of range in: " + obj.name);
+                continue;
+            }
+
+            if (reloc.r_offset + width > header.sh_size) {
+                m_errors.push_back("relocation out of bounds in: " + obj.name);
+                continue;
+            }
+
+            uint8_t* dest = m_image.data() + section.offset + reloc.r_offset;
+            for (uint32_t byte = 0; byte != width; ++byte)
+                dest[byte] = static_cast<uint8_t>(value >> (byte * 8));
+        }
+    }
+}
+
+bool Linker::run(std::ostream& os) {
+    for (InputObject& obj : m_objects)
+        parse(obj);
+
+    if (!m_errors.empty())
+        return false;
+
+    layout();
+    define_globals();
+
+    for (const InputObject& obj : m_objects)
+        relocate(obj);
+
+    auto entry = m_globals.find("_start");
+    if (entry == m_globals.end())
+        m_errors.push_back("undefined entry symbol: _start");
+
+    if (!m_errors.empty())
+        return false;
+
+    std::vector<Elf64_Phdr> phdrs = {};
+    for (uint32_t kind = SegmentRodata; kind != NumSegments; ++kind) {
+        const Segment& segment = m_segments[kind];
+        if (segment.mem_size == 0)
+            continue;
+
+        Elf64_Phdr phdr = {};
+        phdr.p_type = PT_LOAD;
+        phdr.p_offset = segment.offset;
+        phdr.p_vaddr = segment.address;
+        phdr.p_paddr = segment.address;
+        phdr.p_filesz = segment.file_size;
+        phdr.p_memsz = segment.mem_size;
+        phdr.p_align = PageSize;
+
+        switch (kind) {
+            case SegmentRodata:
+                phdr.p_flags = PF_R;
+                break;
+            case SegmentText:
+                phdr.p_flags = PF_R | PF_X;
+                break;
+            case SegmentData:
+                phdr.p_flags = PF_R | PF_W;
+                break;
+        }
+
+        phdrs.push_back(phdr);
+    }
+
+    Elf64_Phdr stack = {};
+    stack.p_type = PT_GNU_STACK;
+    stack.p_flags = PF_R | PF_W;
+    stack.p_align = 16;
+    phdrs.push_back(stack);
+
+    Elf64_Ehdr ehdr = {};
+    std::memcpy(ehdr.e_ident, ELFMAG, SELFMAG);
+    ehdr.e_ident[EI_CLASS] = ELFCLASS64;
+    ehdr.e_ident[EI_DATA] = ELFDATA2LSB;
+    ehdr.e_ident[EI_VERSION] = EV_CURRENT;
+    ehdr.e_ident[EI_OSABI] = ELFOSABI_SYSV;
+    ehdr.e_type = ET_EXEC;
+    ehdr.e_machine = EM_X86_64;
+    ehdr.e_version = EV_CURRENT;
+    ehdr.e_entry = entry->second.address;
+    ehdr.e_phoff = sizeof(Elf64_Ehdr);
+    ehdr.e_ehsize = sizeof(Elf64_Ehdr);
+    ehdr.e_phentsize = sizeof(Elf64_Phdr);
+    ehdr.e_phnum = phdrs.size();
+    ehdr.e_shentsize = sizeof(Elf64_Shdr);
+
+    std::memcpy(m_image.data(), &ehdr, sizeof(ehdr));
+    std::memcpy(m_image.data() + sizeof(ehdr), phdrs.data(),
+        phdrs.size() * sizeof(Elf64_Phdr));
+
+    os.write(reinterpret_cast<const char*>(m_image.data()), m_image.size());
+    return true;
+}
@@ -0,0 +1,422 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lir/graph/CFG.hpp"
+#include "lir/graph/Constant.hpp"
+#include "lir/graph/Function.hpp"
+#include "lir/graph/Global.hpp"
+#include "lir/graph/Type.hpp"
+#include "lir/machine/InstEncoder.hpp"
+#include "lir/machine/MachFunction.hpp"
+#include "lir/machine/ObjectWriter.hpp"
+
+#include <elf.h>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace lir;
+
+/// The sections of an object file, in the order they are written.
+enum SectionIndex : uint16_t {
+    SectionNull = 0,
+    SectionText,
+    SectionRelaText,
+    SectionRodata,
+    SectionData,
+    SectionNote,
+    SectionSymtab,
+    SectionStrtab,
+    SectionShstrtab,
+    NumSections,
+};
+
+/// The symbols that precede all other symbols in the symbol table: the null
+/// symbol, the file symbol, and a symbol for each section with contents.
+static constexpr uint32_t NumReservedSymbols = 5;
+
+/// Returns the symbol table index of the section symbol for |section|.
+static uint32_t get_section_symbol(SectionIndex section) {
+    switch (section) {
+        case SectionText:
+            return 2;
+        case SectionRodata:
+            return 3;
+        case SectionData:
+            return 4;
+        default:
+            assert(false && "section has no symbol!");
+            return 0;
+    }
+}
+
+/// Returns the ELF relocation type for the given relocation |kind|.
+static uint32_t to_elf(Relocation::Kind kind) {
+    switch (kind) {
+        case Relocation::PC32:
+            return R_X86_64_PC32;
+        case Relocation::PLT32:
+            return R_X86_64_PLT32;
+        case Relocation::Abs32S:
+            return R_X86_64_32S;
+    }
+
+    assert(false && "unknown relocation kind!");
+    return R_X86_64_NONE;
+}
+
+/// Append |name| to the string table |strtab| and return its offset.
+static uint32_t add_string(std::vector<char>& strtab, const std::string& name) {
+    const uint32_t offset = strtab.size();
+    strtab.insert(strtab.end(), name.begin(), name.end());
+    strtab.push_back('\0');
+    return offset;
+}
+
+/// Write |bytes| bytes from |data| to |os|, and advance |offset| with them.
+static void write(std::ostream& os, uint64_t& offset, const void* data,
+                  uint64_t bytes) {
+    os.write(static_cast<const char*>(data), bytes);
+    offset += bytes;
+}
+
+/// Pad |os| with zeroes until |offset| is a multiple of |align|.
+static void pad(std::ostream& os, uint64_t& offset, uint64_t align) {
+    while (offset % align != 0) {
+        os.put('\0');
+        ++offset;
+    }
+}
+
+void ObjectWriter::align_to(std::vector<uint8_t>& section, uint32_t align) {
+    while (section.size() % align != 0)
+        section.push_back(0);
+}
+
+void ObjectWriter::emit_constant(std::vector<uint8_t>& section,
+                                 const Constant& constant) {
+    const Machine& mach = m_seg.get_machine();
+    const uint32_t size = mach.get_size(constant.get_type());
+    const uint64_t start = section.size();
+
+    if (const Integer* integer = dynamic_cast<const Integer*>(&constant)) {
+        const uint64_t value = integer->get_value();
+        for (uint32_t i = 0; i < size; ++i)
+            section.push_back(static_cast<uint8_t>(value >> (i * 8)));
+    } else if (const Float* fp = dynamic_cast<const Float*>(&constant)) {
+        switch (size) {
+            case 4: {
+                uint32_t bits = 0;
+                float value = fp->get_value();
+                std::memcpy(&bits, &value, sizeof(bits));
+
+                for (uint32_t i = 0; i < 4; ++i)
+                    section.push_back(static_cast<uint8_t>(bits >> (i * 8)));
+                break;
+            }
+            case 8: {
+                uint64_t bits = 0;
+                double value = fp->get_value();
+                std::memcpy(&bits, &value, sizeof(bits));
+
+                for (uint32_t i = 0; i < 8; ++i)
+                    section.push_back(static_cast<uint8_t>(bits >> (i * 8)));
+                break;
+            }
+            default:
+                assert(false && "unsupported SSE floating point size!");
+        }
+    } else if (const String* string = dynamic_cast<const String*>(&constant)) {
+        // Strings are null-terminated, same as the .string directive.
+        const std::string& value = string->get_value();
+        section.insert(section.end(), value.begin(), value.end());
+        section.push_back(0);
+    } else if (const Aggregate* aggregate =
+      dynamic_cast<const Aggregate*>(&constant)) {
+        const Type* type = aggregate->get_type();
+
+        for (uint32_t i = 0, e = aggregate->num_operands(); i < e; ++i) {
+            uint32_t offset = 0;
+            if (type->is_struct_type()) {
+                offset = mach.get_field_offset(
+                    static_cast<const StructType*>(type), i);
+            } else if (type->is_array_type()) {
+                offset = mach.get_element_offset(
+                    static_cast<const ArrayType*>(type), i);
+            }
+
+            while (section.size() < start + offset)
+                section.push_back(0);
+
+            emit_constant(section, *aggregate->get_value(i));
+        }
+    }
+
+    // Null pointers, and any trailing padding, are all zeroes.
+    while (section.size() < start + size)
+        section.push_back(0);
+}
+
+void ObjectWriter::emit_global(const Global& global) {
+    const Machine& mach = m_seg.get_machine();
+    const Type* type =
+        static_cast<const PointerType*>(global.get_type())->get_pointee();
+
+    const SectionIndex index = global.is_read_only()
+        ? SectionRodata
+        : SectionData;
+    std::vector<uint8_t>& section = global.is_read_only() ? m_rodata : m_data;
+
+    align_to(section, mach.get_align(type));
+    const uint64_t offset = section.size();
+    const uint32_t size = mach.get_size(type);
+
+    if (const Constant* init = global.get_initializer()) {
+        emit_constant(section, *init);
+    } else {
+        section.insert(section.end(), size, 0);
+    }
+
+    Symbol symbol = { global.get_name(), index, STT_OBJECT, STB_LOCAL,
+        offset, size };
+
+    if (global.get_linkage() == Global::External) {
+        symbol.bind = STB_GLOBAL;
+        m_globals.push_back(symbol);
+    } else {
+        m_locals.push_back(symbol);
+    }
+}
+
+void ObjectWriter::emit_function(const MachFunction& func) {
+    const ConstantPool& pool = func.get_constant_pool();
+    const Machine& mach = m_seg.get_machine();
+    std::vector<uint64_t> constants(pool.num_entries(), 0);
+
+    for (uint32_t i = 0, e = pool.num_entries(); i < e; ++i) {
+        const ConstantPoolEntry& entry = pool.entries.at(i);
+        align_to(m_rodata, std::max(entry.align,
+            mach.get_align(entry.constant->get_type())));
+
+        constants[i] = m_rodata.size();
+        emit_constant(m_rodata, *entry.constant);
+    }
+
+    const uint64_t start = m_text.size();
+    const uint32_t first_reloc = m_relocs.size();
+
+    InstEncoder encoder(func, m_text, m_relocs);
+    encoder.run();
+
+    // Rewrite the constant pool references of this function to be relative
+    // to the read-only data section.
+    for (uint32_t i = first_reloc, e = m_relocs.size(); i < e; ++i) {
+        Relocation& reloc = m_relocs[i];
+        if (reloc.symbol.empty())
+            reloc.addend += constants.at(reloc.constant);
+    }
+
+    Symbol symbol = { func.get_name(), SectionText, STT_FUNC, STB_LOCAL, start,
+        m_text.size() - start };
+
+    if (func.get_function()->get_linkage() == Function::External) {
+        symbol.bind = STB_GLOBAL;
+        m_globals.push_back(symbol);
+    } else {
+        m_locals.push_back(symbol);
+    }
+}
+
+void ObjectWriter::run(std::ostream& os) {
+    for (const auto& global : m_seg.get_graph().get_globals())
+        emit_global(*global);
+
+    for (const auto& [name, func] : m_seg.get_functions())
+        emit_function(*func);
+
+    // Resolve the symbol table index of each relocation target, adding any
+    // symbols that are not defined here as undefined globals.
+    std::unordered_map<std::string, uint32_t> indices = {};
+    for (uint32_t i = 0, e = m_locals.size(); i < e; ++i)
+        indices.emplace(m_locals[i].name, NumReservedSymbols + i);
+
+    const uint32_t first_global = NumReservedSymbols + m_locals.size();
+    for (uint32_t i = 0, e = m_globals.size(); i < e; ++i)
+        indices.emplace(m_globals[i].name, first_global + i);
+
+    std::vector<Elf64_Rela> relas = {};
+    relas.reserve(m_relocs.size());
+
+    for (const Relocation& reloc : m_relocs) {
+        uint32_t symbol;
+        if (reloc.symbol.empty()) {
+            symbol = get_section_symbol(SectionRodata);
+        } else {
+            auto it = indices.find(reloc.symbol);
+            if (it == indices.end()) {
+                it = indices.emplace(
+                    reloc.symbol, first_global + m_globals.size()).first;
+
+                m_globals.push_back({ reloc.symbol, SHN_UNDEF, STT_NOTYPE,
+                    STB_GLOBAL, 0, 0 });
+            }
+
+            symbol = it->second;
+        }
+
+        Elf64_Rela rela = {};
+        rela.r_offset = reloc.offset;
+        rela.r_info = ELF64_R_INFO(symbol, to_elf(reloc.kind));
+        rela.r_addend = reloc.addend;
+        relas.push_back(rela);
+    }
+
+    // Build the symbol and string tables.
+    std::vector<char> strtab = { '\0' };
+    std::vector<Elf64_Sym> symtab = {};
+    symtab.reserve(first_global + m_globals.size());
+
+    Elf64_Sym sym = {};
+    symtab.push_back(sym);
+
+    sym.st_name = add_string(strtab, m_seg.get_graph().get_filename());
+    sym.st_info = ELF64_ST_INFO(STB_LOCAL, STT_FILE);
+    sym.st_shndx = SHN_ABS;
+    symtab.push_back(sym);
+
+    for (SectionIndex section : { SectionText, SectionRodata, SectionData }) {
+        sym = {};
+        sym.st_info = ELF64_ST_INFO(STB_LOCAL, STT_SECTION);
+        sym.st_shndx = section;
+        symtab.push_back(sym);
+    }
+
+    for (const auto* symbols : { &m_locals, &m_globals }) {
+        for (const Symbol& symbol : *symbols) {
+            sym = {};
+            sym.st_name = add_string(strtab, symbol.name);
+            sym.st_info = ELF64_ST_INFO(symbol.bind, symbol.type);
+            sym.st_shndx = symbol.section;
+            sym.st_value = symbol.value;
+            sym.st_size = symbol.size;
+            symtab.push_back(sym);
+        }
+    }
+
+    std::vector<char> shstrtab = { '\0' };
+    Elf64_Shdr headers[NumSections] = {};
+
+    auto& text = headers[SectionText];
+    text.sh_name = add_string(shstrtab, ".text");
+    text.sh_type = SHT_PROGBITS;
+    text.sh_flags = SHF_ALLOC | SHF_EXECINSTR;
+    text.sh_size = m_text.size();
+    text.sh_addralign = 16;
+
+    auto& rela_text = headers[SectionRelaText];
+    rela_text.sh_name = add_string(shstrtab, ".rela.text");
+    rela_text.sh_type = SHT_RELA;
+    rela_text.sh_flags = SHF_INFO_LINK;
+    rela_text.sh_size = relas.size() * sizeof(Elf64_Rela);
+    rela_text.sh_link = SectionSymtab;
+    rela_text.sh_info = SectionText;
+    rela_text.sh_addralign = 8;
+    rela_text.sh_entsize = sizeof(Elf64_Rela);
+
+    auto& rodata = headers[SectionRodata];
+    rodata.sh_name = add_string(shstrtab, ".rodata");
+    rodata.sh_type = SHT_PROGBITS;
+    rodata.sh_flags = SHF_ALLOC;
+    rodata.sh_size = m_rodata.size();
+    rodata.sh_addralign = 16;
+
+    auto& data = headers[SectionData];
+    data.sh_name = add_string(shstrtab, ".data");
+    data.sh_type = SHT_PROGBITS;
+    data.sh_flags = SHF_ALLOC | SHF_WRITE;
+    data.sh_size = m_data.size();
+    data.sh_addralign = 16;
+
+    // An empty note marks the object as not needing an executable stack.
+    auto& note = headers[SectionNote];
+    note.sh_name = add_string(shstrtab, ".note.GNU-stack");
+    note.sh_type = SHT_PROGBITS;
+    note.sh_addralign = 1;
+
+    auto& symtab_header = headers[SectionSymtab];
+    symtab_header.sh_name = add_string(shstrtab, ".symtab");
+    symtab_header.sh_type = SHT_SYMTAB;
+    symtab_header.sh_size = symtab.size() * sizeof(Elf64_Sym);
+    symtab_header.sh_link = SectionStrtab;
+    symtab_header.sh_info = first_global;
+    symtab_header.sh_addralign = 8;
+    symtab_header.sh_entsize = sizeof(Elf64_Sym);
+
+    auto& strtab_header = headers[SectionStrtab];
+    strtab_header.sh_name = add_string(shstrtab, ".strtab");
+    strtab_header.sh_type = SHT_STRTAB;
+    strtab_header.sh_size = strtab.size();
+    strtab_header.sh_addralign = 1;
+
+    auto& shstrtab_header = headers[SectionShstrtab];
+    shstrtab_header.sh_name = add_string(shstrtab, ".shstrtab");
+    shstrtab_header.sh_type = SHT_STRTAB;
+    shstrtab_header.sh_size = shstrtab.size();
+    shstrtab_header.sh_addralign = 1;
+
+    // Lay out each section after the file header, in section order.
+    uint64_t offset = sizeof(Elf64_Ehdr);
+    for (uint32_t i = 1; i < NumSections; ++i) {
+        Elf64_Shdr& header = headers[i];
+        offset = (offset + header.sh_addralign - 1) & ~(header.sh_addralign - 1);
+        header.sh_offset = offset;
+        offset += header.sh_size;
+    }
+
+    const uint64_t shoff = (offset + 7) & ~uint64_t(7);
+
+    Elf64_Ehdr ehdr = {};
+    std::memcpy(ehdr.e_ident, ELFMAG, SELFMAG);
+    ehdr.e_ident[EI_CLASS] = ELFCLASS64;
+    ehdr.e_ident[EI_DATA] = ELFDATA2LSB;
+    ehdr.e_ident[EI_VERSION] = EV_CURRENT;
+    ehdr.e_ident[EI_OSABI] = ELFOSABI_SYSV;
+    ehdr.e_type = ET_REL;
+    ehdr.e_machine = EM_X86_64;
+    ehdr.e_version = EV_CURRENT;
+    ehdr.e_shoff = shoff;
+    ehdr.e_ehsize = sizeof(Elf64_Ehdr);
+    ehdr.e_shentsize = sizeof(Elf64_Shdr);
+    ehdr.e_shnum = NumSections;
+    ehdr.e_shstrndx = SectionShstrtab;
+
+    const void* contents[NumSections] = {
+        nullptr,
+        m_text.data(),
+        relas.data(),
+        m_rodata.data(),
+        m_data.data(),
+        nullptr,
+        symtab.data(),
+        strtab.data(),
+        shstrtab.data(),
+    };
+
+    offset = 0;
+    write(os, offset, &ehdr, sizeof(ehdr));
+
+    for (uint32_t i = 1; i < NumSections; ++i) {
+        pad(os, offset, headers[i].sh_addralign);
+        if (headers[i].sh_size != 0)
+            write(os, offset, contents[i], headers[i].sh_size);
+    }
+
+    pad(os, offset, 8);
+    write(os, offset, headers, sizeof(headers));
+}
@@ -178,6 +178,9 @@ public:
 
 void RegisterAnalysis::run() {
     for (const auto& [name, function] : m_seg.get_functions()) {
+        if (m_instr)
+            m_instr->before("regalloc", name);
+
         std::vector<LiveRange> ranges;
         
         LinearScan linscan { *function, ranges };
@@ -210,5 +213,8 @@ void RegisterAnalysis::run() {
 
         CallsiteAnalysis CAN { *function, ranges };
         CAN.run();
+
+        if (m_instr)
+            m_instr->after("regalloc", name);
     }
 }
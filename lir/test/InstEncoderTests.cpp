@@ -0,0 +1,308 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lir/machine/InstEncoder.hpp"
+#include "lir/machine/MachFunction.hpp"
+#include "lir/machine/MachInst.hpp"
+#include "lir/machine/MachLabel.hpp"
+#include "lir/machine/MachOperand.hpp"
+#include "lir/machine/Machine.hpp"
+#include "lir/machine/Register.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace lir::test {
+
+using Bytes = std::vector<uint8_t>;
+
+class InstEncoderTests : public ::testing::Test {
+protected:
+    /// The prologue that every function starts with, for an empty frame:
+    /// push %rbp; mov %rsp, %rbp; sub $16, %rsp
+    static constexpr uint32_t PrologueSize = 8;
+
+    const Machine mach = Machine(Machine::Linux);
+    MachFunction func = MachFunction(nullptr, mach);
+
+    Bytes code = {};
+    std::vector<Relocation> relocs = {};
+
+    /// Append a new label to the function and return it.
+    MachLabel* label() {
+        MachLabel* label = new MachLabel(nullptr);
+        func.append(label);
+        return label;
+    }
+
+    /// Append |inst| to |label|.
+    static void add(MachLabel* label, MachInst inst) {
+        label->append(inst);
+    }
+
+    static MachOperand reg(X64_Register reg, uint16_t subreg = 8) {
+        return MachOperand::create_reg(reg, subreg, false);
+    }
+
+    static MachOperand mem(X64_Register base, int32_t disp) {
+        return MachOperand::create_mem(base, disp);
+    }
+
+    static MachOperand imm(int64_t value) {
+        return MachOperand::create_imm(value);
+    }
+
+    /// Encode the function and return its code after the prologue.
+    Bytes encode() {
+        InstEncoder encoder(func, code, relocs);
+        encoder.run();
+
+        EXPECT_GE(code.size(), PrologueSize);
+        return Bytes(code.begin() + PrologueSize, code.end());
+    }
+
+    /// Encode |inst| alone and return its bytes.
+    Bytes encode(const MachInst& inst) {
+        add(label(), inst);
+        return encode();
+    }
+};
+
+TEST_F(InstEncoderTests, Prologue) {
+    EXPECT_EQ(encode(), Bytes());
+    EXPECT_EQ(code, Bytes({ 0x55, 0x48, 0x89, 0xE5, 0x48, 0x83, 0xEC, 0x10 }));
+}
+
+TEST_F(InstEncoderTests, Epilogue) {
+    EXPECT_EQ(encode(MachInst(X64_Mnemonic::RET)),
+        Bytes({ 0x48, 0x83, 0xC4, 0x10, 0x5D, 0xC3 }));
+}
+
+TEST_F(InstEncoderTests, Rex_Extended_Registers) {
+    MachLabel* entry = label();
+
+    // mov %r8, %rax
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { reg(R8), reg(RAX) }));
+
+    // mov %rax, %r9
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { reg(RAX), reg(R9) }));
+
+    // mov %r10d, %eax
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Long,
+        { reg(R10, 4), reg(RAX, 4) }));
+
+    // mov %ecx, %edx
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Long,
+        { reg(RCX, 4), reg(RDX, 4) }));
+
+    EXPECT_EQ(encode(), Bytes({
+        0x4C, 0x89, 0xC0,
+        0x49, 0x89, 0xC1,
+        0x44, 0x89, 0xD0,
+        0x89, 0xCA,
+    }));
+}
+
+TEST_F(InstEncoderTests, Rex_Byte_Registers) {
+    MachLabel* entry = label();
+
+    // mov %al, %sil
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Byte,
+        { reg(RAX, 1), reg(RSI, 1) }));
+
+    // mov %al, %cl
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Byte,
+        { reg(RAX, 1), reg(RCX, 1) }));
+
+    // sete %dil
+    add(entry, MachInst(X64_Mnemonic::SETE, X64_Size::Byte,
+        { reg(RDI, 1) }));
+
+    EXPECT_EQ(encode(), Bytes({
+        0x40, 0x88, 0xC6,
+        0x88, 0xC1,
+        0x40, 0x0F, 0x94, 0xC7,
+    }));
+}
+
+TEST_F(InstEncoderTests, ModRM_Bases) {
+    MachLabel* entry = label();
+
+    // mov (%rax), %rcx
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { mem(RAX, 0), reg(RCX) }));
+
+    // %rsp and %r12 need a SIB byte.
+    // mov 8(%rsp), %rax
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { mem(RSP, 8), reg(RAX) }));
+
+    // mov -8(%r12), %rcx
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { mem(R12, -8), reg(RCX) }));
+
+    // %rbp and %r13 need a displacement, even if it is zero.
+    // mov (%rbp), %rax
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { mem(RBP, 0), reg(RAX) }));
+
+    // mov (%r13), %rdx
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { mem(R13, 0), reg(RDX) }));
+
+    EXPECT_EQ(encode(), Bytes({
+        0x48, 0x8B, 0x08,
+        0x48, 0x8B, 0x44, 0x24, 0x08,
+        0x49, 0x8B, 0x4C, 0x24, 0xF8,
+        0x48, 0x8B, 0x45, 0x00,
+        0x49, 0x8B, 0x55, 0x00,
+    }));
+}
+
+TEST_F(InstEncoderTests, Displacement_Sizes) {
+    MachLabel* entry = label();
+
+    // mov 127(%rbx), %rax
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { mem(RBX, 127), reg(RAX) }));
+
+    // mov -128(%rbx), %rax
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { mem(RBX, -128), reg(RAX) }));
+
+    // mov 128(%rbx), %rax
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { mem(RBX, 128), reg(RAX) }));
+
+    // mov -129(%rsp), %rax
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { mem(RSP, -129), reg(RAX) }));
+
+    EXPECT_EQ(encode(), Bytes({
+        0x48, 0x8B, 0x43, 0x7F,
+        0x48, 0x8B, 0x43, 0x80,
+        0x48, 0x8B, 0x83, 0x80, 0x00, 0x00, 0x00,
+        0x48, 0x8B, 0x84, 0x24, 0x7F, 0xFF, 0xFF, 0xFF,
+    }));
+}
+
+TEST_F(InstEncoderTests, Immediate_Sizes) {
+    MachLabel* entry = label();
+
+    // add $1, %rax
+    add(entry, MachInst(X64_Mnemonic::ADD, X64_Size::Quad,
+        { imm(1), reg(RAX) }));
+
+    // add $-128, %rax
+    add(entry, MachInst(X64_Mnemonic::ADD, X64_Size::Quad,
+        { imm(-128), reg(RAX) }));
+
+    // add $128, %rax
+    add(entry, MachInst(X64_Mnemonic::ADD, X64_Size::Quad,
+        { imm(128), reg(RAX) }));
+
+    // cmp $4096, %r9d
+    add(entry, MachInst(X64_Mnemonic::CMP, X64_Size::Long,
+        { imm(4096), reg(R9, 4) }));
+
+    EXPECT_EQ(encode(), Bytes({
+        0x48, 0x83, 0xC0, 0x01,
+        0x48, 0x83, 0xC0, 0x80,
+        0x48, 0x81, 0xC0, 0x80, 0x00, 0x00, 0x00,
+        0x41, 0x81, 0xF9, 0x00, 0x10, 0x00, 0x00,
+    }));
+}
+
+TEST_F(InstEncoderTests, Branches) {
+    MachLabel* first = label();
+    MachLabel* second = label();
+    MachLabel* third = label();
+    MachLabel* fourth = label();
+
+    // jmp to the next label, over nothing.
+    add(first, MachInst(X64_Mnemonic::JMP, X64_Size::None,
+        { MachOperand::create_label(second) }));
+
+    // jne back to the first label, relative to the end of the jne.
+    add(second, MachInst(X64_Mnemonic::NOP));
+    add(second, MachInst(X64_Mnemonic::JNE, X64_Size::None,
+        { MachOperand::create_label(first) }));
+
+    // jl forward over a nop.
+    add(third, MachInst(X64_Mnemonic::JL, X64_Size::None,
+        { MachOperand::create_label(fourth) }));
+    add(third, MachInst(X64_Mnemonic::NOP));
+
+    add(fourth, MachInst(X64_Mnemonic::NOP));
+
+    EXPECT_EQ(encode(), Bytes({
+        0xE9, 0x00, 0x00, 0x00, 0x00,
+        0x90,
+        0x0F, 0x85, 0xF4, 0xFF, 0xFF, 0xFF,
+        0x0F, 0x8C, 0x01, 0x00, 0x00, 0x00,
+        0x90,
+        0x90,
+    }));
+
+    EXPECT_TRUE(relocs.empty());
+}
+
+TEST_F(InstEncoderTests, Relocations) {
+    MachLabel* entry = label();
+
+    // call foo
+    add(entry, MachInst(X64_Mnemonic::CALL, X64_Size::None,
+        { MachOperand::create_symbol("foo") }));
+
+    // mov .LC0(%rip), %rax
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { MachOperand::create_constant_ref(0), reg(RAX) }));
+
+    // cmp $1, .LC1(%rip), where the immediate follows the field.
+    add(entry, MachInst(X64_Mnemonic::CMP, X64_Size::Quad,
+        { imm(1), MachOperand::create_constant_ref(1) }));
+
+    // mov bar, %rcx
+    add(entry, MachInst(X64_Mnemonic::MOV, X64_Size::Quad,
+        { MachOperand::create_symbol("bar"), reg(RCX) }));
+
+    EXPECT_EQ(encode(), Bytes({
+        0xE8, 0x00, 0x00, 0x00, 0x00,
+        0x48, 0x8B, 0x05, 0x00, 0x00, 0x00, 0x00,
+        0x48, 0x83, 0x3D, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x48, 0x8B, 0x0C, 0x25, 0x00, 0x00, 0x00, 0x00,
+    }));
+
+    ASSERT_EQ(relocs.size(), 4);
+
+    EXPECT_EQ(relocs[0].kind, Relocation::PLT32);
+    EXPECT_EQ(relocs[0].offset, PrologueSize + 1);
+    EXPECT_EQ(relocs[0].addend, -4);
+    EXPECT_EQ(relocs[0].symbol, "foo");
+
+    EXPECT_EQ(relocs[1].kind, Relocation::PC32);
+    EXPECT_EQ(relocs[1].offset, PrologueSize + 8);
+    EXPECT_EQ(relocs[1].addend, -4);
+    EXPECT_EQ(relocs[1].symbol, "");
+    EXPECT_EQ(relocs[1].constant, 0);
+
+    // PC-relative fields are relative to the end of the instruction, not the
+    // end of the field.
+    EXPECT_EQ(relocs[2].kind, Relocation::PC32);
+    EXPECT_EQ(relocs[2].offset, PrologueSize + 15);
+    EXPECT_EQ(relocs[2].addend, -5);
+    EXPECT_EQ(relocs[2].constant, 1);
+
+    EXPECT_EQ(relocs[3].kind, Relocation::Abs32S);
+    EXPECT_EQ(relocs[3].offset, PrologueSize + 24);
+    EXPECT_EQ(relocs[3].addend, 0);
+    EXPECT_EQ(relocs[3].symbol, "bar");
+}
+
+} // namespace lir::test
@@ -0,0 +1,346 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lir/machine/Linker.hpp"
+
+#include "gtest/gtest.h"
+
+#include <elf.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lir::test {
+
+/// Builds small relocatable objects by hand, with a .text and a .data section
+/// and relocations against the text.
+class ObjectBuilder final {
+    struct Symbol final {
+        std::string name;
+        uint16_t section;
+        uint64_t value;
+        uint8_t bind;
+    };
+
+    struct Reloc final {
+        uint64_t offset;
+        uint32_t symbol;
+        uint32_t type;
+        int64_t addend;
+    };
+
+    std::vector<Symbol> m_symbols = {};
+    std::vector<Reloc> m_relocs = {};
+
+    /// Append the bytes of |value| to |out|.
+    template<typename T>
+    static void put(std::string& out, const T& value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    static void pad(std::string& out, uint64_t align) {
+        while (out.size() % align)
+            out.push_back('\0');
+    }
+
+public:
+    /// The section indices of the built object.
+    static constexpr uint16_t Text = 1;
+    static constexpr uint16_t Data = 2;
+
+    std::string text = {};
+    std::string data = {};
+
+    /// Add a symbol and return its index in the symbol table. Symbols in
+    /// |section| zero are undefined.
+    uint32_t symbol(const std::string& name, uint16_t section = SHN_UNDEF,
+                    uint64_t value = 0, uint8_t bind = STB_GLOBAL) {
+        m_symbols.push_back({ name, section, value, bind });
+        return m_symbols.size();
+    }
+
+    /// Add a relocation of |type| at |offset| in the text against |symbol|.
+    void reloc(uint64_t offset, uint32_t symbol, uint32_t type,
+               int64_t addend) {
+        m_relocs.push_back({ offset, symbol, type, addend });
+    }
+
+    std::string build() const {
+        std::string strtab("\0", 1);
+        std::string symtab = {};
+        put(symtab, Elf64_Sym {});
+        for (const Symbol& sym : m_symbols) {
+            Elf64_Sym entry = {};
+            entry.st_name = strtab.size();
+            entry.st_info = ELF64_ST_INFO(sym.bind, STT_NOTYPE);
+            entry.st_shndx = sym.section;
+            entry.st_value = sym.value;
+            put(symtab, entry);
+            strtab += sym.name + '\0';
+        }
+
+        std::string rela = {};
+        for (const Reloc& reloc : m_relocs) {
+            Elf64_Rela entry = {};
+            entry.r_offset = reloc.offset;
+            entry.r_info = ELF64_R_INFO(reloc.symbol, reloc.type);
+            entry.r_addend = reloc.addend;
+            put(rela, entry);
+        }
+
+        static constexpr char Names[] = 
+            "\0.text\0.data\0.symtab\0.strtab\0.rela.text\0.shstrtab";
+        const std::string shstrtab(Names, sizeof(Names));
+
+        std::string out(sizeof(Elf64_Ehdr), '\0');
+        std::vector<Elf64_Shdr> shdrs(7);
+
+        auto section = [&](uint16_t i, uint32_t name, uint32_t type,
+                           uint64_t flags, const std::string& contents,
+                           uint64_t align) {
+            pad(out, align);
+            shdrs[i].sh_name = name;
+            shdrs[i].sh_type = type;
+            shdrs[i].sh_flags = flags;
+            shdrs[i].sh_offset = out.size();
+            shdrs[i].sh_size = contents.size();
+            shdrs[i].sh_addralign = align;
+            out += contents;
+        };
+
+        section(1, 1, SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, text, 16);
+        section(2, 7, SHT_PROGBITS, SHF_ALLOC | SHF_WRITE, data, 8);
+        section(3, 13, SHT_SYMTAB, 0, symtab, 8);
+        section(4, 21, SHT_STRTAB, 0, strtab, 1);
+        section(5, 29, SHT_RELA, SHF_INFO_LINK, rela, 8);
+        section(6, 40, SHT_STRTAB, 0, shstrtab, 1);
+
+        shdrs[3].sh_link = 4;
+        shdrs[3].sh_entsize = sizeof(Elf64_Sym);
+        shdrs[3].sh_info = 1;
+        shdrs[5].sh_link = 3;
+        shdrs[5].sh_info = Text;
+        shdrs[5].sh_entsize = sizeof(Elf64_Rela);
+
+        pad(out, 8);
+        Elf64_Ehdr ehdr = {};
+        std::memcpy(ehdr.e_ident, ELFMAG, SELFMAG);
+        ehdr.e_ident[EI_CLASS] = ELFCLASS64;
+        ehdr.e_ident[EI_DATA] = ELFDATA2LSB;
+        ehdr.e_ident[EI_VERSION] = EV_CURRENT;
+        ehdr.e_type = ET_REL;
+        ehdr.e_machine = EM_X86_64;
+        ehdr.e_version = EV_CURRENT;
+        ehdr.e_shoff = out.size();
+        ehdr.e_ehsize = sizeof(Elf64_Ehdr);
+        ehdr.e_shentsize = sizeof(Elf64_Shdr);
+        ehdr.e_shnum = shdrs.size();
+        ehdr.e_shstrndx = 6;
+
+        for (const Elf64_Shdr& shdr : shdrs)
+            put(out, shdr);
+
+        std::memcpy(out.data(), &ehdr, sizeof(ehdr));
+        return out;
+    }
+};
+
+class LinkerTests : public ::testing::Test {
+protected:
+    Linker linker;
+    std::string exe;
+
+    /// Link the objects added so far into |exe|.
+    bool link() {
+        std::ostringstream out;
+        const bool linked = linker.run(out);
+        exe = out.str();
+        return linked;
+    }
+
+    /// Returns the ELF header of the linked executable.
+    Elf64_Ehdr header() const {
+        Elf64_Ehdr ehdr = {};
+        std::memcpy(&ehdr, exe.data(), sizeof(ehdr));
+        return ehdr;
+    }
+
+    /// Returns the loadable segment of the executable with |flags|.
+    Elf64_Phdr segment(uint32_t flags) const {
+        const Elf64_Ehdr ehdr = header();
+        for (uint16_t i = 0; i < ehdr.e_phnum; ++i) {
+            Elf64_Phdr phdr = {};
+            std::memcpy(&phdr, exe.data() + ehdr.e_phoff + i * sizeof(phdr),
+                sizeof(phdr));
+
+            if (phdr.p_type == PT_LOAD && phdr.p_flags == flags)
+                return phdr;
+        }
+
+        return {};
+    }
+
+    /// Read the value of |T| at the virtual |address| of the executable.
+    template<typename T>
+    T read(uint64_t address) const {
+        for (uint32_t flags : { PF_R, PF_R | PF_X, PF_R | PF_W }) {
+            const Elf64_Phdr phdr = segment(flags);
+            if (address < phdr.p_vaddr ||
+                    address + sizeof(T) > phdr.p_vaddr + phdr.p_filesz)
+                continue;
+
+            T value = {};
+            std::memcpy(&value,
+                exe.data() + phdr.p_offset + (address - phdr.p_vaddr),
+                sizeof(value));
+            return value;
+        }
+
+        ADD_FAILURE() << "address not in the executable: " << address;
+        return {};
+    }
+
+    /// Test if any error of the linker contains |text|.
+    bool has_error(const std::string& text) const {
+        for (const std::string& error : linker.get_errors())
+            if (error.find(text) != std::string::npos)
+                return true;
+
+        return false;
+    }
+};
+
+TEST_F(LinkerTests, Relocation_Patching) {
+    // _start: call foo; movabs rax, value; ret
+    ObjectBuilder a;
+    a.text = std::string("\xe8\0\0\0\0\x48\xb8\0\0\0\0\0\0\0\0\xc3", 16);
+    a.symbol("_start", ObjectBuilder::Text);
+    const uint32_t foo = a.symbol("foo");
+    const uint32_t value = a.symbol("value");
+    a.reloc(1, foo, R_X86_64_PLT32, -4);
+    a.reloc(7, value, R_X86_64_64, 0);
+
+    // foo: ret, and value is the data of the object.
+    ObjectBuilder b;
+    b.text = "\xc3";
+    b.data = std::string(8, '\x2a');
+    b.symbol("foo", ObjectBuilder::Text);
+    b.symbol("value", ObjectBuilder::Data);
+
+    linker.add_object("a.o", a.build());
+    linker.add_object("b.o", b.build());
+    ASSERT_TRUE(link()) << linker.get_errors().front();
+
+    const Elf64_Ehdr ehdr = header();
+    EXPECT_EQ(ehdr.e_type, ET_EXEC);
+    EXPECT_EQ(ehdr.e_entry, segment(PF_R | PF_X).p_vaddr);
+
+    // The text of b is laid out right after that of a, at its alignment.
+    const uint64_t start = ehdr.e_entry;
+    const int32_t disp = read<int32_t>(start + 1);
+    EXPECT_EQ(start + 5 + disp, start + 16);
+    EXPECT_EQ(read<uint8_t>(start + 16), 0xc3);
+
+    const uint64_t data = segment(PF_R | PF_W).p_vaddr;
+    EXPECT_EQ(read<uint64_t>(start + 7), data);
+    EXPECT_EQ(read<uint8_t>(data), 0x2a);
+}
+
+TEST_F(LinkerTests, Undefined_Symbol) {
+    ObjectBuilder a;
+    a.text = std::string("\xe8\0\0\0\0", 5);
+    a.symbol("_start", ObjectBuilder::Text);
+    a.reloc(1, a.symbol("foo"), R_X86_64_PC32, -4);
+
+    linker.add_object("a.o", a.build());
+    EXPECT_FALSE(link());
+    EXPECT_TRUE(has_error("undefined symbol: foo"));
+    EXPECT_TRUE(exe.empty());
+}
+
+TEST_F(LinkerTests, Undefined_Weak_Symbol) {
+    ObjectBuilder a;
+    a.text = std::string("\x48\xb8\xff\xff\xff\xff\xff\xff\xff\xff", 10);
+    a.symbol("_start", ObjectBuilder::Text);
+    a.reloc(2, a.symbol("foo", SHN_UNDEF, 0, STB_WEAK), R_X86_64_64, 0);
+
+    linker.add_object("a.o", a.build());
+    ASSERT_TRUE(link());
+    EXPECT_EQ(read<uint64_t>(header().e_entry + 2), 0);
+}
+
+TEST_F(LinkerTests, Duplicate_Symbol) {
+    ObjectBuilder a;
+    a.text = "\xc3";
+    a.symbol("_start", ObjectBuilder::Text);
+    a.symbol("foo", ObjectBuilder::Text);
+
+    ObjectBuilder b;
+    b.text = "\xc3";
+    b.symbol("foo", ObjectBuilder::Text);
+
+    linker.add_object("a.o", a.build());
+    linker.add_object("b.o", b.build());
+    EXPECT_FALSE(link());
+    EXPECT_TRUE(has_error("duplicate symbol: foo in a.o and b.o"));
+}
+
+TEST_F(LinkerTests, Weak_Symbol_Overridden) {
+    // _start: call foo
+    ObjectBuilder a;
+    a.text = std::string("\xe8\0\0\0\0", 5);
+    a.symbol("_start", ObjectBuilder::Text);
+    const uint32_t foo = a.symbol("foo");
+    a.reloc(1, foo, R_X86_64_PC32, -4);
+
+    // A weak foo first, and then a strong foo at the end of the text.
+    ObjectBuilder b;
+    b.text = "\xc3";
+    b.symbol("foo", ObjectBuilder::Text, 0, STB_WEAK);
+
+    ObjectBuilder c;
+    c.text = "\xc3";
+    c.symbol("foo", ObjectBuilder::Text);
+
+    linker.add_object("a.o", a.build());
+    linker.add_object("b.o", b.build());
+    linker.add_object("c.o", c.build());
+    ASSERT_TRUE(link());
+
+    const uint64_t start = header().e_entry;
+    EXPECT_EQ(start + 5 + read<int32_t>(start + 1), start + 32);
+}
+
+TEST_F(LinkerTests, Entry_Point) {
+    // The entry is wherever _start is, even if it is not first.
+    ObjectBuilder a;
+    a.text = "\x90\x90\x90\xc3";
+    a.symbol("_start", ObjectBuilder::Text, 3);
+
+    linker.add_object("a.o", a.build());
+    ASSERT_TRUE(link());
+    EXPECT_EQ(header().e_entry, segment(PF_R | PF_X).p_vaddr + 3);
+    EXPECT_EQ(read<uint8_t>(header().e_entry), 0xc3);
+}
+
+TEST_F(LinkerTests, Missing_Entry_Point) {
+    ObjectBuilder a;
+    a.text = "\xc3";
+    a.symbol("main", ObjectBuilder::Text);
+
+    linker.add_object("a.o", a.build());
+    EXPECT_FALSE(link());
+    EXPECT_TRUE(has_error("undefined entry symbol: _start"));
+}
+
+TEST_F(LinkerTests, Not_An_Object) {
+    linker.add_object("a.o", "not an object");
+    EXPECT_FALSE(link());
+    EXPECT_TRUE(has_error("not an ELF object: a.o"));
+}
+
+} // namespace lir::test
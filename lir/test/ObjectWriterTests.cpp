@@ -0,0 +1,213 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lir/graph/CFG.hpp"
+#include "lir/graph/Constant.hpp"
+#include "lir/graph/Function.hpp"
+#include "lir/graph/Global.hpp"
+#include "lir/graph/Type.hpp"
+#include "lir/machine/MachFunction.hpp"
+#include "lir/machine/MachInst.hpp"
+#include "lir/machine/MachLabel.hpp"
+#include "lir/machine/MachOperand.hpp"
+#include "lir/machine/Machine.hpp"
+#include "lir/machine/ObjectWriter.hpp"
+#include "lir/machine/Segment.hpp"
+
+#include "gtest/gtest.h"
+
+#include <elf.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lir::test {
+
+class ObjectWriterTests : public ::testing::Test {
+protected:
+    const Machine mach = Machine(Machine::Linux);
+    CFG cfg = CFG(mach, "test.lace");
+
+    /// The object written by the last call to write.
+    std::string obj = {};
+
+    /// Write |seg| out to |obj|.
+    void write(const Segment& seg) {
+        std::ostringstream out;
+        ObjectWriter writer(seg);
+        writer.run(out);
+        obj = out.str();
+    }
+
+    const Elf64_Ehdr& header() const {
+        return *reinterpret_cast<const Elf64_Ehdr*>(obj.data());
+    }
+
+    const Elf64_Shdr& section(uint32_t i) const {
+        return reinterpret_cast<const Elf64_Shdr*>(
+            obj.data() + header().e_shoff)[i];
+    }
+
+    /// Returns the contents of the |i|-th section.
+    std::string contents(uint32_t i) const {
+        return obj.substr(section(i).sh_offset, section(i).sh_size);
+    }
+
+    /// Returns the name of the |i|-th section.
+    std::string section_name(uint32_t i) const {
+        return obj.data() + section(header().e_shstrndx).sh_offset +
+            section(i).sh_name;
+    }
+
+    /// Returns the index of the section named |name|, or zero if there is no
+    /// such section.
+    uint32_t find_section(const std::string& name) const {
+        for (uint32_t i = 1; i < header().e_shnum; ++i)
+            if (section_name(i) == name)
+                return i;
+
+        return 0;
+    }
+
+    /// Returns the entries of the section named |name|.
+    template<typename T>
+    std::vector<T> entries(const std::string& name) const {
+        const std::string data = contents(find_section(name));
+        std::vector<T> entries(data.size() / sizeof(T));
+        std::memcpy(entries.data(), data.data(), entries.size() * sizeof(T));
+        return entries;
+    }
+
+    /// Returns the name of the symbol |sym|.
+    std::string symbol_name(const Elf64_Sym& sym) const {
+        return obj.data() + section(find_section(".strtab")).sh_offset +
+            sym.st_name;
+    }
+};
+
+TEST_F(ObjectWriterTests, Tables) {
+    Type* i32 = Type::get_i32_type(cfg);
+    Type* i64 = Type::get_i64_type(cfg);
+
+    Global::create(cfg, i32, Global::Internal, true, "limit",
+        Integer::get(cfg, i32, 5));
+    Global::create(cfg, i64, Global::External, false, "counter",
+        Integer::get(cfg, i64, 7));
+
+    Function* main = Function::create(cfg, Function::External,
+        FunctionType::get(cfg, {}, Type::get_void_type(cfg)), "main", {});
+
+    Segment seg(cfg);
+    MachFunction* func = new MachFunction(main, mach);
+    seg.get_functions().emplace("main", func);
+
+    MachLabel* entry = new MachLabel(nullptr);
+    func->append(entry);
+
+    const uint32_t constant = func->get_constant_pool().get_or_create_constant(
+        Integer::get(cfg, i64, 42), 8);
+
+    MachInst call(X64_Mnemonic::CALL, X64_Size::None,
+        { MachOperand::create_symbol("puts") });
+    MachInst load(X64_Mnemonic::MOV, X64_Size::Quad, {
+        MachOperand::create_constant_ref(constant),
+        MachOperand::create_reg(RAX, 8, true) });
+    MachInst ret(X64_Mnemonic::RET);
+
+    entry->append(call);
+    entry->append(load);
+    entry->append(ret);
+
+    write(seg);
+
+    ASSERT_GE(obj.size(), sizeof(Elf64_Ehdr));
+    ASSERT_EQ(std::memcmp(header().e_ident, ELFMAG, SELFMAG), 0);
+    EXPECT_EQ(header().e_type, ET_REL);
+    EXPECT_EQ(header().e_machine, EM_X86_64);
+
+    // Sections.
+    ASSERT_EQ(header().e_shnum, 9);
+    const char* names[] = { ".text", ".rela.text", ".rodata", ".data",
+        ".note.GNU-stack", ".symtab", ".strtab", ".shstrtab" };
+
+    for (uint32_t i = 0; i < std::size(names); ++i)
+        EXPECT_EQ(section_name(i + 1), names[i]);
+
+    const uint32_t text = find_section(".text");
+    const uint32_t rodata = find_section(".rodata");
+    const uint32_t data = find_section(".data");
+    const uint32_t symtab = find_section(".symtab");
+
+    EXPECT_EQ(section(text).sh_flags, SHF_ALLOC | SHF_EXECINSTR);
+    EXPECT_EQ(section(data).sh_flags, SHF_ALLOC | SHF_WRITE);
+    EXPECT_EQ(section(symtab).sh_link, find_section(".strtab"));
+    EXPECT_EQ(section(find_section(".rela.text")).sh_info, text);
+
+    // The read-only global, and then the constant aligned after it.
+    EXPECT_EQ(contents(rodata), std::string("\x05\0\0\0\0\0\0\0\x2A\0\0\0\0\0\0\0",
+        16));
+    EXPECT_EQ(contents(data), std::string("\x07\0\0\0\0\0\0\0", 8));
+
+    // Prologue, call, load and epilogue.
+    EXPECT_EQ(section(text).sh_size, 8 + 5 + 7 + 6);
+
+    // Symbols: the null symbol, the file and section symbols, then locals,
+    // then globals with undefined symbols last.
+    const auto syms = entries<Elf64_Sym>(".symtab");
+    ASSERT_EQ(syms.size(), 9);
+    EXPECT_EQ(section(symtab).sh_info, 6);
+
+    EXPECT_EQ(ELF64_ST_TYPE(syms[1].st_info), STT_FILE);
+    EXPECT_EQ(symbol_name(syms[1]), "test.lace");
+
+    EXPECT_EQ(syms[2].st_shndx, text);
+    EXPECT_EQ(syms[3].st_shndx, rodata);
+    EXPECT_EQ(syms[4].st_shndx, data);
+    for (uint32_t i = 2; i <= 4; ++i)
+        EXPECT_EQ(ELF64_ST_TYPE(syms[i].st_info), STT_SECTION);
+
+    EXPECT_EQ(symbol_name(syms[5]), "limit");
+    EXPECT_EQ(ELF64_ST_BIND(syms[5].st_info), STB_LOCAL);
+    EXPECT_EQ(ELF64_ST_TYPE(syms[5].st_info), STT_OBJECT);
+    EXPECT_EQ(syms[5].st_shndx, rodata);
+    EXPECT_EQ(syms[5].st_value, 0);
+    EXPECT_EQ(syms[5].st_size, 4);
+
+    EXPECT_EQ(symbol_name(syms[6]), "counter");
+    EXPECT_EQ(ELF64_ST_BIND(syms[6].st_info), STB_GLOBAL);
+    EXPECT_EQ(ELF64_ST_TYPE(syms[6].st_info), STT_OBJECT);
+    EXPECT_EQ(syms[6].st_shndx, data);
+    EXPECT_EQ(syms[6].st_size, 8);
+
+    EXPECT_EQ(symbol_name(syms[7]), "main");
+    EXPECT_EQ(ELF64_ST_BIND(syms[7].st_info), STB_GLOBAL);
+    EXPECT_EQ(ELF64_ST_TYPE(syms[7].st_info), STT_FUNC);
+    EXPECT_EQ(syms[7].st_shndx, text);
+    EXPECT_EQ(syms[7].st_value, 0);
+    EXPECT_EQ(syms[7].st_size, section(text).sh_size);
+
+    EXPECT_EQ(symbol_name(syms[8]), "puts");
+    EXPECT_EQ(ELF64_ST_BIND(syms[8].st_info), STB_GLOBAL);
+    EXPECT_EQ(syms[8].st_shndx, SHN_UNDEF);
+
+    // Relocations: the call goes through the PLT to the undefined symbol,
+    // while the constant is relative to the read-only data section symbol.
+    const auto relas = entries<Elf64_Rela>(".rela.text");
+    ASSERT_EQ(relas.size(), 2);
+
+    EXPECT_EQ(relas[0].r_offset, 9);
+    EXPECT_EQ(ELF64_R_SYM(relas[0].r_info), 8);
+    EXPECT_EQ(ELF64_R_TYPE(relas[0].r_info), R_X86_64_PLT32);
+    EXPECT_EQ(relas[0].r_addend, -4);
+
+    EXPECT_EQ(relas[1].r_offset, 16);
+    EXPECT_EQ(ELF64_R_SYM(relas[1].r_info), 3);
+    EXPECT_EQ(ELF64_R_TYPE(relas[1].r_info), R_X86_64_PC32);
+    EXPECT_EQ(relas[1].r_addend, 8 - 4);
+}
+
+} // namespace lir::test
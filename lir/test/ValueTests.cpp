@@ -0,0 +1,196 @@
+//
+//  Copyright (c) 2026 Nick Marino
+//  All rights reserved.
+//
+
+#include "lir/graph/CFG.hpp"
+#include "lir/graph/Type.hpp"
+#include "lir/graph/Use.hpp"
+#include "lir/graph/User.hpp"
+#include "lir/graph/Value.hpp"
+#include "lir/machine/Machine.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+namespace lir::test {
+
+/// A bare user, which is also used as a plain value when it has no operands.
+class Node final : public User {
+public:
+    Node(Type* type, const std::vector<Value*>& ops = {}) : User(type, ops) {}
+
+    void print(std::ostream&, PrintPolicy) const override {}
+};
+
+class ValueTests : public ::testing::Test {
+protected:
+    const Machine mach = Machine(Machine::Linux);
+    CFG cfg = CFG(mach, "test.lace");
+
+    std::unique_ptr<Node> node(const std::vector<Value*>& ops = {}) {
+        return std::make_unique<Node>(Type::get_i64_type(cfg), ops);
+    }
+
+    /// Returns the users of |value| in the order of its uses, after checking
+    /// that its use list is linked up consistently.
+    static std::vector<User*> users(Value* value) {
+        std::vector<User*> users = {};
+        const Use* prev = nullptr;
+
+        for (Use* use : value->uses()) {
+            EXPECT_EQ(use->get_value(), value);
+            EXPECT_EQ(use->get_prev(), prev);
+            users.push_back(use->get_user());
+            prev = use;
+        }
+
+        EXPECT_EQ(value->use_front(), users.empty() ? nullptr :
+            value->uses().begin().operator*());
+        EXPECT_EQ(value->use_back(), prev);
+        EXPECT_EQ(value->num_uses(), users.size());
+        EXPECT_EQ(value->used(), !users.empty());
+        return users;
+    }
+};
+
+TEST_F(ValueTests, Add_Uses) {
+    auto value = node();
+    auto a = node({ value.get() });
+    auto b = node({ value.get() });
+    auto c = node({ value.get() });
+
+    EXPECT_EQ(users(value.get()),
+        std::vector<User*>({ a.get(), b.get(), c.get() }));
+}
+
+TEST_F(ValueTests, Remove_Head) {
+    auto value = node();
+    auto a = node({ value.get() });
+    auto b = node({ value.get() });
+    auto c = node({ value.get() });
+
+    a.reset();
+    EXPECT_EQ(users(value.get()), std::vector<User*>({ b.get(), c.get() }));
+}
+
+TEST_F(ValueTests, Remove_Middle) {
+    auto value = node();
+    auto a = node({ value.get() });
+    auto b = node({ value.get() });
+    auto c = node({ value.get() });
+
+    b.reset();
+    EXPECT_EQ(users(value.get()), std::vector<User*>({ a.get(), c.get() }));
+}
+
+TEST_F(ValueTests, Remove_Tail) {
+    auto value = node();
+    auto a = node({ value.get() });
+    auto b = node({ value.get() });
+    auto c = node({ value.get() });
+
+    c.reset();
+    EXPECT_EQ(users(value.get()), std::vector<User*>({ a.get(), b.get() }));
+
+    // Uses added after a removal still go on the back.
+    auto d = node({ value.get() });
+    EXPECT_EQ(users(value.get()),
+        std::vector<User*>({ a.get(), b.get(), d.get() }));
+}
+
+TEST_F(ValueTests, Counts_After_Removal) {
+    auto value = node();
+    auto a = node({ value.get() });
+    auto b = node({ value.get() });
+
+    EXPECT_EQ(value->num_uses(), 2);
+    EXPECT_FALSE(value->has_one_use());
+
+    a.reset();
+    EXPECT_EQ(value->num_uses(), 1);
+    EXPECT_TRUE(value->has_one_use());
+    EXPECT_EQ(value->use_front(), value->use_back());
+
+    b.reset();
+    EXPECT_EQ(value->num_uses(), 0);
+    EXPECT_FALSE(value->has_one_use());
+    EXPECT_FALSE(value->used());
+    EXPECT_EQ(value->use_front(), nullptr);
+    EXPECT_EQ(value->use_back(), nullptr);
+}
+
+TEST_F(ValueTests, Set_Value) {
+    auto from = node();
+    auto to = node();
+    auto a = node({ from.get() });
+    auto b = node({ from.get() });
+    auto c = node({ to.get() });
+
+    a->get_operand(0)->set_value(to.get());
+
+    EXPECT_EQ(users(from.get()), std::vector<User*>({ b.get() }));
+    EXPECT_EQ(users(to.get()), std::vector<User*>({ c.get(), a.get() }));
+}
+
+TEST_F(ValueTests, Replace_Onto_Used) {
+    auto from = node();
+    auto to = node();
+    auto a = node({ from.get() });
+    auto b = node({ from.get() });
+    auto c = node({ to.get() });
+
+    from->replace_all_uses_with(to.get());
+
+    // The moved uses keep their order, after the existing ones.
+    EXPECT_EQ(users(from.get()), std::vector<User*>());
+    EXPECT_EQ(users(to.get()),
+        std::vector<User*>({ c.get(), a.get(), b.get() }));
+    EXPECT_EQ(a->get_operand(0)->get_value(), to.get());
+}
+
+TEST_F(ValueTests, Replace_Onto_Unused) {
+    auto from = node();
+    auto to = node();
+    auto a = node({ from.get() });
+    auto b = node({ from.get() });
+
+    from->replace_all_uses_with(to.get());
+
+    EXPECT_EQ(users(from.get()), std::vector<User*>());
+    EXPECT_EQ(users(to.get()), std::vector<User*>({ a.get(), b.get() }));
+
+    // Replacing a value without uses changes nothing.
+    from->replace_all_uses_with(to.get());
+    EXPECT_EQ(users(to.get()), std::vector<User*>({ a.get(), b.get() }));
+}
+
+TEST_F(ValueTests, Replace_Onto_Self) {
+    auto value = node();
+    auto a = node({ value.get() });
+    auto b = node({ value.get() });
+
+    value->replace_all_uses_with(value.get());
+    EXPECT_EQ(users(value.get()), std::vector<User*>({ a.get(), b.get() }));
+}
+
+TEST_F(ValueTests, Destroy_User_After_Replace) {
+    // As with a trivial phi: a user of |same| and of itself, which is used
+    // elsewhere, is replaced with |same| and then destroyed.
+    auto same = node();
+    auto phi = node({ same.get() });
+    phi->add_operand(phi.get());
+    auto user = node({ phi.get() });
+
+    phi->replace_all_uses_with(same.get());
+    EXPECT_EQ(users(same.get()),
+        std::vector<User*>({ phi.get(), phi.get(), user.get() }));
+
+    phi.reset();
+    EXPECT_EQ(users(same.get()), std::vector<User*>({ user.get() }));
+    EXPECT_EQ(user->get_operand(0)->get_value(), same.get());
+}
+
+} // namespace lir::test
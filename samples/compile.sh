@@ -6,7 +6,6 @@ cd ../../samples/
 
 for file in *.lace; do
     if [[ -f "$file" ]]; then
-        ./../lace/lace "$file"
-        ld "$file".o ../lace/samples/rt.o -o "${file%.lace}"
+        ./../lace/lace "$file" -rt ../lace/samples/rt.o -o "${file%.lace}"
     fi
 done